@@ -0,0 +1,103 @@
+/**
+ * @brief The following code involves the methods neccessary to run a task over the bands of a
+ * board in parallel. The threads are started once and then wait for new rounds, so that starting
+ * a generation costs a wake-up rather than a thread creation. The calling thread runs band 0
+ * itself.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "bandworkers.h"
+
+/**
+ * @brief BandWorkers::BandWorkers The constructor of the BandWorkers class. Starts a thread for
+ * every band except the first one, which is run by the caller of run.
+ * @param bandCount The number of bands, at least 1.
+ */
+BandWorkers::BandWorkers(int bandCount) {
+    if (bandCount < 1) {
+        throw("There must be at least one band.");
+    }
+    task = nullptr;
+    round = 0;
+    pending = 0;
+    stopping = false;
+    for (int band = 1; band < bandCount; band++) {
+        threads.push_back(thread(&BandWorkers::workerLoop, this, band));
+    }
+}
+
+/**
+ * @brief BandWorkers::~BandWorkers Destructor of the BandWorkers class. Stops the threads and
+ * waits for them to exit.
+ */
+BandWorkers::~BandWorkers() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread &worker : threads) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief BandWorkers::size Returns the number of bands, which is the number of threads
+ * including the caller.
+ * @return The number of bands.
+ */
+int BandWorkers::size() const {
+    return threads.size() + 1;
+}
+
+/**
+ * @brief BandWorkers::run Runs the task once for every band in parallel and returns when all
+ * bands are done.
+ * @param task The task, called with the band number from 0 to size() - 1.
+ */
+void BandWorkers::run(const function<void(int)> &task) {
+    {
+        lock_guard<mutex> guard(lock);
+        this->task = &task;
+        pending = threads.size();
+        round++;
+    }
+    wake.notify_all();
+    task(0);
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, [this] { return pending == 0; });
+    this->task = nullptr;
+}
+
+/**
+ * @brief BandWorkers::workerLoop The loop of a worker thread, which runs its band of every round
+ * until the pool is destroyed.
+ * @param band The band of the worker.
+ */
+void BandWorkers::workerLoop(int band) {
+    long long seen = 0;
+    while (true) {
+        const function<void(int)>* current;
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [this, seen] { return stopping || round != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = round;
+            current = task;
+        }
+        (*current)(band);
+        bool last;
+        {
+            lock_guard<mutex> guard(lock);
+            pending--;
+            last = pending == 0;
+        }
+        if (last) {
+            finished.notify_one();
+        }
+    }
+}
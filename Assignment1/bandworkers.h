@@ -0,0 +1,38 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * BandWorkers class, a pool of threads that advance the horizontal bands of a board in parallel.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+class BandWorkers {
+public:
+    BandWorkers(int bandCount); //constructor, starts bandCount - 1 threads
+    ~BandWorkers(); //destructor, stops and joins the threads
+    int size() const; //returns the number of bands
+    void run(const function<void(int)> &task); //runs task(band) for every band, waits for all of them
+
+private:
+    void workerLoop(int band);
+    vector<thread> threads;
+    mutex lock;
+    condition_variable wake; //signals the workers that a new round has started
+    condition_variable finished; //signals the caller that the last band of a round is done
+    const function<void(int)>* task; //the task of the current round
+    long long round; //number of rounds started, the workers wait for it to change
+    int pending; //number of bands of the current round still running
+    bool stopping;
+
+    BandWorkers(const BandWorkers &other); //not copyable
+    BandWorkers& operator= (const BandWorkers &other);
+};
@@ -0,0 +1,1124 @@
+/**
+ * @brief The following code involves the methods neccessary to store a Game of Life board
+ * with one bit per cell and to advance it a whole word (64 cells) at a time. Every row is
+ * surrounded by ghost words and the board is surrounded by ghost rows, which are refreshed
+ * once per generation by a boundary policy (dead, toroidal or reflective) chosen at compile time,
+ * so that the neighbour sums can be computed without any bounds checks or modulos. The rows
+ * themselves are advanced with the rule of the board (B3/S23 unless another Life-like rule is
+ * chosen) by the fastest row kernel the processor supports (see lifekernel.h) or, if chosen, two
+ * at a time by the lookup table stepper (see lifetable.h), optionally split into horizontal
+ * bands that are advanced by parallel threads. When the tiles are tracked, only the tiles that
+ * changed in the last generation and their neighbours are recomputed, so the cost of a
+ * generation follows the activity of the colony rather than its area. Built with -DLIFE_STATS,
+ * every generation is timed and counted as well (see lifestats.h).
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "bitgrid.h"
+#include <algorithm>
+#include <cstring>
+
+//constant decleration(s)
+const int WORD_BITS = 64; //number of cells stored in a single word
+const int TILE_ROWS = 16; //height of a tracked tile
+const int TILE_WORDS = 4; //width of a tracked tile in words (256 cells, one AVX2 operation)
+
+/**
+ * The boundary policies map a ghost cell (row or column -1 or "size") to the cell of the board
+ * whose state it copies, or to -1 if it stays dead. They are template arguments of
+ * refreshGhosts, so the mapping is resolved at compile time.
+ */
+struct DeadBoundary {
+    static int source(int, int) {
+        return -1;
+    }
+};
+
+struct ToroidalBoundary {
+    static int source(int ghost, int size) {
+        return (ghost < 0) ? size - 1 : 0;
+    }
+};
+
+struct ReflectiveBoundary {
+    static int source(int ghost, int size) {
+        return (ghost < 0) ? 0 : size - 1;
+    }
+};
+
+/**
+ * @brief BitGrid::BitGrid The default constructor of the BitGrid class, creates an empty board.
+ */
+BitGrid::BitGrid() {
+    cells = nullptr;
+    next = nullptr;
+    rule = CONWAY_RULE;
+    kernel = selectRowKernel();
+    lookupTable = false;
+    updateStepper();
+    workers = nullptr;
+    tracking = false;
+    allocate(0, 0);
+}
+
+/**
+ * @brief BitGrid::BitGrid Creates a board of the given dimensions, all cells are dead.
+ * @param numRows The number of rows of the board.
+ * @param numCols The number of columns of the board.
+ */
+BitGrid::BitGrid(int numRows, int numCols) {
+    cells = nullptr;
+    next = nullptr;
+    rule = CONWAY_RULE;
+    kernel = selectRowKernel();
+    lookupTable = false;
+    updateStepper();
+    workers = nullptr;
+    tracking = false;
+    allocate(numRows, numCols);
+}
+
+/**
+ * @brief BitGrid::~BitGrid Destructor of the BitGrid class. Deletes both planes from the memory
+ * and stops the worker threads.
+ */
+BitGrid::~BitGrid() {
+    delete [] cells;
+    delete [] next;
+    delete workers;
+}
+
+/**
+ * @brief BitGrid::resize Resizes the board. All cells are dead after the call.
+ * @param numRows The new number of rows.
+ * @param numCols The new number of columns.
+ */
+void BitGrid::resize(int numRows, int numCols) {
+    allocate(numRows, numCols);
+}
+
+/**
+ * @brief BitGrid::clear Kills every cell, as resizing the board to its own dimensions does, but
+ * zeroes the current plane in place instead of allocating new planes, so a board refilled every
+ * generation (e.g. a window of the unbounded plane) is not reallocated each time. The scratch
+ * plane is left as it is, the next generation overwrites it and every tile is recomputed.
+ */
+void BitGrid::clear() {
+    memset(cells, 0, sizeof(uint64_t) * (size_t) (rows + 3) * stride);
+    resetTiles();
+}
+
+/**
+ * @brief BitGrid::numRows Returns the number of rows of the board.
+ * @return The number of rows.
+ */
+int BitGrid::numRows() const {
+    return rows;
+}
+
+/**
+ * @brief BitGrid::numCols Returns the number of columns of the board.
+ * @return The number of columns.
+ */
+int BitGrid::numCols() const {
+    return cols;
+}
+
+/**
+ * @brief BitGrid::inBounds Checks whether or not a location is on the board.
+ * @param row The row of the location.
+ * @param col The column of the location.
+ * @return A bool expression indicating whether or not the location is on the board.
+ */
+bool BitGrid::inBounds(int row, int col) const {
+    return row >= 0 && row < rows && col >= 0 && col < cols;
+}
+
+/**
+ * @brief BitGrid::get Returns the state of a cell. Throws a string exception if the location
+ * is out of bounds.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @return True if the cell is alive, false otherwise.
+ */
+bool BitGrid::get(int row, int col) const {
+    if (!inBounds(row, col)) {
+        throw("Row and/or column are out of bounds.");
+    }
+    const uint64_t* p = rowPointer(cells, row);
+    return (p[1 + col / WORD_BITS] >> (col % WORD_BITS)) & 1;
+}
+
+/**
+ * @brief BitGrid::set Makes a cell alive or dead. Throws a string exception if the location
+ * is out of bounds.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @param alive The new state of the cell.
+ */
+void BitGrid::set(int row, int col, bool alive) {
+    if (!inBounds(row, col)) {
+        throw("Row and/or column are out of bounds.");
+    }
+    uint64_t* p = rowPointer(cells, row);
+    uint64_t bit = (uint64_t) 1 << (col % WORD_BITS);
+    trackingReset = true; //the scratch plane no longer holds the previous generation of the tile
+    if (alive) {
+        p[1 + col / WORD_BITS] |= bit;
+    } else {
+        p[1 + col / WORD_BITS] &= ~bit;
+    }
+}
+
+/**
+ * @brief BitGrid::setRun Makes a run of consecutive cells of a row alive, a whole word at a time.
+ * Used by the pattern loaders, which decode runs of cells rather than single cells.
+ * @param row The row of the run.
+ * @param col The column of the first cell of the run.
+ * @param length The number of cells in the run.
+ */
+void BitGrid::setRun(int row, int col, int length) {
+    if (length <= 0) {
+        return;
+    }
+    if (!inBounds(row, col) || col + length > cols) {
+        throw("Row and/or column are out of bounds.");
+    }
+    uint64_t* p = rowPointer(cells, row) + 1;
+    trackingReset = true;
+    int end = col + length; //one past the last cell of the run
+    while (col < end) {
+        int bit = col % WORD_BITS;
+        int count = min(WORD_BITS - bit, end - col);
+        uint64_t mask = (count == WORD_BITS) ? ~(uint64_t) 0 : (((uint64_t) 1 << count) - 1) << bit;
+        p[col / WORD_BITS] |= mask;
+        col += count;
+    }
+}
+
+/**
+ * @brief BitGrid::findCell Returns the first column of a row, starting from a given column,
+ * whose cell is in the given state. The words are scanned rather than the single cells, so the
+ * runs of a row can be found in time proportional to the number of words.
+ * @param row The row to scan.
+ * @param col The column to start from.
+ * @param alive The state to look for.
+ * @return The column of the cell, or numCols() if there is no such cell.
+ */
+int BitGrid::findCell(int row, int col, bool alive) const {
+    if (row < 0 || row >= rows) {
+        throw("Row and/or column are out of bounds.");
+    }
+    if (col >= cols) {
+        return cols;
+    }
+    const uint64_t* p = rowPointer(cells, row) + 1;
+    int w = col / WORD_BITS;
+    uint64_t word = (alive ? p[w] : ~p[w]) & (~(uint64_t) 0 << (col % WORD_BITS));
+    while (word == 0 && ++w < words) {
+        word = alive ? p[w] : ~p[w];
+    }
+    if (word == 0) {
+        return cols;
+    }
+    return min(cols, w * WORD_BITS + __builtin_ctzll(word));
+}
+
+/**
+ * @brief BitGrid::findChange Returns the first column of a row, starting from a given column,
+ * whose cell is in a different state on another board of the same dimensions. As in findCell,
+ * whole words are compared, so the cells that changed between two generations can be found
+ * without comparing the cells one by one.
+ * @param other The board to compare with.
+ * @param row The row to scan.
+ * @param col The column to start from.
+ * @return The column of the cell, or numCols() if the rest of the row is the same.
+ */
+int BitGrid::findChange(const BitGrid &other, int row, int col) const {
+    if (rows != other.rows || cols != other.cols) {
+        throw("The boards to compare have different dimensions.");
+    }
+    if (row < 0 || row >= rows) {
+        throw("Row and/or column are out of bounds.");
+    }
+    if (col >= cols) {
+        return cols;
+    }
+    const uint64_t* p = rowPointer(cells, row) + 1;
+    const uint64_t* q = rowPointer(other.cells, row) + 1;
+    int w = col / WORD_BITS;
+    uint64_t word = (p[w] ^ q[w]) & (~(uint64_t) 0 << (col % WORD_BITS));
+    while (word == 0 && ++w < words) {
+        word = p[w] ^ q[w];
+    }
+    if (word == 0) {
+        return cols;
+    }
+    return min(cols, w * WORD_BITS + __builtin_ctzll(word));
+}
+
+/**
+ * @brief BitGrid::rowWordCount Returns the number of words holding the cells of a row.
+ * @return The number of words, numCols() / 64 rounded up.
+ */
+int BitGrid::rowWordCount() const {
+    return words;
+}
+
+/**
+ * @brief BitGrid::rowWords Returns the words holding the cells of a row, so that whole rows can
+ * be saved without reading the cells one by one. Column c is bit c % 64 of word c / 64, the bits
+ * beyond the last column are 0 (advance clears the ghost cells it writes there).
+ * @param row The row.
+ * @return The first of rowWordCount() words, valid until the board is advanced or resized.
+ */
+const uint64_t* BitGrid::rowWords(int row) const {
+    if (row < 0 || row >= rows) {
+        throw("Row and/or column are out of bounds.");
+    }
+    return rowPointer(cells, row) + 1;
+}
+
+/**
+ * @brief BitGrid::setRowWords Replaces the cells of a row with words laid out as in rowWords.
+ * @param row The row.
+ * @param source The first of rowWordCount() words, the bits beyond the last column are ignored.
+ */
+void BitGrid::setRowWords(int row, const uint64_t* source) {
+    if (row < 0 || row >= rows) {
+        throw("Row and/or column are out of bounds.");
+    }
+    if (words == 0) {
+        return;
+    }
+    uint64_t* p = rowPointer(cells, row) + 1;
+    memcpy(p, source, sizeof(uint64_t) * words);
+    p[words - 1] &= lastWordMask;
+    trackingReset = true;
+}
+
+/**
+ * @brief BitGrid::advance Advances the board to the next generation with the rule of the board.
+ * With the default rule (B3/S23) a cell with 1 or fewer neighbours dies, a cell with 2
+ * neighbours remains stable, a location with 3 neighbours creates life and a cell with 4 or more
+ * neighbours dies.
+ * @param boundary What lies beyond the edges of the board.
+ */
+void BitGrid::advance(Boundary boundary) {
+    if (rows == 0 || cols == 0) {
+        return;
+    }
+    LIFE_STATS_ONLY(stats.boundaryNanos = stats.stepNanos = stats.countNanos = 0;)
+    LIFE_STATS_START(clock);
+    switch (boundary) {
+    case TOROIDAL_BOUNDARY:
+        refreshGhosts<ToroidalBoundary>();
+        break;
+    case REFLECTIVE_BOUNDARY:
+        refreshGhosts<ReflectiveBoundary>();
+        break;
+    default:
+        refreshGhosts<DeadBoundary>();
+        break;
+    }
+    LIFE_STATS_LAP(stats.boundaryNanos, clock);
+    if (tracking) {
+        advanceTracked(boundary);
+        LIFE_STATS_LAP(stats.stepNanos, clock);
+        LIFE_STATS_ONLY(collectTileStats();)
+        LIFE_STATS_LAP(stats.countNanos, clock);
+        return;
+    }
+    LIFE_STATS_ONLY(resetBandStats();)
+    if (workers == nullptr) {
+        advanceRows(0, rows, 0);
+    } else {
+        //the bands only read the current plane, so the edge rows of the neighbouring bands (and
+        //the ghost rows at the edges of the board) serve as their halo rows without any copying
+        //the lookup table stepper advances pairs of rows, so its bands start on even rows
+        int bands = workers->size();
+        int alignment = lookupTable ? ~1 : ~0;
+        workers->run([this, bands, alignment](int band) {
+            int first = ((long long) rows * band / bands) & alignment;
+            int last = (band == bands - 1) ? rows : ((long long) rows * (band + 1) / bands) & alignment;
+            advanceRows(first, last, band);
+        });
+    }
+    uint64_t* temp = cells;
+    cells = next;
+    next = temp;
+    trackingReset = true;
+    LIFE_STATS_LAP(stats.stepNanos, clock);
+    LIFE_STATS_ONLY(collectStats();)
+    LIFE_STATS_LAP(stats.countNanos, clock);
+}
+
+/**
+ * @brief BitGrid::advance Advances the board to the next generation, either wrapping around
+ * itself or surrounded by dead cells.
+ * @param wrapping A bool type expression indicating whether the board is wrapping around
+ * itself or not.
+ */
+void BitGrid::advance(bool wrapping) {
+    advance(wrapping ? TOROIDAL_BOUNDARY : DEAD_BOUNDARY);
+}
+
+/**
+ * @brief BitGrid::setRule Replaces the rule the board is advanced with.
+ * @param rule The rule, e.g. parsed from a rulestring such as "B36/S23".
+ */
+void BitGrid::setRule(RuleMask rule) {
+    this->rule = rule;
+    updateStepper();
+    trackingReset = true;
+}
+
+/**
+ * @brief BitGrid::getRule Returns the rule the board is advanced with.
+ * @return The rule.
+ */
+RuleMask BitGrid::getRule() const {
+    return rule;
+}
+
+/**
+ * @brief BitGrid::setKernel Replaces the row kernel used by advance, all kernels give the same
+ * results so this only changes the speed.
+ * @param kernel The Game of Life row kernel of the instruction set to use, which must be
+ * supported by the processor. The board uses the kernel of that instruction set for its rule.
+ */
+void BitGrid::setKernel(RowKernel kernel) {
+    this->kernel = kernel;
+    updateStepper();
+}
+
+/**
+ * @brief BitGrid::setLookupTable Chooses between the row kernel and the lookup table stepper,
+ * which looks the next generation of every 2x2 square up in a table of all 4x4 neighbourhoods.
+ * Both give the same results.
+ * @param enabled True to use the lookup table stepper.
+ */
+void BitGrid::setLookupTable(bool enabled) {
+    lookupTable = enabled;
+    updateStepper();
+}
+
+/**
+ * @brief BitGrid::usesLookupTable Checks whether or not the lookup table stepper is used.
+ * @return True if the lookup table stepper advances the board.
+ */
+bool BitGrid::usesLookupTable() const {
+    return lookupTable;
+}
+
+/**
+ * @brief BitGrid::getKernel Returns the Game of Life row kernel of the instruction set used by
+ * advance.
+ * @return The row kernel.
+ */
+RowKernel BitGrid::getKernel() const {
+    return kernel;
+}
+
+/**
+ * @brief BitGrid::setThreadCount Sets the number of threads advancing the board. The board is
+ * split into that many horizontal bands of (almost) equal height.
+ * @param threadCount The number of threads, 1 advances the board on the calling thread only.
+ */
+void BitGrid::setThreadCount(int threadCount) {
+    if (threadCount < 1) {
+        throw("There must be at least one thread.");
+    }
+    if (threadCount == getThreadCount()) {
+        return;
+    }
+    delete workers;
+    workers = nullptr;
+    if (threadCount > 1) {
+        workers = new BandWorkers(threadCount);
+    }
+}
+
+/**
+ * @brief BitGrid::getThreadCount Returns the number of threads advancing the board.
+ * @return The number of threads.
+ */
+int BitGrid::getThreadCount() const {
+    return workers == nullptr ? 1 : workers->size();
+}
+
+/**
+ * @brief BitGrid::setTracking Turns the tracking of the tiles on or off. When it is on, the board
+ * is split into tiles of 16 rows by 256 columns and a generation only recomputes the tiles whose
+ * cells, or whose neighbouring tiles' cells, changed in the last generation. The results are the
+ * same either way.
+ * @param enabled True to track the tiles.
+ */
+void BitGrid::setTracking(bool enabled) {
+    tracking = enabled;
+    trackingReset = true;
+}
+
+/**
+ * @brief BitGrid::isTracking Checks whether or not the tiles are tracked.
+ * @return True if only the tiles near the changes are recomputed.
+ */
+bool BitGrid::isTracking() const {
+    return tracking;
+}
+
+/**
+ * @brief BitGrid::getTileCount Returns the number of tiles of the board.
+ * @return The number of tiles.
+ */
+int BitGrid::getTileCount() const {
+    return tileRows * tileCols;
+}
+
+/**
+ * @brief BitGrid::getTilesSkipped Returns the number of tiles the last tracked generation did
+ * not need to recompute.
+ * @return The number of skipped tiles.
+ */
+int BitGrid::getTilesSkipped() const {
+    return tilesSkipped;
+}
+
+/**
+ * @brief BitGrid::getTotalTilesSkipped Returns the number of tiles skipped by all tracked
+ * generations since the board was created or resized.
+ * @return The number of skipped tiles.
+ */
+long long BitGrid::getTotalTilesSkipped() const {
+    return totalTilesSkipped;
+}
+
+/**
+ * @brief BitGrid::getTotalTiles Returns the number of tiles of all tracked generations since the
+ * board was created or resized, the skipped fraction is getTotalTilesSkipped() / getTotalTiles().
+ * @return The number of tiles, skipped or not.
+ */
+long long BitGrid::getTotalTiles() const {
+    return totalTiles;
+}
+
+/**
+ * @brief BitGrid::toString Returns a row of the board in the text format of the grid files,
+ * where "X" is a living cell and "-" is a dead one.
+ * @param row The row to convert.
+ * @return The string representing the row.
+ */
+string BitGrid::toString(int row) const {
+    string result(cols, '-');
+    for (int c = 0; c < cols; c++) {
+        if (get(row, c)) {
+            result[c] = 'X';
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief BitGrid::hash Returns a 64 bit hash of the board, which changes with every cell. The
+ * words are mixed with the finalizer of splitmix64 and combined in order, the ghost bits and the
+ * padding bits are left out.
+ * @return The hash of the board.
+ */
+uint64_t BitGrid::hash() const {
+    uint64_t result = hashSeed(rows, cols);
+    for (int r = 0; r < rows && words > 0; r++) {
+        const uint64_t* p = rowPointer(cells, r) + 1;
+        uint64_t last = p[words - 1] & lastWordMask;
+        result = hashWords(hashWords(result, p, words - 1), &last, 1);
+    }
+    return result;
+}
+
+/**
+ * @brief hashSeed Returns the hash of a board before any of its words are added, see
+ * BitGrid::hash.
+ * @param rows, cols The dimensions of the board.
+ * @return The hash.
+ */
+uint64_t hashSeed(int rows, int cols) {
+    return ((uint64_t) rows << 32) ^ (uint64_t) cols;
+}
+
+/**
+ * @brief hashWords Adds words to a hash the way BitGrid::hash adds the words of its rows, so a
+ * board held in pieces (e.g. by several processes) can be hashed a row at a time.
+ * @param hash The hash of the words before these.
+ * @param words The first word, the bits beyond the last column must be 0.
+ * @param count The number of words.
+ * @return The hash with the words added.
+ */
+uint64_t hashWords(uint64_t hash, const uint64_t* words, int count) {
+    for (int w = 0; w < count; w++) {
+        uint64_t mixed = (hash ^ words[w]) + 0x9e3779b97f4a7c15ULL;
+        mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+        hash = mixed ^ (mixed >> 31);
+    }
+    return hash;
+}
+
+/**
+ * @brief BitGrid::copyCells Makes the board a copy of another board's cells and rule. Unlike the
+ * assignment, the kernel, the threads and the tracking option of the board are kept and the
+ * planes are only reallocated when the dimensions differ, so copying a board every generation
+ * (e.g. to hand it to a renderer) costs a single memcpy.
+ * @param other The board whose cells are copied.
+ */
+void BitGrid::copyCells(const BitGrid &other) {
+    if (this == &other) {
+        return;
+    }
+    if (rows != other.rows || cols != other.cols) {
+        allocate(other.rows, other.cols);
+    }
+    memcpy(cells, other.cells, sizeof(uint64_t) * (rows + 2) * stride);
+    if (rule != other.rule) {
+        rule = other.rule;
+        updateStepper();
+    }
+    trackingReset = true;
+}
+
+/**
+ * @brief BitGrid::BitGrid Copy constructor of the BitGrid class, makes a deep copy of the board.
+ * @param other The board to copy.
+ */
+BitGrid::BitGrid(const BitGrid &other) {
+    cells = nullptr;
+    next = nullptr;
+    rule = other.rule;
+    kernel = other.kernel;
+    lookupTable = other.lookupTable;
+    updateStepper();
+    workers = nullptr;
+    tracking = other.tracking;
+    setThreadCount(other.getThreadCount());
+    allocate(other.rows, other.cols);
+    memcpy(cells, other.cells, sizeof(uint64_t) * (rows + 2) * stride);
+}
+
+/**
+ * @brief BitGrid::operator= Assignment overload of the BitGrid class, makes a deep copy of the
+ * board.
+ * @param other The board to copy.
+ * @return The board itself so that the operator can be chained.
+ */
+BitGrid& BitGrid::operator= (const BitGrid &other) {
+    if (this == &other) {
+        return *this;
+    }
+    rule = other.rule;
+    kernel = other.kernel;
+    lookupTable = other.lookupTable;
+    updateStepper();
+    tracking = other.tracking;
+    setThreadCount(other.getThreadCount());
+    allocate(other.rows, other.cols);
+    memcpy(cells, other.cells, sizeof(uint64_t) * (rows + 2) * stride);
+    return *this;
+}
+
+/**
+ * @brief BitGrid::rowPointer Returns the first word (the west ghost word) of a row of a plane.
+ * @param plane The plane containing the row.
+ * @param row The row, -1 and numRows() refer to the ghost rows.
+ * @return The pointer to the row.
+ */
+uint64_t* BitGrid::rowPointer(uint64_t* plane, int row) const {
+    return plane + (size_t) (row + 1) * stride;
+}
+
+const uint64_t* BitGrid::rowPointer(const uint64_t* plane, int row) const {
+    return plane + (size_t) (row + 1) * stride;
+}
+
+/**
+ * @brief BitGrid::allocate Deletes the current planes and allocates zeroed planes for a board
+ * of the given dimensions. Every row gets a ghost word on both sides and the board gets a
+ * ghost row above and below.
+ * @param numRows The number of rows of the board.
+ * @param numCols The number of columns of the board.
+ */
+void BitGrid::allocate(int numRows, int numCols) {
+    if (numRows < 0 || numCols < 0) {
+        throw("The dimensions of the board can not be negative.");
+    }
+    delete [] cells;
+    delete [] next;
+    rows = numRows;
+    cols = numCols;
+    words = (cols + WORD_BITS - 1) / WORD_BITS;
+    stride = words + 2;
+    lastWordMask = (cols % WORD_BITS == 0) ? ~(uint64_t) 0 : ((uint64_t) 1 << (cols % WORD_BITS)) - 1;
+    //one more row below the south ghost row stays dead, the lookup table stepper reads it when
+    //it pairs an odd last row with the south ghost row
+    size_t size = (size_t) (rows + 3) * stride;
+    cells = new uint64_t[size]();
+    next = new uint64_t[size]();
+    resetTiles();
+}
+
+/**
+ * @brief BitGrid::resetTiles Forgets the tiles tracked so far, so every tile is recomputed by the
+ * next generation, and resets the counters of the board, as for a new board.
+ */
+void BitGrid::resetTiles() {
+    tileRows = (rows + TILE_ROWS - 1) / TILE_ROWS;
+    tileCols = (words + TILE_WORDS - 1) / TILE_WORDS;
+    tileStamps.assign(tileRows * tileCols, 0);
+    stamp = 0;
+    changedTiles.clear();
+    trackingReset = true;
+    tilesSkipped = 0;
+    totalTilesSkipped = 0;
+    totalTiles = 0;
+    LIFE_STATS_ONLY(tileStats.assign(tileRows * tileCols, TileStats());)
+    LIFE_STATS_ONLY(trackedPopulation = 0;)
+    LIFE_STATS_ONLY(stats = GenerationStats();)
+    LIFE_STATS_ONLY(stats.top = stats.left = stats.bottom = stats.right = -1;)
+}
+
+/**
+ * @brief BitGrid::updateStepper Picks the row kernel of the chosen instruction set for the rule
+ * and, if the lookup table stepper is used, the table of the rule.
+ */
+void BitGrid::updateStepper() {
+    ruleKernel = rowKernelForRule(kernel, rule);
+    lookup = lookupTable ? lookupTableFor(rule) : nullptr;
+    LIFE_STATS_ONLY(countKernel = countKernelFor(kernel);)
+}
+
+/**
+ * @brief BitGrid::advanceRows Writes the next generation of a range of rows into the scratch
+ * plane, TILE_ROWS rows at a time. Built with -DLIFE_STATS, every group of rows is counted right
+ * after it is advanced, while its words are still in the cache, rather than in another pass over
+ * the board. The ghost cells must be up to date.
+ * @param first The first row of the range.
+ * @param last The row after the last row of the range.
+ * @param band The band of the range, whose counters the rows are added to.
+ */
+void BitGrid::advanceRows(int first, int last, int band) {
+    for (int group = first; group < last; group += TILE_ROWS) {
+        int end = min(last, group + TILE_ROWS);
+        if (lookupTable) {
+            //an odd last row is paired with the south ghost row, whose result is never used
+            for (int r = group; r < end; r += 2) {
+                lookupTableRowPair(rowPointer(cells, r - 1) + 1, rowPointer(cells, r) + 1,
+                                   rowPointer(cells, r + 1) + 1, rowPointer(cells, r + 2) + 1,
+                                   rowPointer(next, r) + 1, rowPointer(next, r + 1) + 1, words, lookup);
+            }
+        } else {
+            for (int r = group; r < end; r++) {
+                //the kernel starts after the west ghost word, which it reads for the west neighbours
+                ruleKernel(rowPointer(cells, r - 1) + 1, rowPointer(cells, r) + 1,
+                           rowPointer(cells, r + 1) + 1, rowPointer(next, r) + 1, words, rule);
+            }
+        }
+        for (int r = group; r < end; r++) {
+            rowPointer(next, r)[words] &= lastWordMask; //the bits beyond the last column stay dead
+        }
+        LIFE_STATS_ONLY(countRows(group, end, band);)
+    }
+    (void) band;
+}
+
+/**
+ * @brief BitGrid::advanceTracked Advances the board to the next generation, recomputing only the
+ * dirty tiles. A tile that is skipped has the same cells in both planes, because the scratch
+ * plane holds the previous generation and neither the tile nor its neighbours changed since then.
+ * The ghost cells must be up to date.
+ * @param wrapping A bool type expression indicating whether the board is wrapping around
+ * itself or not.
+ */
+void BitGrid::advanceTracked(Boundary boundary) {
+    findDirtyTiles(boundary);
+    int bands = (workers == nullptr) ? 1 : workers->size();
+    bandChanges.resize(bands);
+    auto advanceBand = [this, bands](int band) {
+        vector<int> &changes = bandChanges[band];
+        changes.clear();
+        long long count = dirtyTiles.size();
+        for (long long i = count * band / bands; i < count * (band + 1) / bands; i++) {
+            if (advanceTile(dirtyTiles[i])) {
+                changes.push_back(dirtyTiles[i]);
+            }
+        }
+    };
+    if (workers == nullptr) {
+        advanceBand(0);
+    } else {
+        workers->run(advanceBand);
+    }
+    changedTiles.clear();
+    for (const vector<int> &changes : bandChanges) {
+        changedTiles.insert(changedTiles.end(), changes.begin(), changes.end());
+    }
+    tilesSkipped = getTileCount() - dirtyTiles.size();
+    totalTilesSkipped += tilesSkipped;
+    totalTiles += getTileCount();
+    trackingReset = false;
+    trackedBoundary = boundary;
+    uint64_t* temp = cells;
+    cells = next;
+    next = temp;
+    //the skipped tiles of the last column still hold the ghost cells written after the last
+    //column two generations ago, a word per row clears them
+    if (lastWordMask != ~(uint64_t) 0) {
+        for (int r = 0; r < rows; r++) {
+            rowPointer(cells, r)[words] &= lastWordMask;
+        }
+    }
+}
+
+/**
+ * @brief BitGrid::findDirtyTiles Collects the tiles to recompute: every tile after a reset,
+ * otherwise the tiles that changed in the last generation and their eight neighbours (across the
+ * edges too when wrapping). The work is proportional to the number of changed tiles.
+ * @param wrapping A bool type expression indicating whether the board is wrapping around
+ * itself or not.
+ */
+void BitGrid::findDirtyTiles(Boundary boundary) {
+    dirtyTiles.clear();
+    if (trackingReset || boundary != trackedBoundary) {
+        for (int tile = 0; tile < getTileCount(); tile++) {
+            dirtyTiles.push_back(tile);
+        }
+        return;
+    }
+    stamp++;
+    if (stamp == 0) { //the stamps wrapped around, forgetting the old ones
+        tileStamps.assign(tileStamps.size(), 0);
+        stamp = 1;
+    }
+    for (int tile : changedTiles) {
+        int tileRow = tile / tileCols;
+        int tileCol = tile % tileCols;
+        for (int r = tileRow - 1; r <= tileRow + 1; r++) {
+            for (int c = tileCol - 1; c <= tileCol + 1; c++) {
+                int neighbourRow = r;
+                int neighbourCol = c;
+                if (boundary == TOROIDAL_BOUNDARY) {
+                    neighbourRow = (r + tileRows) % tileRows;
+                    neighbourCol = (c + tileCols) % tileCols;
+                } else if (r < 0 || r >= tileRows || c < 0 || c >= tileCols) {
+                    continue;
+                }
+                int neighbour = neighbourRow * tileCols + neighbourCol;
+                if (tileStamps[neighbour] != stamp) {
+                    tileStamps[neighbour] = stamp;
+                    dirtyTiles.push_back(neighbour);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief BitGrid::advanceTile Writes the next generation of a tile into the scratch plane.
+ * @param tile The index of the tile, row by row.
+ * @return True if a cell of the tile changed.
+ */
+bool BitGrid::advanceTile(int tile) {
+    int firstRow = (tile / tileCols) * TILE_ROWS;
+    int lastRow = min(rows, firstRow + TILE_ROWS);
+    int firstWord = 1 + (tile % tileCols) * TILE_WORDS;
+    int count = min(TILE_WORDS, words + 1 - firstWord);
+    bool lastTile = firstWord + count - 1 == words;
+    if (lookupTable) {
+        for (int r = firstRow; r < lastRow; r += 2) {
+            lookupTableRowPair(rowPointer(cells, r - 1) + firstWord, rowPointer(cells, r) + firstWord,
+                               rowPointer(cells, r + 1) + firstWord, rowPointer(cells, r + 2) + firstWord,
+                               rowPointer(next, r) + firstWord, rowPointer(next, r + 1) + firstWord, count,
+                               lookup);
+        }
+    } else {
+        for (int r = firstRow; r < lastRow; r++) {
+            ruleKernel(rowPointer(cells, r - 1) + firstWord, rowPointer(cells, r) + firstWord,
+                       rowPointer(cells, r + 1) + firstWord, rowPointer(next, r) + firstWord, count, rule);
+        }
+    }
+    uint64_t difference = 0;
+    for (int r = firstRow; r < lastRow; r++) {
+        const uint64_t* current = rowPointer(cells, r);
+        uint64_t* result = rowPointer(next, r);
+        if (lastTile) {
+            result[words] &= lastWordMask;
+        }
+        for (int w = firstWord; w < firstWord + count; w++) {
+            //the ghost bit after the last column is not a change
+            uint64_t currentWord = (w == words) ? current[w] & lastWordMask : current[w];
+            difference |= result[w] ^ currentWord;
+        }
+    }
+    LIFE_STATS_ONLY(countTile(tile, firstRow, lastRow, firstWord, count);)
+    return difference != 0;
+}
+
+/**
+ * @brief BitGrid::refreshGhosts Fills the ghost words and the ghost rows of the current plane
+ * for the next generation. Every ghost cell either copies the board cell the boundary policy
+ * maps it to or stays dead; the ghost rows are copied after the ghost words, so the corners get
+ * the right cells as well. The padding bits after the last column are cleared.
+ */
+template <typename Policy>
+void BitGrid::refreshGhosts() {
+    int west = Policy::source(-1, cols);
+    int east = Policy::source(cols, cols);
+    for (int r = 0; r < rows; r++) {
+        uint64_t* p = rowPointer(cells, r);
+        p[0] = 0;
+        p[words] &= lastWordMask;
+        p[words + 1] = 0;
+        //column -1 is the last bit of the west ghost word, column numCols() is the first bit
+        //after the last column
+        if (west >= 0) {
+            p[0] = (uint64_t) get(r, west) << 63;
+        }
+        if (east >= 0) {
+            p[1 + cols / WORD_BITS] |= (uint64_t) get(r, east) << (cols % WORD_BITS);
+        }
+    }
+    int north = Policy::source(-1, rows);
+    int south = Policy::source(rows, rows);
+    if (north >= 0) {
+        memcpy(rowPointer(cells, -1), rowPointer(cells, north), sizeof(uint64_t) * stride);
+    } else {
+        memset(rowPointer(cells, -1), 0, sizeof(uint64_t) * stride);
+    }
+    if (south >= 0) {
+        memcpy(rowPointer(cells, rows), rowPointer(cells, south), sizeof(uint64_t) * stride);
+    } else {
+        memset(rowPointer(cells, rows), 0, sizeof(uint64_t) * stride);
+    }
+}
+
+#ifdef LIFE_STATS
+
+/**
+ * @brief BitGrid::getStats Returns the counters of the last generation: its population, births,
+ * deaths and bounding box, and the time spent on each phase of advance. Only built with
+ * -DLIFE_STATS.
+ * @return The counters.
+ */
+const GenerationStats& BitGrid::getStats() const {
+    return stats;
+}
+
+/**
+ * @brief BitGrid::resetBandStats Clears the counters of every band before a generation that
+ * advances every row.
+ */
+void BitGrid::resetBandStats() {
+    int bands = (workers == nullptr) ? 1 : workers->size();
+    bandStats.assign(bands, GenerationStats());
+    bandColumns.resize(bands);
+    for (int band = 0; band < bands; band++) {
+        bandStats[band].top = bandStats[band].bottom = -1;
+        bandColumns[band].assign(words, 0);
+    }
+}
+
+/**
+ * @brief BitGrid::countRows Adds the living cells of rows just advanced into the scratch plane,
+ * the cells that came alive or died since the current generation and the rows and columns
+ * with a living cell to the counters of a band. The ghost cells after the last column of the
+ * current generation are still read by the next rows, so they are masked rather than cleared.
+ * @param first The first row, the rows of a band must be counted in order.
+ * @param last The row after the last row.
+ * @param band The band.
+ */
+void BitGrid::countRows(int first, int last, int band) {
+    CellCounts cellCounts = {0, 0, 0, -1, -1};
+    uint64_t* columns = bandColumns[band].data();
+    int full = (lastWordMask == ~(uint64_t) 0) ? words : words - 1; //words without ghost cells
+    if (full > 0) {
+        countKernel(rowPointer(next, first) + 1, rowPointer(cells, first) + 1, full, last - first, stride,
+                    columns, cellCounts);
+    }
+    if (full < words) {
+        for (int r = first; r < last; r++) {
+            uint64_t current = rowPointer(next, r)[words];
+            uint64_t changed = current ^ (rowPointer(cells, r)[words] & lastWordMask);
+            if (current != 0) {
+                cellCounts.population += __builtin_popcountll(current);
+                columns[words - 1] |= current;
+                if (cellCounts.firstRow < 0 || r - first < cellCounts.firstRow) {
+                    cellCounts.firstRow = r - first;
+                }
+                cellCounts.lastRow = max(cellCounts.lastRow, r - first);
+            }
+            if (changed != 0) {
+                int born = __builtin_popcountll(changed & current);
+                cellCounts.births += born;
+                cellCounts.deaths += __builtin_popcountll(changed) - born;
+            }
+        }
+    }
+    GenerationStats &counts = bandStats[band];
+    counts.population += cellCounts.population;
+    counts.births += cellCounts.births;
+    counts.deaths += cellCounts.deaths;
+    if (cellCounts.firstRow >= 0) {
+        if (counts.top < 0) {
+            counts.top = first + cellCounts.firstRow;
+        }
+        counts.bottom = first + cellCounts.lastRow;
+    }
+}
+
+/**
+ * @brief BitGrid::collectStats Merges the counters the bands added up while advancing their
+ * rows into the counters of the generation.
+ */
+void BitGrid::collectStats() {
+    stats.population = stats.births = stats.deaths = 0;
+    stats.top = stats.left = stats.bottom = stats.right = -1;
+    vector<uint64_t> &columns = bandColumns[0];
+    for (size_t band = 0; band < bandStats.size(); band++) {
+        const GenerationStats &counts = bandStats[band];
+        stats.population += counts.population;
+        stats.births += counts.births;
+        stats.deaths += counts.deaths;
+        if (counts.top < 0) {
+            continue;
+        }
+        if (stats.top < 0) {
+            stats.top = counts.top;
+        }
+        stats.bottom = counts.bottom; //the bands are in order
+        for (int w = 0; band > 0 && w < words; w++) {
+            columns[w] |= bandColumns[band][w];
+        }
+    }
+    if (stats.top >= 0) {
+        int left = 0;
+        while (columns[left] == 0) {
+            left++;
+        }
+        int right = words - 1;
+        while (columns[right] == 0) {
+            right--;
+        }
+        stats.left = left * WORD_BITS + __builtin_ctzll(columns[left]);
+        stats.right = right * WORD_BITS + WORD_BITS - 1 - __builtin_clzll(columns[right]);
+    }
+}
+
+/**
+ * @brief BitGrid::countTile Counts a tile just advanced into the scratch plane: its living
+ * cells, the cells that came alive or died and its bounding box. Only the tiles that are
+ * recomputed are counted, so the counting follows the activity of the colony like the step.
+ * @param tile The index of the tile.
+ * @param firstRow, lastRow The rows of the tile, [firstRow, lastRow).
+ * @param firstWord, count The words of the tile in every row, counting the west ghost word.
+ */
+void BitGrid::countTile(int tile, int firstRow, int lastRow, int firstWord, int count) {
+    TileStats counts = {0, 0, 0, -1, -1, -1, -1};
+    uint64_t columns[TILE_WORDS] = {0};
+    for (int r = firstRow; r < lastRow; r++) {
+        const uint64_t* previous = rowPointer(cells, r);
+        const uint64_t* current = rowPointer(next, r);
+        uint64_t any = 0;
+        for (int w = firstWord; w < firstWord + count; w++) {
+            uint64_t changed = current[w] ^ ((w == words) ? previous[w] & lastWordMask : previous[w]);
+            any |= current[w];
+            columns[w - firstWord] |= current[w];
+            counts.population += __builtin_popcountll(current[w]);
+            int born = __builtin_popcountll(changed & current[w]);
+            counts.births += born;
+            counts.deaths += __builtin_popcountll(changed) - born;
+        }
+        if (any != 0) {
+            if (counts.top < 0) {
+                counts.top = r;
+            }
+            counts.bottom = r;
+        }
+    }
+    if (counts.top >= 0) {
+        int left = 0;
+        while (columns[left] == 0) {
+            left++;
+        }
+        int right = count - 1;
+        while (columns[right] == 0) {
+            right--;
+        }
+        counts.left = (firstWord - 1 + left) * WORD_BITS + __builtin_ctzll(columns[left]);
+        counts.right = (firstWord - 1 + right) * WORD_BITS + WORD_BITS - 1 - __builtin_clzll(columns[right]);
+    }
+    tileStats[tile] = counts;
+}
+
+/**
+ * @brief BitGrid::collectTileStats Updates the running totals of the living cells of the board,
+ * of every row and of every column of tiles with the tiles recomputed by the last tracked
+ * generation, the only ones whose cells may have changed. The totals are rebuilt when every
+ * tile was recomputed, e.g. after the board was edited. The bounding box comes from the first
+ * and last rows and columns of tiles with a living cell, so the work is proportional to the
+ * recomputed tiles plus the number of tiles on a side, never to the area of the board.
+ */
+void BitGrid::collectTileStats() {
+    stats.births = stats.deaths = 0;
+    bool rebuilt = dirtyTiles.size() == (size_t) getTileCount(); //every tile was counted again
+    if (rebuilt) {
+        tileRowPopulation.assign(tileRows, 0);
+        tileColPopulation.assign(tileCols, 0);
+        trackedPopulation = 0;
+    }
+    for (int tile : dirtyTiles) {
+        const TileStats &counts = tileStats[tile];
+        long long change = rebuilt ? counts.population : counts.births - counts.deaths;
+        tileRowPopulation[tile / tileCols] += change;
+        tileColPopulation[tile % tileCols] += change;
+        trackedPopulation += change;
+        stats.births += counts.births;
+        stats.deaths += counts.deaths;
+    }
+    stats.population = trackedPopulation;
+    stats.top = stats.left = stats.bottom = stats.right = -1;
+    if (trackedPopulation == 0) {
+        return;
+    }
+    int firstRow = 0;
+    while (tileRowPopulation[firstRow] == 0) {
+        firstRow++;
+    }
+    int lastRow = tileRows - 1;
+    while (tileRowPopulation[lastRow] == 0) {
+        lastRow--;
+    }
+    int firstCol = 0;
+    while (tileColPopulation[firstCol] == 0) {
+        firstCol++;
+    }
+    int lastCol = tileCols - 1;
+    while (tileColPopulation[lastCol] == 0) {
+        lastCol--;
+    }
+    for (int c = 0; c < tileCols; c++) {
+        const TileStats &top = tileStats[firstRow * tileCols + c];
+        const TileStats &bottom = tileStats[lastRow * tileCols + c];
+        if (top.top >= 0 && (stats.top < 0 || top.top < stats.top)) {
+            stats.top = top.top;
+        }
+        stats.bottom = max(stats.bottom, bottom.bottom);
+    }
+    for (int r = 0; r < tileRows; r++) {
+        const TileStats &left = tileStats[r * tileCols + firstCol];
+        const TileStats &right = tileStats[r * tileCols + lastCol];
+        if (left.left >= 0 && (stats.left < 0 || left.left < stats.left)) {
+            stats.left = left.left;
+        }
+        stats.right = max(stats.right, right.right);
+    }
+}
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * BitGrid class, a bit-packed Game of Life board.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "bandworkers.h"
+#include "lifekernel.h"
+#include "lifestats.h"
+#include "lifetable.h"
+using namespace std;
+
+enum Boundary { //what lies beyond the edges of the board
+    DEAD_BOUNDARY, //dead cells
+    TOROIDAL_BOUNDARY, //the opposite edge, the board wraps around itself
+    REFLECTIVE_BOUNDARY //a mirror image of the board, every edge cell is its own neighbour
+};
+
+class BitGrid {
+public:
+    BitGrid(); //constructor
+    BitGrid(int numRows, int numCols); //constructor with dimensions, all cells dead
+    ~BitGrid(); //destructor
+
+    void resize(int numRows, int numCols); //resizes the board and kills every cell
+    void clear(); //kills every cell, keeping the dimensions and the memory of the board
+    int numRows() const; //accessor method for the number of rows
+    int numCols() const; //accessor method for the number of columns
+    bool inBounds(int row, int col) const; //checks whether or not a location is on the board
+    bool get(int row, int col) const; //returns true if the cell is alive
+    void set(int row, int col, bool alive); //makes the cell alive or dead
+    void setRun(int row, int col, int length); //makes a run of cells of a row alive
+    int findCell(int row, int col, bool alive) const; //first column from col with that state
+    int findChange(const BitGrid &other, int row, int col) const; //first column from col that differs
+    int rowWordCount() const; //number of 64 bit words holding a row, column c is bit c % 64 of word c / 64
+    const uint64_t* rowWords(int row) const; //the words of a row, the bits beyond the last column are 0
+    void setRowWords(int row, const uint64_t* source); //replaces a row with rowWordCount() words
+    void advance(Boundary boundary); //advances the board to the next generation
+    void advance(bool wrapping); //toroidal if wrapping, else dead boundary
+    void setRule(RuleMask rule); //replaces the rule of the Game of Life (B3/S23)
+    RuleMask getRule() const; //accessor method for the rule
+    void setKernel(RowKernel kernel); //replaces the row kernel picked for the processor
+    RowKernel getKernel() const; //accessor method for the row kernel
+    void setLookupTable(bool enabled); //advances 2x2 squares with a lookup table instead
+    bool usesLookupTable() const; //checks whether or not the lookup table is used
+    void setThreadCount(int threadCount); //advances the board in that many horizontal bands
+    int getThreadCount() const; //accessor method for the number of threads
+    void setTracking(bool enabled); //only recomputes the tiles near the cells that changed
+    bool isTracking() const; //checks whether or not the tiles are tracked
+    int getTileCount() const; //returns the number of tiles of the board
+    int getTilesSkipped() const; //returns the number of tiles skipped by the last generation
+    long long getTotalTilesSkipped() const; //returns the number of tiles skipped so far
+    long long getTotalTiles() const; //returns the number of tiles of every tracked generation so far
+    string toString(int row) const; //returns a row in the "X"/"-" text format
+    uint64_t hash() const; //64 bit hash of the dimensions and the cells
+    void copyCells(const BitGrid &other); //copies the cells and the rule, keeps the threads and kernel
+#ifdef LIFE_STATS
+    const GenerationStats& getStats() const; //counters of the last generation
+#endif
+
+    BitGrid(const BitGrid &other); //copy constructor
+    BitGrid& operator= (const BitGrid &other); //assignment overload
+
+private:
+    uint64_t* cells; //current generation, including the ghost border
+    uint64_t* next; //scratch plane the next generation is written into
+    int rows;
+    int cols;
+    int words; //number of words holding the cells of a single row
+    int stride; //number of words per row, including the ghost words
+    uint64_t lastWordMask; //bits of the last word that belong to the board
+    RuleMask rule;
+    RowKernel kernel; //Game of Life kernel, its instruction set is used for every rule
+    RowKernel ruleKernel; //advances the words of a single row with the rule
+    bool lookupTable; //true if pairs of rows are advanced by the lookup table stepper
+    const uint8_t* lookup; //lookup table of the rule, nullptr until the stepper is chosen
+    BandWorkers* workers; //threads advancing the bands, nullptr when single threaded
+    bool tracking; //true if only the tiles near the changes are recomputed
+    bool trackingReset; //true if every tile must be recomputed by the next generation
+    Boundary trackedBoundary; //boundary of the last tracked generation
+    int tileRows; //number of tiles vertically
+    int tileCols; //number of tiles horizontally
+    vector<int> changedTiles; //tiles whose cells changed in the last generation
+    vector<int> dirtyTiles; //tiles to recompute in the current generation
+    vector<vector<int> > bandChanges; //tiles changed by every band of the current generation
+    vector<unsigned int> tileStamps; //marks the tiles already added to dirtyTiles
+    unsigned int stamp;
+    int tilesSkipped;
+    long long totalTilesSkipped;
+    long long totalTiles;
+#ifdef LIFE_STATS
+    struct TileStats { //counters of a tile in the last generation it was recomputed
+        int population;
+        int births;
+        int deaths;
+        int top; //bounding box of the living cells of the tile, all -1 if there are none
+        int left;
+        int bottom;
+        int right;
+    };
+
+    GenerationStats stats; //counters of the last generation
+    vector<GenerationStats> bandStats; //counters of the rows of every band
+    vector<vector<uint64_t> > bandColumns; //the columns with a living cell in the rows of every band
+    CountKernel countKernel; //counts the cells of a row, same instruction set as the row kernel
+    vector<TileStats> tileStats; //counters of every tile, kept up to date while tracking
+    vector<long long> tileRowPopulation; //living cells of every row of tiles
+    vector<long long> tileColPopulation; //living cells of every column of tiles
+    long long trackedPopulation;
+#endif
+
+    uint64_t* rowPointer(uint64_t* plane, int row) const; //row -1 and row "rows" are the ghost rows
+    const uint64_t* rowPointer(const uint64_t* plane, int row) const;
+    void allocate(int numRows, int numCols);
+    void resetTiles(); //forgets the tracked tiles and the counters of the board
+    void updateStepper(); //picks the kernel and the lookup table of the rule
+    template <typename Policy> void refreshGhosts(); //fills the ghost cells as the policy says
+    void advanceRows(int first, int last, int band); //advances the rows in [first, last)
+    void advanceTracked(Boundary boundary);
+    void findDirtyTiles(Boundary boundary);
+    bool advanceTile(int tile); //returns true if a cell of the tile changed
+#ifdef LIFE_STATS
+    void resetBandStats(); //clears the counters of the bands before a generation
+    void countRows(int first, int last, int band); //adds the rows just advanced to the band
+    void collectStats(); //merges the counters of the bands
+    void countTile(int tile, int firstRow, int lastRow, int firstWord, int count); //a tile just advanced
+    void collectTileStats(); //updates the running totals with the recomputed tiles
+#endif
+};
+
+uint64_t hashSeed(int rows, int cols); //BitGrid::hash of a board before its first row
+uint64_t hashWords(uint64_t hash, const uint64_t* words, int count); //adds words as BitGrid::hash does
@@ -0,0 +1,454 @@
+/**
+ * @brief The following code involves the functions neccessary to save and restore binary
+ * checkpoints of a Game of Life board. The words of the board are written as they are stored,
+ * so saving costs about as much as copying the board, and a checkpoint is written to a temporary
+ * file that replaces the previous checkpoint only once it is complete, so a crash while writing
+ * never destroys the last good checkpoint. The loader maps the file into memory (see
+ * mappedfile.h) and copies the words straight into the rows of the board, once the header and
+ * the dimensions are checked against the version, the byte order and the size of the cells.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "checkpoint.h"
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "mappedfile.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+//constant decleration(s)
+const string CHECKPOINT_EXTENSION = ".ckpt";
+const char CHECKPOINT_MAGIC[8] = {'L', 'I', 'F', 'E', 'C', 'K', 'P', '1'};
+const uint16_t CHECKPOINT_VERSION = 2; //changes with the layout, the first one had no version
+const uint16_t CHECKPOINT_BYTE_ORDER = 0x0102; //reads 0x0201 on a machine of the other byte order
+const uint32_t PACKED_ENCODING = 0; //every word of every row, in order
+const uint32_t SPARSE_ENCODING = 1; //runs of empty words and runs of words written as they are
+
+/**
+ * The header at the start of a checkpoint, in the byte order of the machine that wrote it. The
+ * cells follow it, at an offset that keeps the words aligned.
+ */
+struct CheckpointHeader {
+    char magic[8]; //CHECKPOINT_MAGIC
+    uint16_t version; //CHECKPOINT_VERSION
+    uint16_t byteOrder; //CHECKPOINT_BYTE_ORDER, in the byte order of the machine that wrote it
+    uint32_t rule;
+    uint32_t encoding; //PACKED_ENCODING or SPARSE_ENCODING
+    uint32_t reserved; //0, keeps the words aligned
+    int64_t generation;
+    int32_t rows;
+    int32_t cols;
+    uint64_t payloadWords; //number of words following the header
+    uint64_t hash; //BitGrid::hash of the board, checked by the loader
+};
+
+/**
+ * @brief sparseSize Returns the number of words the sparse encoding of a board takes: every run
+ * of non-empty words costs two words (the length of the empty run before it and its own length)
+ * besides its words, the empty words cost nothing but the two words of the last run, which has
+ * no non-empty words, when the board ends with them.
+ * @param grid The board.
+ * @return The number of words.
+ */
+static uint64_t sparseSize(const BitGrid &grid) {
+    uint64_t size = 0;
+    bool inLiterals = false;
+    bool trailing = false; //empty words after the last run
+    for (int r = 0; r < grid.numRows(); r++) {
+        const uint64_t* p = grid.rowWords(r);
+        for (int w = 0; w < grid.rowWordCount(); w++) {
+            if (p[w] != 0) {
+                size += inLiterals ? 1 : 3;
+                inLiterals = true;
+                trailing = false;
+            } else {
+                inLiterals = false;
+                trailing = true;
+            }
+        }
+    }
+    return trailing ? size + 2 : size;
+}
+
+/**
+ * @brief writeWords Writes words to a file.
+ * @param file The file.
+ * @param words The first word.
+ * @param count The number of words.
+ */
+static void writeWords(FILE* file, const uint64_t* words, size_t count) {
+    if (count > 0 && fwrite(words, sizeof(uint64_t), count, file) != count) {
+        throw("Unable to write the checkpoint file.");
+    }
+}
+
+/**
+ * @brief writeSparse Writes the words of a board as pairs of run lengths (empty words, then
+ * non-empty words) each followed by the non-empty words themselves. The runs go on across the
+ * ends of the rows and cover every word of the board, the trailing empty words being a last run
+ * without non-empty words.
+ * @param file The file.
+ * @param grid The board.
+ */
+static void writeSparse(FILE* file, const BitGrid &grid) {
+    vector<uint64_t> literals;
+    uint64_t zeros = 0;
+    for (int r = 0; r < grid.numRows(); r++) {
+        const uint64_t* p = grid.rowWords(r);
+        for (int w = 0; w < grid.rowWordCount(); w++) {
+            if (p[w] == 0) {
+                if (!literals.empty()) {
+                    uint64_t run[2] = {zeros, literals.size()};
+                    writeWords(file, run, 2);
+                    writeWords(file, literals.data(), literals.size());
+                    literals.clear();
+                    zeros = 0;
+                }
+                zeros++;
+            } else {
+                literals.push_back(p[w]);
+            }
+        }
+    }
+    if (!literals.empty() || zeros > 0) {
+        uint64_t run[2] = {zeros, literals.size()};
+        writeWords(file, run, 2);
+        writeWords(file, literals.data(), literals.size());
+    }
+}
+
+/**
+ * @brief checkSparse Checks that the runs of a sparse encoding fit in its words and cover
+ * exactly the words of the board, before the board is allocated.
+ * @param payload The first word of the encoding.
+ * @param end The end of the encoding.
+ * @param boardWords The number of words of the board.
+ */
+static void checkSparse(const uint64_t* payload, const uint64_t* end, uint64_t boardWords) {
+    uint64_t covered = 0;
+    for (const uint64_t* p = payload; p < end; ) {
+        if (end - p < 2) {
+            throw("The checkpoint file is corrupted.");
+        }
+        uint64_t zeros = p[0];
+        uint64_t literals = p[1];
+        p += 2;
+        if (literals > (uint64_t) (end - p) || zeros > boardWords - covered
+            || literals > boardWords - covered - zeros) {
+            throw("The checkpoint file is corrupted.");
+        }
+        covered += zeros + literals;
+        p += literals;
+    }
+    if (covered != boardWords) {
+        throw("The checkpoint file is corrupted.");
+    }
+}
+
+/**
+ * @brief checkHeader Checks that a header was written by this version of the program on a
+ * machine of the same byte order, and that its dimensions and encoding are valid.
+ * @param header The header.
+ */
+static void checkHeader(const CheckpointHeader &header) {
+    if (memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0) {
+        throw("The file is not a checkpoint.");
+    }
+    if (header.byteOrder == (uint16_t) (CHECKPOINT_BYTE_ORDER >> 8 | CHECKPOINT_BYTE_ORDER << 8)) {
+        throw("The checkpoint file was written on a machine of another byte order.");
+    }
+    if (header.byteOrder != CHECKPOINT_BYTE_ORDER || header.version != CHECKPOINT_VERSION) {
+        throw("The checkpoint file was written by another version of the program.");
+    }
+    if (header.rows < 0 || header.cols < 0
+        || (header.encoding != PACKED_ENCODING && header.encoding != SPARSE_ENCODING)) {
+        throw("Invalid header in the checkpoint file.");
+    }
+}
+
+/**
+ * @brief replaceFile Makes a complete temporary file the checkpoint, replacing the previous
+ * checkpoint at once.
+ * @param temporary The name of the temporary file, already flushed to the disk.
+ * @param fileName The name of the checkpoint.
+ */
+static void replaceFile(const string &temporary, const string &fileName) {
+#ifdef _WIN32
+    remove(fileName.c_str()); //rename does not replace an existing file there
+#endif
+    if (rename(temporary.c_str(), fileName.c_str()) != 0) {
+        throw("Unable to replace the checkpoint file.");
+    }
+}
+
+/**
+ * @brief isCheckpointFile Checks whether or not a file holds a checkpoint, judging by its
+ * extension.
+ * @param fileName The name of the file.
+ * @return True if the name ends with ".ckpt", in any case.
+ */
+bool isCheckpointFile(const string &fileName) {
+    if (fileName.size() < CHECKPOINT_EXTENSION.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < CHECKPOINT_EXTENSION.size(); i++) {
+        if (tolower(fileName[fileName.size() - CHECKPOINT_EXTENSION.size() + i]) != CHECKPOINT_EXTENSION[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief saveCheckpoint Writes a board and its generation as a checkpoint. The checkpoint is
+ * written to "fileName.tmp", flushed to the disk and then renamed, so the file either holds the
+ * previous checkpoint or the new one, never a part of it. The sparse encoding is chosen when the
+ * board is mostly empty, unless the rows must stay at their offsets (see packedRowOffset).
+ * @param fileName The name of the checkpoint.
+ * @param grid The board to save, with its rule.
+ * @param generation The generation of the board.
+ * @param allowSparse False to store every word of every row.
+ */
+void saveCheckpoint(const string &fileName, const BitGrid &grid, long long generation,
+                    bool allowSparse) {
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.byteOrder = CHECKPOINT_BYTE_ORDER;
+    header.rule = grid.getRule();
+    header.generation = generation;
+    header.rows = grid.numRows();
+    header.cols = grid.numCols();
+    header.hash = grid.hash();
+    uint64_t packed = (uint64_t) grid.numRows() * grid.rowWordCount();
+    uint64_t sparse = allowSparse ? sparseSize(grid) : packed;
+    header.encoding = (sparse < packed) ? SPARSE_ENCODING : PACKED_ENCODING;
+    header.payloadWords = (sparse < packed) ? sparse : packed;
+    string temporary = fileName + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        throw("Unable to write the checkpoint file.");
+    }
+    try {
+        if (fwrite(&header, sizeof(header), 1, file) != 1) {
+            throw("Unable to write the checkpoint file.");
+        }
+        if (header.encoding == SPARSE_ENCODING) {
+            writeSparse(file, grid);
+        } else {
+            for (int r = 0; r < grid.numRows(); r++) {
+                writeWords(file, grid.rowWords(r), grid.rowWordCount());
+            }
+        }
+        if (fflush(file) != 0) {
+            throw("Unable to write the checkpoint file.");
+        }
+#ifndef _WIN32
+        if (fsync(fileno(file)) != 0) { //the data must be on the disk before the rename is
+            throw("Unable to write the checkpoint file.");
+        }
+#endif
+    } catch (...) {
+        fclose(file);
+        remove(temporary.c_str());
+        throw;
+    }
+    if (fclose(file) != 0) {
+        remove(temporary.c_str());
+        throw("Unable to write the checkpoint file.");
+    }
+    replaceFile(temporary, fileName);
+}
+
+/**
+ * @brief loadCheckpoint Restores a board from a checkpoint. The file is mapped into memory and
+ * its words are copied into the rows of the board, then the hash of the board is compared with
+ * the one in the header.
+ * @param fileName The name of the checkpoint.
+ * @param grid The board to fill, it takes the dimensions and the rule of the checkpoint.
+ * @return The generation of the board.
+ */
+long long loadCheckpoint(const string &fileName, BitGrid &grid) {
+    MappedFile file;
+    openMappedFile(fileName, file);
+    long long generation;
+    try {
+        CheckpointHeader header;
+        if (file.size < sizeof(header)) {
+            throw("The checkpoint file is truncated.");
+        }
+        memcpy(&header, file.data, sizeof(header));
+        checkHeader(header);
+        if (header.payloadWords > (file.size - sizeof(header)) / sizeof(uint64_t)) {
+            throw("The checkpoint file is truncated.");
+        }
+        //the header is a multiple of 8 bytes long and the mapping starts on a page, so the
+        //words are aligned
+        const uint64_t* payload = (const uint64_t*) (file.data + sizeof(header));
+        const uint64_t* end = payload + header.payloadWords;
+        //the dimensions are checked against the payload before the board is allocated
+        uint64_t boardWords = (uint64_t) header.rows * (((uint64_t) header.cols + 63) / 64);
+        if (header.encoding == PACKED_ENCODING) {
+            if (header.payloadWords != boardWords) {
+                throw("Invalid header in the checkpoint file.");
+            }
+        } else {
+            checkSparse(payload, end, boardWords);
+        }
+        grid.resize(header.rows, header.cols);
+        grid.setRule(header.rule);
+        int words = grid.rowWordCount();
+        if (header.encoding == PACKED_ENCODING) {
+            for (int r = 0; r < header.rows; r++) {
+                grid.setRowWords(r, payload + (size_t) r * words);
+            }
+        } else {
+            vector<uint64_t> row(words);
+            const uint64_t* p = payload;
+            uint64_t zeros = 0;
+            uint64_t literals = 0;
+            for (int r = 0; r < header.rows; r++) {
+                for (int w = 0; w < words; w++) {
+                    while (zeros == 0 && literals == 0) { //the runs are checked by checkSparse
+                        zeros = p[0];
+                        literals = p[1];
+                        p += 2;
+                    }
+                    if (zeros > 0) {
+                        row[w] = 0;
+                        zeros--;
+                    } else {
+                        row[w] = *p++;
+                        literals--;
+                    }
+                }
+                grid.setRowWords(r, row.data());
+            }
+        }
+        if (grid.hash() != header.hash) {
+            throw("The checkpoint file is corrupted.");
+        }
+        generation = header.generation;
+    } catch (...) {
+        closeMappedFile(file);
+        throw;
+    }
+    closeMappedFile(file);
+    return generation;
+}
+
+/**
+ * @brief readCheckpointInfo Reads the header of a checkpoint without its cells, so that the
+ * rows of a packed checkpoint can then be read by whoever needs them.
+ * @param fileName The name of the checkpoint.
+ * @return The header.
+ */
+CheckpointInfo readCheckpointInfo(const string &fileName) {
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (file == nullptr) {
+        throw("Unable to open the file.");
+    }
+    CheckpointHeader header;
+    bool complete = fread(&header, sizeof(header), 1, file) == 1;
+    bool sized = complete && fseek(file, 0, SEEK_END) == 0;
+    long long size = sized ? (long long) ftell(file) : 0;
+    fclose(file);
+    if (!complete) {
+        throw("The checkpoint file is truncated.");
+    }
+    checkHeader(header);
+    if (header.encoding == PACKED_ENCODING
+        && header.payloadWords != (uint64_t) header.rows * (((uint64_t) header.cols + 63) / 64)) {
+        throw("Invalid header in the checkpoint file.");
+    }
+    CheckpointInfo info;
+    info.rule = header.rule;
+    info.generation = header.generation;
+    info.rows = header.rows;
+    info.cols = header.cols;
+    info.packed = header.encoding == PACKED_ENCODING;
+    info.hash = header.hash;
+    if (info.packed && size < packedRowOffset(info.rows, info.cols)) {
+        throw("The checkpoint file is truncated.");
+    }
+    return info;
+}
+
+/**
+ * @brief packedRowOffset Returns where a row starts in a packed checkpoint.
+ * @param row The row, the number of rows for the end of the cells.
+ * @param cols The number of columns of the board.
+ * @return The offset from the start of the file, in bytes.
+ */
+long long packedRowOffset(int row, int cols) {
+    long long words = ((long long) cols + 63) / 64;
+    return (long long) sizeof(CheckpointHeader) + row * words * (long long) sizeof(uint64_t);
+}
+
+/**
+ * @brief beginPackedCheckpoint Creates the temporary file of a packed checkpoint, with its
+ * header and room for every row, so the rows can be written at their offsets by different
+ * processes. The hash is left out until endPackedCheckpoint.
+ * @param fileName The name of the checkpoint.
+ * @param info The generation, the rule and the dimensions of the board.
+ */
+void beginPackedCheckpoint(const string &fileName, const CheckpointInfo &info) {
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.byteOrder = CHECKPOINT_BYTE_ORDER;
+    header.rule = info.rule;
+    header.encoding = PACKED_ENCODING;
+    header.generation = info.generation;
+    header.rows = info.rows;
+    header.cols = info.cols;
+    header.payloadWords = (uint64_t) info.rows * (((uint64_t) info.cols + 63) / 64);
+    string temporary = fileName + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        throw("Unable to write the checkpoint file.");
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (written && header.payloadWords > 0) {
+        //the last byte gives the file its size, the rows before it are written later
+        written = fseek(file, packedRowOffset(info.rows, info.cols) - 1, SEEK_SET) == 0
+                  && fputc(0, file) != EOF;
+    }
+    if (fclose(file) != 0 || !written) {
+        remove(temporary.c_str());
+        throw("Unable to write the checkpoint file.");
+    }
+}
+
+/**
+ * @brief endPackedCheckpoint Completes a checkpoint begun by beginPackedCheckpoint once all of
+ * its rows are written: stores the hash, flushes the file to the disk and replaces the previous
+ * checkpoint with it.
+ * @param fileName The name of the checkpoint.
+ * @param hash BitGrid::hash of the board.
+ */
+void endPackedCheckpoint(const string &fileName, uint64_t hash) {
+    string temporary = fileName + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "r+b");
+    if (file == nullptr) {
+        throw("Unable to write the checkpoint file.");
+    }
+    bool written = fseek(file, offsetof(CheckpointHeader, hash), SEEK_SET) == 0
+                   && fwrite(&hash, sizeof(hash), 1, file) == 1 && fflush(file) == 0;
+#ifndef _WIN32
+    written = written && fsync(fileno(file)) == 0; //the rows written by others too
+#endif
+    if (fclose(file) != 0 || !written) {
+        remove(temporary.c_str());
+        throw("Unable to write the checkpoint file.");
+    }
+    replaceFile(temporary, fileName);
+}
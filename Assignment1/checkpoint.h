@@ -0,0 +1,38 @@
+/**
+ * @brief The header file declaring the functions that save and restore the state of a long Game
+ * of Life run in a compact binary checkpoint: a fixed size header holding the version of the
+ * format, the byte order, the generation, the rule and the dimensions, followed by the
+ * bit-packed cells, either word for word or with the runs of empty words left out, whichever is
+ * smaller.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "bitgrid.h"
+using namespace std;
+
+/**
+ * The header of a checkpoint, without its cells.
+ */
+struct CheckpointInfo {
+    RuleMask rule;
+    long long generation;
+    int rows;
+    int cols;
+    bool packed; //the cells are stored word for word, the rows can be read at their offsets
+    uint64_t hash; //BitGrid::hash of the board
+};
+
+bool isCheckpointFile(const string &fileName); //checks the extension of the file name
+void saveCheckpoint(const string &fileName, const BitGrid &grid, long long generation,
+                    bool allowSparse = true); //atomic
+long long loadCheckpoint(const string &fileName, BitGrid &grid); //returns the generation
+CheckpointInfo readCheckpointInfo(const string &fileName); //reads only the header
+long long packedRowOffset(int row, int cols); //byte offset of a row of a packed checkpoint
+void beginPackedCheckpoint(const string &fileName, const CheckpointInfo &info); //rows written later
+void endPackedCheckpoint(const string &fileName, uint64_t hash); //atomic, like saveCheckpoint
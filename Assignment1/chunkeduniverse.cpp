@@ -0,0 +1,461 @@
+/**
+ * @brief The following code involves the methods neccessary to run the Game of Life (or another
+ * Life-like rule) on an unbounded plane. The plane is a hash map of 64x64 chunks, one 64 bit word per row, which are
+ * allocated when the activity reaches the border of a chunk and freed when they become empty, so
+ * that the memory follows the living area rather than its bounding box.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "chunkeduniverse.h"
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include "lifekernelimpl.h"
+
+//constant decleration(s)
+static const uint64_t EMPTY_ROWS[CHUNK_SIZE] = {}; //stands for the chunks that are not allocated
+
+/**
+ * @brief floorDivide Divides a coordinate by the chunk size, rounding towards negative infinity.
+ * @param coordinate The row or column of a cell.
+ * @return The row or column of the chunk containing the cell.
+ */
+static long long floorDivide(long long coordinate) {
+    return (coordinate >= 0) ? coordinate / CHUNK_SIZE : -((-coordinate - 1) / CHUNK_SIZE) - 1;
+}
+
+/**
+ * @brief ChunkedUniverse::ChunkedUniverse The constructor of the ChunkedUniverse class. Creates
+ * an empty plane.
+ */
+ChunkedUniverse::ChunkedUniverse() {
+    rule = CONWAY_RULE;
+    parity = 0;
+    generation = 0;
+}
+
+/**
+ * @brief ChunkedUniverse::~ChunkedUniverse Destructor of the ChunkedUniverse class. Deletes every
+ * chunk.
+ */
+ChunkedUniverse::~ChunkedUniverse() {
+    clear();
+}
+
+/**
+ * @brief ChunkedUniverse::load Replaces the plane with the cells of a grid. The cell in row r and
+ * column c of the grid is placed at the same coordinates of the plane, and the plane takes the
+ * rule of the grid.
+ * @param grid The grid to load.
+ */
+void ChunkedUniverse::load(const BitGrid &grid) {
+    setRule(grid.getRule());
+    clear();
+    for (int r = 0; r < grid.numRows(); r++) {
+        for (int c = 0; c < grid.numCols(); c++) {
+            if (grid.get(r, c)) {
+                set(r, c, true);
+            }
+        }
+    }
+}
+
+/**
+ * @brief ChunkedUniverse::store Copies a window of the plane into a grid of the same size.
+ * @param grid The grid to fill, its dimensions are the dimensions of the window.
+ * @param top The row of the plane shown in the first row of the grid.
+ * @param left The column of the plane shown in the first column of the grid.
+ */
+void ChunkedUniverse::store(BitGrid &grid, long long top, long long left) const {
+    grid.clear();
+    for (const auto &entry : chunks) {
+        long long chunkTop = keyRow(entry.first) * CHUNK_SIZE;
+        long long chunkLeft = keyCol(entry.first) * CHUNK_SIZE;
+        const uint64_t* cells = entry.second->planes[parity];
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            long long row = chunkTop + r - top;
+            if (cells[r] == 0 || row < 0 || row >= grid.numRows()) {
+                continue;
+            }
+            for (int c = 0; c < CHUNK_SIZE; c++) {
+                long long col = chunkLeft + c - left;
+                if (((cells[r] >> c) & 1) && col >= 0 && col < grid.numCols()) {
+                    grid.set(row, col, true);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief ChunkedUniverse::get Returns the state of a cell of the plane.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @return True if the cell is alive, false otherwise.
+ */
+bool ChunkedUniverse::get(long long row, long long col) const {
+    long long chunkRow = floorDivide(row);
+    long long chunkCol = floorDivide(col);
+    Chunk* chunk = find(chunkRow, chunkCol);
+    if (chunk == nullptr) {
+        return false;
+    }
+    return (chunk->planes[parity][row - chunkRow * CHUNK_SIZE] >> (col - chunkCol * CHUNK_SIZE)) & 1;
+}
+
+/**
+ * @brief ChunkedUniverse::set Makes a cell of the plane alive or dead, allocating its chunk if
+ * necessary.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @param alive The new state of the cell.
+ */
+void ChunkedUniverse::set(long long row, long long col, bool alive) {
+    long long chunkRow = floorDivide(row);
+    long long chunkCol = floorDivide(col);
+    Chunk* chunk = alive ? findOrCreate(chunkRow, chunkCol) : find(chunkRow, chunkCol);
+    if (chunk == nullptr) {
+        return;
+    }
+    uint64_t bit = (uint64_t) 1 << (col - chunkCol * CHUNK_SIZE);
+    uint64_t &word = chunk->planes[parity][row - chunkRow * CHUNK_SIZE];
+    word = alive ? (word | bit) : (word & ~bit);
+}
+
+/**
+ * @brief ChunkedUniverse::advance Advances the plane to the next generation. First the empty
+ * chunks next to living border cells are allocated, then every chunk is advanced into its other
+ * plane, and finally the chunks that became empty are freed.
+ */
+void ChunkedUniverse::advance() {
+    vector<uint64_t> keys;
+    for (const auto &entry : chunks) {
+        keys.push_back(entry.first);
+    }
+    for (uint64_t chunkKey : keys) {
+        allocateNeighbours(chunkKey);
+    }
+    for (const auto &entry : chunks) {
+        advanceChunk(entry.first, entry.second);
+    }
+    parity = 1 - parity;
+    for (auto it = chunks.begin(); it != chunks.end(); ) {
+        if (isEmpty(it->second->planes[parity])) {
+            delete it->second;
+            it = chunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    generation++;
+}
+
+/**
+ * @brief ChunkedUniverse::setRule Replaces the rule the plane is advanced with.
+ * @param rule The rule, which may not contain B0.
+ */
+void ChunkedUniverse::setRule(RuleMask rule) {
+    if (ruleBirthsFromNothing(rule)) {
+        throw("Rules with B0 can not be used on an unbounded plane.");
+    }
+    this->rule = rule;
+}
+
+/**
+ * @brief ChunkedUniverse::getRule Returns the rule the plane is advanced with.
+ * @return The rule.
+ */
+RuleMask ChunkedUniverse::getRule() const {
+    return rule;
+}
+
+/**
+ * @brief ChunkedUniverse::clear Deletes every chunk, which kills every cell.
+ */
+void ChunkedUniverse::clear() {
+    for (const auto &entry : chunks) {
+        delete entry.second;
+    }
+    chunks.clear();
+    generation = 0;
+}
+
+/**
+ * @brief ChunkedUniverse::getPopulation Returns the number of living cells of the plane.
+ * @return The population.
+ */
+long long ChunkedUniverse::getPopulation() const {
+    long long population = 0;
+    for (const auto &entry : chunks) {
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            population += bitset<64>(entry.second->planes[parity][r]).count();
+        }
+    }
+    return population;
+}
+
+/**
+ * @brief ChunkedUniverse::hash Returns a 64 bit hash of the plane, which changes with every cell.
+ * The chunks are hashed on their own and summed, so the order of the hash map does not matter,
+ * and the empty chunks are left out, so the allocated chunks do not matter either.
+ * @return The hash of the plane.
+ */
+uint64_t ChunkedUniverse::hash() const {
+    uint64_t result = 0;
+    for (const auto &entry : chunks) {
+        const uint64_t* cells = entry.second->planes[parity];
+        if (isEmpty(cells)) {
+            continue;
+        }
+        uint64_t chunkHash = entry.first;
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            uint64_t mixed = (chunkHash ^ cells[r]) + 0x9e3779b97f4a7c15ULL;
+            mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+            chunkHash = mixed ^ (mixed >> 31);
+        }
+        result += chunkHash;
+    }
+    return result;
+}
+
+/**
+ * @brief ChunkedUniverse::getGeneration Returns the number of generations advanced since the
+ * plane was loaded or cleared.
+ * @return The generation number.
+ */
+long long ChunkedUniverse::getGeneration() const {
+    return generation;
+}
+
+/**
+ * @brief ChunkedUniverse::getChunkCount Returns the number of allocated chunks.
+ * @return The number of chunks.
+ */
+int ChunkedUniverse::getChunkCount() const {
+    return chunks.size();
+}
+
+/**
+ * @brief ChunkedUniverse::getBounds Computes the bounding box of the living cells.
+ * @param top, left Set to the first row and column containing a living cell.
+ * @param bottom, right Set to the last row and column containing a living cell.
+ * @return False if there are no living cells, in which case the bounds are not changed.
+ */
+bool ChunkedUniverse::getBounds(long long &top, long long &left, long long &bottom, long long &right) const {
+    bool found = false;
+    for (const auto &entry : chunks) {
+        const uint64_t* cells = entry.second->planes[parity];
+        int firstRow = CHUNK_SIZE;
+        int lastRow = -1;
+        uint64_t columns = 0;
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            if (cells[r] != 0) {
+                firstRow = min(firstRow, r);
+                lastRow = r;
+                columns |= cells[r];
+            }
+        }
+        if (columns == 0) {
+            continue;
+        }
+        int firstCol = 0;
+        int lastCol = CHUNK_SIZE - 1;
+        while (((columns >> firstCol) & 1) == 0) {
+            firstCol++;
+        }
+        while (((columns >> lastCol) & 1) == 0) {
+            lastCol--;
+        }
+        long long chunkTop = keyRow(entry.first) * CHUNK_SIZE;
+        long long chunkLeft = keyCol(entry.first) * CHUNK_SIZE;
+        if (!found) {
+            top = chunkTop + firstRow;
+            bottom = chunkTop + lastRow;
+            left = chunkLeft + firstCol;
+            right = chunkLeft + lastCol;
+            found = true;
+        } else {
+            top = min(top, chunkTop + firstRow);
+            bottom = max(bottom, chunkTop + lastRow);
+            left = min(left, chunkLeft + firstCol);
+            right = max(right, chunkLeft + lastCol);
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief ChunkedUniverse::getChunkCoordinates Returns the rows and columns (in chunks) of every
+ * allocated chunk.
+ * @return The coordinates of the chunks.
+ */
+vector<pair<long long, long long> > ChunkedUniverse::getChunkCoordinates() const {
+    vector<pair<long long, long long> > coordinates;
+    for (const auto &entry : chunks) {
+        coordinates.push_back(make_pair(keyRow(entry.first), keyCol(entry.first)));
+    }
+    return coordinates;
+}
+
+/**
+ * @brief ChunkedUniverse::getChunk Returns the 64 row words of a chunk, bit c of word r being the
+ * cell in row r and column c of the chunk.
+ * @param chunkRow The row of the chunk, the chunk starts at row chunkRow * CHUNK_SIZE.
+ * @param chunkCol The column of the chunk.
+ * @return The row words, or nullptr if the chunk is not allocated.
+ */
+const uint64_t* ChunkedUniverse::getChunk(long long chunkRow, long long chunkCol) const {
+    Chunk* chunk = find(chunkRow, chunkCol);
+    return (chunk == nullptr) ? nullptr : chunk->planes[parity];
+}
+
+/**
+ * @brief ChunkedUniverse::setChunk Replaces the cells of a chunk, allocating it if necessary and
+ * freeing it if the new cells are all dead.
+ * @param chunkRow The row of the chunk.
+ * @param chunkCol The column of the chunk.
+ * @param cells The 64 row words of the chunk.
+ */
+void ChunkedUniverse::setChunk(long long chunkRow, long long chunkCol, const uint64_t* cells) {
+    if (isEmpty(cells)) {
+        auto it = chunks.find(key(chunkRow, chunkCol));
+        if (it != chunks.end()) {
+            delete it->second;
+            chunks.erase(it);
+        }
+        return;
+    }
+    memcpy(findOrCreate(chunkRow, chunkCol)->planes[parity], cells, sizeof(uint64_t) * CHUNK_SIZE);
+}
+
+/**
+ * @brief ChunkedUniverse::key Packs the coordinates of a chunk into a hash map key.
+ * @param chunkRow The row of the chunk, between -2^31 and 2^31 - 1.
+ * @param chunkCol The column of the chunk, between -2^31 and 2^31 - 1.
+ * @return The key of the chunk.
+ */
+uint64_t ChunkedUniverse::key(long long chunkRow, long long chunkCol) {
+    return ((uint64_t) (uint32_t) chunkRow << 32) | (uint32_t) chunkCol;
+}
+
+long long ChunkedUniverse::keyRow(uint64_t key) {
+    return (int32_t) (uint32_t) (key >> 32);
+}
+
+long long ChunkedUniverse::keyCol(uint64_t key) {
+    return (int32_t) (uint32_t) key;
+}
+
+/**
+ * @brief ChunkedUniverse::find Returns the chunk at the given coordinates.
+ * @param chunkRow The row of the chunk.
+ * @param chunkCol The column of the chunk.
+ * @return The chunk, or nullptr if it is not allocated.
+ */
+ChunkedUniverse::Chunk* ChunkedUniverse::find(long long chunkRow, long long chunkCol) const {
+    auto it = chunks.find(key(chunkRow, chunkCol));
+    return (it == chunks.end()) ? nullptr : it->second;
+}
+
+/**
+ * @brief ChunkedUniverse::findOrCreate Returns the chunk at the given coordinates, allocating an
+ * empty one if it does not exist.
+ * @param chunkRow The row of the chunk.
+ * @param chunkCol The column of the chunk.
+ * @return The chunk.
+ */
+ChunkedUniverse::Chunk* ChunkedUniverse::findOrCreate(long long chunkRow, long long chunkCol) {
+    Chunk* &chunk = chunks[key(chunkRow, chunkCol)];
+    if (chunk == nullptr) {
+        chunk = new Chunk();
+    }
+    return chunk;
+}
+
+/**
+ * @brief ChunkedUniverse::allocateNeighbours Allocates the neighbouring chunks that can get a
+ * living cell in the next generation, which are the ones touching a living border cell.
+ * @param chunkKey The key of the chunk whose borders are checked.
+ */
+void ChunkedUniverse::allocateNeighbours(uint64_t chunkKey) {
+    const uint64_t* cells = chunks[chunkKey]->planes[parity];
+    uint64_t columns = 0;
+    for (int r = 0; r < CHUNK_SIZE; r++) {
+        columns |= cells[r];
+    }
+    long long chunkRow = keyRow(chunkKey);
+    long long chunkCol = keyCol(chunkKey);
+    uint64_t top = cells[0];
+    uint64_t bottom = cells[CHUNK_SIZE - 1];
+    //bit 0 is the west border and bit 63 is the east border of a row
+    bool borders[3][3] = {
+        {(top & 1) != 0, top != 0, (top >> 63) != 0},
+        {(columns & 1) != 0, false, (columns >> 63) != 0},
+        {(bottom & 1) != 0, bottom != 0, (bottom >> 63) != 0}
+    };
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            if (borders[i][j]) {
+                findOrCreate(chunkRow + i - 1, chunkCol + j - 1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief ChunkedUniverse::advanceChunk Writes the next generation of a chunk into its other plane,
+ * 64 cells at a time, taking the border rows and columns from the eight neighbouring chunks.
+ * @param chunkKey The key of the chunk.
+ * @param chunk The chunk.
+ */
+void ChunkedUniverse::advanceChunk(uint64_t chunkKey, Chunk* chunk) {
+    long long chunkRow = keyRow(chunkKey);
+    long long chunkCol = keyCol(chunkKey);
+    const uint64_t* around[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            Chunk* neighbour = find(chunkRow + i - 1, chunkCol + j - 1);
+            around[i][j] = (neighbour == nullptr) ? EMPTY_ROWS : neighbour->planes[parity];
+        }
+    }
+    uint64_t* result = chunk->planes[1 - parity];
+    for (int r = 0; r < CHUNK_SIZE; r++) {
+        //the rows above and below come from the neighbouring chunks at the top and bottom borders
+        int aboveChunk = (r == 0) ? 0 : 1;
+        int aboveRow = (r == 0) ? CHUNK_SIZE - 1 : r - 1;
+        int belowChunk = (r == CHUNK_SIZE - 1) ? 2 : 1;
+        int belowRow = (r == CHUNK_SIZE - 1) ? 0 : r + 1;
+        uint64_t above = around[aboveChunk][1][aboveRow];
+        uint64_t current = around[1][1][r];
+        uint64_t below = around[belowChunk][1][belowRow];
+        //the west and east chunks' words provide the bits shifted in at the borders
+        uint64_t nw = ScalarLanes::west(above, around[aboveChunk][0][aboveRow]);
+        uint64_t ne = ScalarLanes::east(above, around[aboveChunk][2][aboveRow]);
+        uint64_t w = ScalarLanes::west(current, around[1][0][r]);
+        uint64_t e = ScalarLanes::east(current, around[1][2][r]);
+        uint64_t sw = ScalarLanes::west(below, around[belowChunk][0][belowRow]);
+        uint64_t se = ScalarLanes::east(below, around[belowChunk][2][belowRow]);
+        if (rule == CONWAY_RULE) {
+            result[r] = lifeRule<uint64_t>(nw, above, ne, w, e, sw, below, se, current);
+        } else {
+            result[r] = anyRule<uint64_t>(nw, above, ne, w, e, sw, below, se, current, rule);
+        }
+    }
+}
+
+/**
+ * @brief ChunkedUniverse::isEmpty Checks whether or not all cells of a chunk are dead.
+ * @param cells The 64 row words of the chunk.
+ * @return True if the chunk is empty.
+ */
+bool ChunkedUniverse::isEmpty(const uint64_t* cells) {
+    for (int r = 0; r < CHUNK_SIZE; r++) {
+        if (cells[r] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * ChunkedUniverse class, an unbounded Game of Life plane made of 64x64 chunks. Any Life-like
+ * rule without B0 can be used, a B0 rule would bring the whole infinite plane to life.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bitgrid.h"
+using namespace std;
+
+//constant decleration(s)
+const int CHUNK_SIZE = 64; //a chunk is 64x64 cells, one 64 bit word per row
+
+class ChunkedUniverse {
+public:
+    ChunkedUniverse(); //constructor, creates an empty plane
+    ~ChunkedUniverse(); //destructor
+
+    void load(const BitGrid &grid); //replaces the plane with the cells and the rule of a grid
+    void store(BitGrid &grid, long long top, long long left) const; //copies a window into a grid
+    bool get(long long row, long long col) const; //returns true if the cell is alive
+    void set(long long row, long long col, bool alive); //makes the cell alive or dead
+    void setRule(RuleMask rule); //replaces the rule, B0 rules are refused
+    RuleMask getRule() const; //accessor method for the rule
+    void advance(); //advances the plane to the next generation
+    void clear(); //kills every cell
+    long long getPopulation() const; //number of living cells
+    long long getGeneration() const; //number of generations advanced since the last load
+    uint64_t hash() const; //64 bit hash of the living cells and their coordinates
+    int getChunkCount() const; //number of allocated chunks
+    bool getBounds(long long &top, long long &left, long long &bottom, long long &right) const;
+
+    vector<pair<long long, long long> > getChunkCoordinates() const; //chunk rows and columns
+    const uint64_t* getChunk(long long chunkRow, long long chunkCol) const; //nullptr if empty
+    void setChunk(long long chunkRow, long long chunkCol, const uint64_t* cells); //64 row words
+
+private:
+    struct Chunk {
+        uint64_t planes[2][CHUNK_SIZE]; //current and next generation, see parity
+    };
+
+    static uint64_t key(long long chunkRow, long long chunkCol);
+    static long long keyRow(uint64_t key);
+    static long long keyCol(uint64_t key);
+    Chunk* find(long long chunkRow, long long chunkCol) const; //nullptr if not allocated
+    Chunk* findOrCreate(long long chunkRow, long long chunkCol);
+    void allocateNeighbours(uint64_t chunkKey); //creates the chunks the activity can reach
+    void advanceChunk(uint64_t chunkKey, Chunk* chunk);
+    static bool isEmpty(const uint64_t* cells);
+
+    unordered_map<uint64_t, Chunk*> chunks;
+    RuleMask rule;
+    int parity; //index of the current generation in the planes of every chunk
+    long long generation;
+
+    ChunkedUniverse(const ChunkedUniverse &other); //not copyable
+    ChunkedUniverse& operator= (const ChunkedUniverse &other);
+};
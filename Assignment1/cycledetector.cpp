@@ -0,0 +1,129 @@
+/**
+ * @brief The following code involves the methods neccessary to detect that a colony stopped
+ * changing or started repeating itself. The hashes of the last generations are kept in a small
+ * ring, and a period p is reported once the last p hashes equal the p hashes before them, i.e.
+ * after the colony went through its cycle twice. Requiring the whole cycle to repeat rather than
+ * a single hash makes a false report from a hash collision practically impossible.
+ * Since a hash is a pass over the whole board, check records only every interval-th generation.
+ * When the sampled hashes repeat with a period of q samples, the colony repeats itself every
+ * q * interval generations, a multiple of its period, so the generations that follow are hashed
+ * one by one until the first that equals the one the repetition was found at, which is exactly
+ * one period later. A colony of period p is sampled with a period of p / gcd(p, interval)
+ * samples, so every period up to maxPeriod (and many longer ones) is found.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "cycledetector.h"
+
+/**
+ * @brief CycleDetector::CycleDetector The constructor of the CycleDetector class.
+ * @param maxPeriod The longest period to detect, at least 1.
+ * @param interval The number of generations between two hashes recorded by check, at least 1.
+ */
+CycleDetector::CycleDetector(int maxPeriod, int interval) {
+    if (maxPeriod < 1) {
+        throw("The longest period must be at least 1.");
+    }
+    if (interval < 1) {
+        throw("The interval of the checks must be at least 1.");
+    }
+    this->maxPeriod = maxPeriod;
+    this->interval = interval;
+    history.assign(2 * maxPeriod, 0);
+    clear();
+}
+
+/**
+ * @brief CycleDetector::clear Forgets every hash, e.g. after the colony was edited or replaced.
+ */
+void CycleDetector::clear() {
+    count = 0;
+    period = 0;
+    generations = 0;
+    multiple = 0;
+    target = 0;
+    confirmed = 0;
+}
+
+/**
+ * @brief CycleDetector::record Adds the hash of the next generation and checks whether or not
+ * the colony is repeating itself. The shortest period is reported, so a still life has period 1.
+ * @param hash The hash of the generation.
+ * @return The period of the cycle, or 0 if the colony has not repeated itself yet.
+ */
+int CycleDetector::record(uint64_t hash) {
+    history[count % history.size()] = hash;
+    count++;
+    period = 0;
+    for (int p = 1; p <= maxPeriod && 2 * p <= count; p++) {
+        if (recent(0) != recent(p)) {
+            continue;
+        }
+        bool repeated = true;
+        for (int age = 1; age < p && repeated; age++) {
+            repeated = recent(age) == recent(age + p);
+        }
+        if (repeated) {
+            period = p;
+            break;
+        }
+    }
+    return period;
+}
+
+/**
+ * @brief CycleDetector::check Counts the next generation and checks whether or not the colony is
+ * repeating itself, asking for the hash of the generation only every interval-th generation and
+ * while a period is being confirmed. The shortest period is reported, as by record, and it is
+ * reported at the generation that equals the one a period before it. Every generation, the first
+ * one included, must be counted by either check or record, not both.
+ * @param hash Returns the hash of the generation.
+ * @return The period of the cycle, or 0 if the colony has not repeated itself yet.
+ */
+int CycleDetector::check(const function<uint64_t()> &hash) {
+    generations++;
+    period = 0;
+    if (multiple > 0) {
+        confirmed++;
+        if (hash() == target && multiple % confirmed == 0) {
+            period = (int) confirmed;
+            multiple = 0; //the next generation starts looking for a cycle again
+            count = 0;
+        } else if (confirmed >= multiple) {
+            multiple = 0; //the samples collided, sampling starts over
+            count = 0;
+        }
+        return period;
+    }
+    if ((generations - 1) % interval != 0) {
+        return 0;
+    }
+    uint64_t sample = hash();
+    int samples = record(sample);
+    period = 0;
+    if (samples > 0) {
+        multiple = (long long) samples * interval;
+        target = sample;
+        confirmed = 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief CycleDetector::getPeriod Returns the period found by the last call to record.
+ * @return The period, 0 if the colony was not repeating itself.
+ */
+int CycleDetector::getPeriod() const {
+    return period;
+}
+
+/**
+ * @brief CycleDetector::recent Returns a hash from the history.
+ * @param age 0 for the last hash recorded, 1 for the one before it and so on.
+ * @return The hash.
+ */
+uint64_t CycleDetector::recent(int age) const {
+    return history[(count - 1 - age) % history.size()];
+}
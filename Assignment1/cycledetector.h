@@ -0,0 +1,44 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * CycleDetector class, which finds the generation a colony becomes a still life or an
+ * oscillator from the 64 bit hashes of its generations. Hashing a board costs a pass over all
+ * of its cells, so check only hashes every CYCLE_CHECK_INTERVAL-th generation until the colony
+ * seems to repeat itself, and every generation only while the period is being confirmed.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+using namespace std;
+
+//constant decleration(s)
+const int CYCLE_MAX_PERIOD = 32; //longest period detected, the history holds twice as many hashes
+const int CYCLE_CHECK_INTERVAL = 16; //generations between two hashes recorded by check
+
+class CycleDetector {
+public:
+    //constructor with the longest period and the generations between two hashes of check
+    CycleDetector(int maxPeriod = CYCLE_MAX_PERIOD, int interval = CYCLE_CHECK_INTERVAL);
+    void clear(); //forgets every hash
+    int record(uint64_t hash); //adds the hash of the next generation, returns the period or 0
+    int check(const function<uint64_t()> &hash); //counts the next generation, hashing it only if needed
+    int getPeriod() const; //period found by the last record or check, 0 if none
+
+private:
+    uint64_t recent(int age) const; //hash recorded age generations before the last one
+
+    vector<uint64_t> history; //ring of the last 2 * maxPeriod hashes
+    int maxPeriod;
+    long long count; //number of hashes recorded since the last clear
+    int period;
+    int interval;
+    long long generations; //number of generations counted by check since the last clear
+    long long multiple; //a multiple of the period found in the sampled hashes, 0 if none yet
+    uint64_t target; //hash of the generation the multiple was found at
+    long long confirmed; //generations hashed since then
+};
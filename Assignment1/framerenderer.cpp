@@ -0,0 +1,180 @@
+/**
+ * @brief The following code involves the methods neccessary to render the generations of a board
+ * on a separate thread. The simulation hands a copy of the board over through a single frame
+ * mailbox and goes on with the next generation while the previous one is printed, drawn or
+ * written, so the speed of the simulation is not tied to the speed of the terminal, the GUI or
+ * the disk. When the renderer can not keep up, a newer frame either replaces the waiting one
+ * (animations) or the simulation waits for the mailbox to empty (snapshots, none of which may be
+ * lost). Frames that are displayed are rendered by the main thread, which the console and GUI
+ * libraries expect, and the simulation is moved to a thread of its own for as long as it runs.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "framerenderer.h"
+
+/**
+ * @brief FrameRenderer::FrameRenderer The constructor of the FrameRenderer class. Starts the
+ * rendering thread, unless the frames are rendered by the thread calling present.
+ * @param consumer The function rendering a frame, called on the rendering thread with the board
+ * and its generation.
+ * @param dropFrames True if a frame that is not rendered yet may be replaced by a newer one.
+ * @param callerRenders True if the frames are rendered by the thread calling present, e.g. the
+ * main thread for the console and the GUI, false to start a rendering thread.
+ */
+FrameRenderer::FrameRenderer(const FrameConsumer &consumer, bool dropFrames, bool callerRenders) {
+    this->consumer = consumer;
+    this->dropFrames = dropFrames;
+    pendingGeneration = 0;
+    hasPending = false;
+    rendering = false;
+    stopping = false;
+    error = nullptr;
+    framesRendered = 0;
+    framesDropped = 0;
+    if (!callerRenders) {
+        worker = thread(&FrameRenderer::renderLoop, this);
+    }
+}
+
+/**
+ * @brief FrameRenderer::~FrameRenderer Destructor of the FrameRenderer class. Renders the frame
+ * that is still waiting, then stops the thread.
+ */
+FrameRenderer::~FrameRenderer() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief FrameRenderer::present Runs a simulation on a separate thread and renders the frames it
+ * submits on the calling thread until it returns, so the consumer can use the console and the
+ * GUI from the main thread. Only for a renderer whose caller renders the frames. An exception
+ * of the simulation or of the consumer is thrown again here once every frame is rendered.
+ * @param simulation Advances the board and submits its frames.
+ */
+void FrameRenderer::present(const function<void()> &simulation) {
+    if (worker.joinable()) {
+        throw("The frames are rendered by the thread of the renderer.");
+    }
+    exception_ptr failure;
+    thread simulator([this, &simulation, &failure] {
+        try {
+            simulation();
+        } catch (...) {
+            failure = current_exception();
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+    });
+    renderLoop(); //returns once the simulation stopped and its last frame is rendered
+    simulator.join();
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = false; //another simulation can be presented
+    }
+    if (failure) {
+        rethrow_exception(failure);
+    }
+    flush();
+}
+
+/**
+ * @brief FrameRenderer::submit Hands a copy of the board over to the rendering thread and
+ * returns without waiting for it to be rendered, unless frames may not be dropped and the
+ * previous frame is still waiting.
+ * @param grid The board to render.
+ * @param generation The generation of the board.
+ */
+void FrameRenderer::submit(const BitGrid &grid, long long generation) {
+    {
+        unique_lock<mutex> guard(lock);
+        if (hasPending) {
+            if (dropFrames) {
+                framesDropped++;
+            } else {
+                idle.wait(guard, [this] { return !hasPending; });
+            }
+        }
+        pending.copyCells(grid);
+        pendingGeneration = generation;
+        hasPending = true;
+    }
+    wake.notify_one();
+}
+
+/**
+ * @brief FrameRenderer::flush Waits until the rendering thread has rendered every frame handed
+ * over so far. An error thrown by the consumer is thrown again here, on the simulation thread.
+ */
+void FrameRenderer::flush() {
+    unique_lock<mutex> guard(lock);
+    idle.wait(guard, [this] { return !hasPending && !rendering; });
+    if (error != nullptr) {
+        const char* message = error;
+        error = nullptr;
+        throw(message);
+    }
+}
+
+/**
+ * @brief FrameRenderer::getFramesRendered Returns the number of frames rendered so far.
+ * @return The number of frames rendered.
+ */
+long long FrameRenderer::getFramesRendered() const {
+    lock_guard<mutex> guard(lock);
+    return framesRendered;
+}
+
+/**
+ * @brief FrameRenderer::getFramesDropped Returns the number of frames that were replaced by a
+ * newer frame before they could be rendered.
+ * @return The number of frames dropped.
+ */
+long long FrameRenderer::getFramesDropped() const {
+    lock_guard<mutex> guard(lock);
+    return framesDropped;
+}
+
+/**
+ * @brief FrameRenderer::renderLoop The loop of the rendering thread. Takes the waiting frame out
+ * of the mailbox, so that the next one can be handed over, and renders it outside the lock.
+ */
+void FrameRenderer::renderLoop() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [this] { return hasPending || stopping; });
+        if (!hasPending) {
+            return;
+        }
+        frame.copyCells(pending);
+        long long generation = pendingGeneration;
+        hasPending = false;
+        rendering = true;
+        idle.notify_all(); //the mailbox is free again
+        guard.unlock();
+        const char* message = nullptr;
+        try {
+            consumer(frame, generation);
+        } catch (const char* thrown) {
+            message = thrown;
+        }
+        guard.lock();
+        rendering = false;
+        framesRendered++;
+        if (message != nullptr && error == nullptr) {
+            error = message;
+        }
+        idle.notify_all();
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * FrameRenderer class, a consumer thread that renders (prints, draws or writes) the generations
+ * of a board while the simulation keeps advancing it. The console and the GUI may only be used by
+ * the main thread, so a renderer that displays the frames renders them on the main thread
+ * instead, while the simulation runs on a thread of its own (see present).
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "bitgrid.h"
+using namespace std;
+
+typedef function<void(const BitGrid &frame, long long generation)> FrameConsumer;
+
+class FrameRenderer {
+public:
+    //constructor, starts the thread unless the frames are rendered by the thread calling present
+    FrameRenderer(const FrameConsumer &consumer, bool dropFrames, bool callerRenders = false);
+    ~FrameRenderer(); //destructor, renders the last frame and joins the thread
+    void present(const function<void()> &simulation); //renders here while the simulation runs on a thread
+    void submit(const BitGrid &grid, long long generation); //hands a copy of the board over
+    void flush(); //waits until every frame handed over is rendered or dropped
+    long long getFramesRendered() const; //number of frames rendered so far
+    long long getFramesDropped() const; //number of frames replaced before they were rendered
+
+private:
+    void renderLoop();
+
+    FrameConsumer consumer; //renders a single frame, called by the thread
+    bool dropFrames; //true if a newer frame replaces a waiting one, false if submit waits instead
+    BitGrid pending; //the frame waiting to be rendered
+    long long pendingGeneration;
+    bool hasPending;
+    BitGrid frame; //the frame being rendered, only used by the thread
+    bool rendering; //true while the consumer is running
+    bool stopping;
+    const char* error; //message thrown by the consumer, thrown again by flush
+    long long framesRendered;
+    long long framesDropped;
+    mutable mutex lock;
+    condition_variable wake; //signals the thread that a frame is waiting or that it should stop
+    condition_variable idle; //signals submit and flush that the thread took or rendered a frame
+    thread worker;
+
+    FrameRenderer(const FrameRenderer &other); //not copyable
+    FrameRenderer& operator= (const FrameRenderer &other);
+};
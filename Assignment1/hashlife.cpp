@@ -0,0 +1,854 @@
+/**
+ * @brief The following code involves the methods neccessary to run the Game of Life with the
+ * HashLife algorithm. The universe is an unbounded plane stored as a quadtree whose nodes are
+ * hash-consed, so that every distinct square of cells is stored only once. The center of every
+ * node after 2^k generations is memoized in the node itself, which lets repetitive patterns
+ * advance by billions of generations in a few steps. The node cache is garbage collected when it
+ * grows beyond a memory cap.
+ * A bounded grid is skipped on the plane only while no cell can reach its edges: a cell travels
+ * at most one row or column per generation, so a colony whose living cells are m rows and
+ * columns away from every edge evolves on the plane exactly as on the grid for m generations,
+ * whatever lies beyond the edges. When the colony is closer to an edge the grid advances itself,
+ * until it is far enough again or repeats itself.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "hashlife.h"
+#include <algorithm>
+#include "cycledetector.h"
+
+//constant decleration(s)
+const size_t INITIAL_BUCKETS = 1 << 16; //initial size of the hash table of nodes
+const int MIN_ROOT_LEVEL = 3; //the root is at least 8x8 so that it always has grandchildren
+const int MAX_ROOT_LEVEL = 62; //the coordinates of larger universes do not fit in a long long
+const int CHUNK_LEVEL = 6; //level of the nodes holding a chunk of a ChunkedUniverse (64x64)
+
+/**
+ * @brief HashLife::HashLife The constructor of the HashLife class. Creates an empty universe.
+ * @param maxMemory The memory (in bytes) the node cache may use before it is garbage collected.
+ */
+HashLife::HashLife(size_t maxMemory) {
+    maxNodes = max((size_t) 1024, maxMemory / (sizeof(Node) + sizeof(Node*)));
+    collections = 0;
+    nodeCount = 0;
+    bucketCount = INITIAL_BUCKETS;
+    buckets = new Node*[bucketCount]();
+    deadCell = new Node();
+    deadCell->hash = 0x9e3779b97f4a7c15ULL;
+    liveCell = new Node();
+    liveCell->population = 1;
+    liveCell->hash = 0xc2b2ae3d27d4eb4fULL;
+    deadCell->resultStep = liveCell->resultStep = -1;
+    root = nullptr;
+    rule = CONWAY_RULE;
+    generation = 0;
+    emptyNodes.push_back(deadCell);
+}
+
+/**
+ * @brief HashLife::~HashLife Destructor of the HashLife class. Deletes every node.
+ */
+HashLife::~HashLife() {
+    clear();
+    delete [] buckets;
+    delete deadCell;
+    delete liveCell;
+}
+
+/**
+ * @brief HashLife::load Replaces the universe with the cells of a grid. The cell in row r and
+ * column c of the grid is placed at the same coordinates of the plane. The universe takes the
+ * rule of the grid, which may not contain B0.
+ * @param grid The grid to load.
+ */
+void HashLife::load(const BitGrid &grid) {
+    if (ruleBirthsFromNothing(grid.getRule())) {
+        throw("Rules with B0 can not be used on an unbounded plane.");
+    }
+    clear();
+    rule = grid.getRule();
+    generation = 0;
+    int level = MIN_ROOT_LEVEL;
+    while ((1LL << (level - 1)) < max(grid.numRows(), grid.numCols())) {
+        level++;
+    }
+    root = build(grid, level, -(1LL << (level - 1)), -(1LL << (level - 1)));
+}
+
+/**
+ * @brief HashLife::store Copies the cells of the universe that are inside the rectangle of the
+ * grid into the grid. The cells outside of the rectangle are not copied.
+ * @param grid The grid to fill, its dimensions stay the same.
+ */
+void HashLife::store(BitGrid &grid) const {
+    grid.clear();
+    if (root != nullptr) {
+        extract(root, -(1LL << (root->level - 1)), -(1LL << (root->level - 1)), grid);
+    }
+}
+
+/**
+ * @brief HashLife::load Replaces the universe with the cells of an unbounded plane. Every chunk
+ * of the plane becomes a node that is inserted into the quadtree, so the cost follows the number
+ * of chunks rather than the bounding box of the plane.
+ * @param universe The plane to load, the cells keep their coordinates and its rule is used.
+ */
+void HashLife::load(const ChunkedUniverse &universe) {
+    clear();
+    rule = universe.getRule();
+    generation = 0;
+    root = emptyNode(CHUNK_LEVEL + 1);
+    for (const pair<long long, long long> &coordinates : universe.getChunkCoordinates()) {
+        long long chunkRow = coordinates.first * CHUNK_SIZE;
+        long long chunkCol = coordinates.second * CHUNK_SIZE;
+        long long half = 1LL << (root->level - 1);
+        while (chunkRow < -half || chunkRow + CHUNK_SIZE > half || chunkCol < -half
+               || chunkCol + CHUNK_SIZE > half) {
+            root = expand(root);
+            half = 1LL << (root->level - 1);
+        }
+        Node* chunk = buildChunk(universe.getChunk(coordinates.first, coordinates.second), CHUNK_LEVEL, 0, 0);
+        root = insertChunk(root, -half, -half, chunkRow, chunkCol, chunk);
+    }
+}
+
+/**
+ * @brief HashLife::store Copies every living cell of the universe into an unbounded plane, chunk
+ * by chunk.
+ * @param universe The plane to fill, its previous cells are removed.
+ */
+void HashLife::store(ChunkedUniverse &universe) const {
+    universe.setRule(rule);
+    universe.clear();
+    if (root != nullptr) {
+        extract(root, -(1LL << (root->level - 1)), -(1LL << (root->level - 1)), universe);
+    }
+}
+
+/**
+ * @brief HashLife::getRule Returns the rule the universe is advanced with.
+ * @return The rule.
+ */
+RuleMask HashLife::getRule() const {
+    return rule;
+}
+
+/**
+ * @brief HashLife::get Returns the state of a cell of the plane.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @return True if the cell is alive, false otherwise.
+ */
+bool HashLife::get(long long row, long long col) const {
+    if (root == nullptr) {
+        return false;
+    }
+    long long half = 1LL << (root->level - 1);
+    if (row < -half || row >= half || col < -half || col >= half) {
+        return false;
+    }
+    row += half; //coordinates relative to the top left corner of the current node
+    col += half;
+    Node* node = root;
+    while (node->level > 0 && node->population > 0) {
+        half = 1LL << (node->level - 1);
+        if (row < half) {
+            node = (col < half) ? node->nw : node->ne;
+        } else {
+            node = (col < half) ? node->sw : node->se;
+        }
+        row %= half;
+        col %= half;
+    }
+    return node->population > 0;
+}
+
+/**
+ * @brief HashLife::advance Advances the universe by the given number of generations, jumping
+ * 2^k generations at once for every bit k set in the number. Throws a string exception if the
+ * universe outgrows the memory cap, after the generations of the jumps already made.
+ * @param generations The number of generations.
+ */
+void HashLife::advance(uint64_t generations) {
+    if (root == nullptr) {
+        return;
+    }
+    for (int step = 0; step < 64 && (generations >> step) != 0; step++) {
+        if (((generations >> step) & 1) == 0) {
+            continue;
+        }
+        //the pattern must be in the central quarter and one more level of padding is added, so
+        //that nothing can travel out of the center of the root within 2^step generations
+        while (root->level < step + 3 || !hasEmptyBorder(root)) {
+            root = expand(root);
+        }
+        root = expand(root);
+        try {
+            root = successor(root, step);
+        } catch (...) {
+            protectedNodes.clear(); //the recursion is gone, the root is still the expanded universe
+            throw;
+        }
+        generation += (uint64_t) 1 << step;
+        while (root->level > MIN_ROOT_LEVEL && hasEmptyBorder(root)) {
+            root = centeredSubnode(root);
+        }
+    }
+}
+
+/**
+ * @brief HashLife::getGeneration Returns the number of generations advanced since the last load.
+ * @return The generation number.
+ */
+uint64_t HashLife::getGeneration() const {
+    return generation;
+}
+
+/**
+ * @brief HashLife::getPopulation Returns the number of living cells in the universe.
+ * @return The population.
+ */
+uint64_t HashLife::getPopulation() const {
+    return root == nullptr ? 0 : root->population;
+}
+
+/**
+ * @brief HashLife::getBounds Finds the bounding box of the living cells of the plane.
+ * @param top, left, bottom, right Set to the first and last row and column with a living cell.
+ * @return False if there are no living cells, in which case the bounds are not set.
+ */
+bool HashLife::getBounds(long long &top, long long &left, long long &bottom, long long &right) const {
+    if (root == nullptr || root->population == 0) {
+        return false;
+    }
+    long long corner = -(1LL << (root->level - 1));
+    top = corner + findEdge(root, true, false);
+    bottom = corner + findEdge(root, true, true);
+    left = corner + findEdge(root, false, false);
+    right = corner + findEdge(root, false, true);
+    return true;
+}
+
+/**
+ * @brief HashLife::getNodeCount Returns the number of nodes in the cache.
+ * @return The number of nodes.
+ */
+size_t HashLife::getNodeCount() const {
+    return nodeCount;
+}
+
+/**
+ * @brief HashLife::getCollections Returns the number of garbage collections run so far.
+ * @return The number of garbage collections.
+ */
+size_t HashLife::getCollections() const {
+    return collections;
+}
+
+/**
+ * @brief HashLife::findNode Returns the unique node with the given quadrants, creating it if it
+ * does not exist yet (hash-consing).
+ * @param nw, ne, sw, se The quadrants, which are nodes of the same level.
+ * @return The node one level above the quadrants.
+ */
+HashLife::Node* HashLife::findNode(Node* nw, Node* ne, Node* sw, Node* se) {
+    uint64_t hash = nw->hash * 0x9e3779b97f4a7c15ULL + ne->hash * 0xbf58476d1ce4e5b9ULL
+                    + sw->hash * 0x94d049bb133111ebULL + se->hash * 0xd6e8feb86659fd93ULL;
+    hash ^= hash >> 31;
+    size_t bucketIndex = hash % bucketCount;
+    for (Node* current = buckets[bucketIndex]; current != nullptr; current = current->next) {
+        if (current->nw == nw && current->ne == ne && current->sw == sw && current->se == se) {
+            return current;
+        }
+    }
+    Node* incoming = new Node();
+    incoming->nw = nw;
+    incoming->ne = ne;
+    incoming->sw = sw;
+    incoming->se = se;
+    incoming->population = nw->population + ne->population + sw->population + se->population;
+    incoming->hash = hash;
+    incoming->level = nw->level + 1;
+    incoming->resultStep = -1;
+    incoming->next = buckets[bucketIndex];
+    buckets[bucketIndex] = incoming;
+    nodeCount++;
+    if (nodeCount > bucketCount) {
+        rehash(bucketCount * 2);
+    }
+    return incoming;
+}
+
+/**
+ * @brief HashLife::emptyNode Returns the node of the given level whose cells are all dead.
+ * @param level The level of the node.
+ * @return The empty node.
+ */
+HashLife::Node* HashLife::emptyNode(int level) {
+    while ((int) emptyNodes.size() <= level) {
+        Node* below = emptyNodes.back();
+        emptyNodes.push_back(findNode(below, below, below, below));
+    }
+    return emptyNodes[level];
+}
+
+/**
+ * @brief HashLife::centeredSubnode Returns the center of a node, which is a node one level below.
+ * @param node The node, at least at level 2.
+ * @return The center of the node.
+ */
+HashLife::Node* HashLife::centeredSubnode(Node* node) {
+    return findNode(node->nw->se, node->ne->sw, node->sw->ne, node->se->nw);
+}
+
+/**
+ * @brief HashLife::expand Returns the node one level up, which has the given node at its center
+ * and dead cells around it.
+ * @param node The node to expand, at least at level 1.
+ * @return The expanded node.
+ */
+HashLife::Node* HashLife::expand(Node* node) {
+    if (node->level >= MAX_ROOT_LEVEL) {
+        throw("The universe has grown too large to be expanded.");
+    }
+    Node* empty = emptyNode(node->level - 1);
+    return findNode(findNode(empty, empty, empty, node->nw), findNode(empty, empty, node->ne, empty),
+                    findNode(empty, node->sw, empty, empty), findNode(node->se, empty, empty, empty));
+}
+
+/**
+ * @brief HashLife::successor Returns the center of a node after 2^step generations. The node is
+ * split into nine overlapping subnodes that are advanced recursively, at full speed (two half
+ * steps) when step is the largest step the level allows, otherwise by one recursive step on
+ * their centers. The result is memoized in the node.
+ * @param node The node to advance, at least at level 2.
+ * @param step The log2 of the number of generations, at most node->level - 2.
+ * @return The center of the node (one level below) after 2^step generations.
+ */
+HashLife::Node* HashLife::successor(Node* node, int step) {
+    if (node->result != nullptr && node->resultStep == step) {
+        return node->result;
+    }
+    if (node->population == 0) {
+        return emptyNode(node->level - 1);
+    }
+    if (node->level == 2) {
+        node->result = advanceBase(node);
+        node->resultStep = 0;
+        return node->result;
+    }
+    if (nodeCount >= maxNodes) {
+        collectGarbage();
+    }
+    size_t protectedCount = protectedNodes.size();
+    protect(node);
+    Node* a = node->nw;
+    Node* b = node->ne;
+    Node* c = node->sw;
+    Node* d = node->se;
+    //the nine overlapping subnodes, one level below the node
+    Node* n[3][3];
+    n[0][0] = a;
+    n[0][1] = findNode(a->ne, b->nw, a->se, b->sw);
+    n[0][2] = b;
+    n[1][0] = findNode(a->sw, a->se, c->nw, c->ne);
+    n[1][1] = findNode(a->se, b->sw, c->ne, d->nw);
+    n[1][2] = findNode(b->sw, b->se, d->nw, d->ne);
+    n[2][0] = c;
+    n[2][1] = findNode(c->ne, d->nw, c->se, d->sw);
+    n[2][2] = d;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            protect(n[i][j]);
+        }
+    }
+    bool fullSpeed = step == node->level - 2;
+    Node* r[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            //the first half step, skipped when the node advances slower than its level allows
+            r[i][j] = fullSpeed ? successor(n[i][j], step - 1) : centeredSubnode(n[i][j]);
+            protect(r[i][j]);
+        }
+    }
+    Node* quadrants[2][2];
+    int halfStep = fullSpeed ? step - 1 : step;
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            Node* combined = findNode(r[i][j], r[i][j + 1], r[i + 1][j], r[i + 1][j + 1]);
+            protect(combined);
+            quadrants[i][j] = successor(combined, halfStep);
+            protect(quadrants[i][j]);
+        }
+    }
+    Node* result = findNode(quadrants[0][0], quadrants[0][1], quadrants[1][0], quadrants[1][1]);
+    protectedNodes.resize(protectedCount);
+    node->result = result;
+    node->resultStep = step;
+    return result;
+}
+
+/**
+ * @brief HashLife::advanceBase Returns the center 2x2 cells of a 4x4 node after one generation,
+ * applying the rules of the game cell by cell.
+ * @param node The level 2 node.
+ * @return The level 1 node holding the next generation of the center.
+ */
+HashLife::Node* HashLife::advanceBase(Node* node) {
+    bool cells[4][4];
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            Node* quadrant = (r < 2) ? ((c < 2) ? node->nw : node->ne) : ((c < 2) ? node->sw : node->se);
+            Node* cell = (r % 2 == 0) ? ((c % 2 == 0) ? quadrant->nw : quadrant->ne)
+                                      : ((c % 2 == 0) ? quadrant->sw : quadrant->se);
+            cells[r][c] = cell->population > 0;
+        }
+    }
+    Node* next[2][2];
+    for (int r = 1; r <= 2; r++) {
+        for (int c = 1; c <= 2; c++) {
+            int count = 0;
+            for (int i = r - 1; i <= r + 1; i++) {
+                for (int j = c - 1; j <= c + 1; j++) {
+                    if ((i != r || j != c) && cells[i][j]) {
+                        count++;
+                    }
+                }
+            }
+            bool alive = (rule >> (cells[r][c] ? 9 + count : count)) & 1;
+            next[r - 1][c - 1] = alive ? liveCell : deadCell;
+        }
+    }
+    return findNode(next[0][0], next[0][1], next[1][0], next[1][1]);
+}
+
+/**
+ * @brief HashLife::build Builds the node for a square of the plane from the cells of a grid,
+ * the cells outside of the grid are dead.
+ * @param grid The grid holding the cells.
+ * @param level The level of the node.
+ * @param row The row of the top left corner of the square.
+ * @param col The column of the top left corner of the square.
+ * @return The node of the square.
+ */
+HashLife::Node* HashLife::build(const BitGrid &grid, int level, long long row, long long col) {
+    long long size = 1LL << level;
+    if (row >= grid.numRows() || col >= grid.numCols() || row + size <= 0 || col + size <= 0) {
+        return emptyNode(level);
+    }
+    if (level == 0) {
+        return grid.get(row, col) ? liveCell : deadCell;
+    }
+    long long half = size / 2;
+    return findNode(build(grid, level - 1, row, col), build(grid, level - 1, row, col + half),
+                    build(grid, level - 1, row + half, col), build(grid, level - 1, row + half, col + half));
+}
+
+/**
+ * @brief HashLife::extract Copies the living cells of a node that are inside the rectangle of a
+ * grid into the grid.
+ * @param node The node to copy.
+ * @param row The row of the top left corner of the node.
+ * @param col The column of the top left corner of the node.
+ * @param grid The grid to fill.
+ */
+void HashLife::extract(Node* node, long long row, long long col, BitGrid &grid) const {
+    long long size = 1LL << node->level;
+    if (node->population == 0 || row >= grid.numRows() || col >= grid.numCols() || row + size <= 0
+            || col + size <= 0) {
+        return;
+    }
+    if (node->level == 0) {
+        grid.set(row, col, true);
+        return;
+    }
+    long long half = size / 2;
+    extract(node->nw, row, col, grid);
+    extract(node->ne, row, col + half, grid);
+    extract(node->sw, row + half, col, grid);
+    extract(node->se, row + half, col + half, grid);
+}
+
+/**
+ * @brief HashLife::buildChunk Builds the node for a square of a chunk of an unbounded plane.
+ * @param cells The 64 row words of the chunk.
+ * @param level The level of the node.
+ * @param row The row of the top left corner of the square in the chunk.
+ * @param col The column of the top left corner of the square in the chunk.
+ * @return The node of the square.
+ */
+HashLife::Node* HashLife::buildChunk(const uint64_t* cells, int level, int row, int col) {
+    if (level == 0) {
+        return ((cells[row] >> col) & 1) ? liveCell : deadCell;
+    }
+    int half = 1 << (level - 1);
+    return findNode(buildChunk(cells, level - 1, row, col), buildChunk(cells, level - 1, row, col + half),
+                    buildChunk(cells, level - 1, row + half, col),
+                    buildChunk(cells, level - 1, row + half, col + half));
+}
+
+/**
+ * @brief HashLife::insertChunk Returns a node equal to the given one except for the chunk sized
+ * square at the given coordinates, which is replaced by the chunk.
+ * @param node The node, which contains the square.
+ * @param row The row of the top left corner of the node.
+ * @param col The column of the top left corner of the node.
+ * @param chunkRow The row of the top left corner of the square.
+ * @param chunkCol The column of the top left corner of the square.
+ * @param chunk The node replacing the square.
+ * @return The new node.
+ */
+HashLife::Node* HashLife::insertChunk(Node* node, long long row, long long col, long long chunkRow,
+                                      long long chunkCol, Node* chunk) {
+    if (node->level == CHUNK_LEVEL) {
+        return chunk;
+    }
+    long long half = 1LL << (node->level - 1);
+    bool south = chunkRow >= row + half;
+    bool east = chunkCol >= col + half;
+    long long quadrantRow = south ? row + half : row;
+    long long quadrantCol = east ? col + half : col;
+    if (!south && !east) {
+        return findNode(insertChunk(node->nw, quadrantRow, quadrantCol, chunkRow, chunkCol, chunk),
+                        node->ne, node->sw, node->se);
+    } else if (!south) {
+        return findNode(node->nw, insertChunk(node->ne, quadrantRow, quadrantCol, chunkRow, chunkCol, chunk),
+                        node->sw, node->se);
+    } else if (!east) {
+        return findNode(node->nw, node->ne,
+                        insertChunk(node->sw, quadrantRow, quadrantCol, chunkRow, chunkCol, chunk), node->se);
+    }
+    return findNode(node->nw, node->ne, node->sw,
+                    insertChunk(node->se, quadrantRow, quadrantCol, chunkRow, chunkCol, chunk));
+}
+
+/**
+ * @brief HashLife::extract Copies the living cells of a node into an unbounded plane. The nodes
+ * that line up with a chunk are copied as a whole chunk.
+ * @param node The node to copy.
+ * @param row The row of the top left corner of the node.
+ * @param col The column of the top left corner of the node.
+ * @param universe The plane to fill.
+ */
+void HashLife::extract(Node* node, long long row, long long col, ChunkedUniverse &universe) const {
+    if (node->population == 0) {
+        return;
+    }
+    if (node->level == 0) {
+        universe.set(row, col, true);
+        return;
+    }
+    if (node->level == CHUNK_LEVEL && row % CHUNK_SIZE == 0 && col % CHUNK_SIZE == 0) {
+        uint64_t cells[CHUNK_SIZE] = {};
+        extractChunk(node, 0, 0, cells);
+        universe.setChunk(row / CHUNK_SIZE, col / CHUNK_SIZE, cells);
+        return;
+    }
+    long long half = 1LL << (node->level - 1);
+    extract(node->nw, row, col, universe);
+    extract(node->ne, row, col + half, universe);
+    extract(node->sw, row + half, col, universe);
+    extract(node->se, row + half, col + half, universe);
+}
+
+/**
+ * @brief HashLife::extractChunk Copies the living cells of a node into the row words of a chunk.
+ * @param node The node to copy.
+ * @param row The row of the top left corner of the node in the chunk.
+ * @param col The column of the top left corner of the node in the chunk.
+ * @param cells The 64 row words of the chunk.
+ */
+void HashLife::extractChunk(Node* node, int row, int col, uint64_t* cells) const {
+    if (node->population == 0) {
+        return;
+    }
+    if (node->level == 0) {
+        cells[row] |= (uint64_t) 1 << col;
+        return;
+    }
+    int half = 1 << (node->level - 1);
+    extractChunk(node->nw, row, col, cells);
+    extractChunk(node->ne, row, col + half, cells);
+    extractChunk(node->sw, row + half, col, cells);
+    extractChunk(node->se, row + half, col + half, cells);
+}
+
+/**
+ * @brief HashLife::hasEmptyBorder Checks whether or not all living cells of a node are in its
+ * center.
+ * @param node The node, at least at level 2.
+ * @return True if the cells outside of the center are all dead.
+ */
+bool HashLife::hasEmptyBorder(Node* node) {
+    return centeredSubnode(node)->population == node->population;
+}
+
+/**
+ * @brief HashLife::findEdge Finds the first or the last row or column of a node with a living
+ * cell. Only the quadrants on the side looked at are searched, unless they are empty.
+ * @param node The node, which has a living cell.
+ * @param rows True to look for a row, false for a column.
+ * @param last True to look for the last one, false for the first one.
+ * @return The row or column, counted from the top left corner of the node.
+ */
+long long HashLife::findEdge(Node* node, bool rows, bool last) const {
+    if (node->level == 0) {
+        return 0;
+    }
+    long long half = 1LL << (node->level - 1);
+    //the quadrants of the near half and of the far half, and where the far half starts
+    Node* near[2] = {node->nw, rows ? node->ne : node->sw};
+    Node* far[2] = {rows ? node->sw : node->ne, node->se};
+    long long nearOffset = 0;
+    long long farOffset = half;
+    if (last) {
+        swap(near[0], far[0]);
+        swap(near[1], far[1]);
+        swap(nearOffset, farOffset);
+    }
+    for (int side = 0; side < 2; side++) {
+        Node** quadrants = (side == 0) ? near : far;
+        bool found = false;
+        long long edge = 0;
+        for (int i = 0; i < 2; i++) {
+            if (quadrants[i]->population == 0) {
+                continue;
+            }
+            long long candidate = findEdge(quadrants[i], rows, last);
+            if (!found || (last ? candidate > edge : candidate < edge)) {
+                edge = candidate;
+            }
+            found = true;
+        }
+        if (found) {
+            return ((side == 0) ? nearOffset : farOffset) + edge;
+        }
+    }
+    return 0; //not reached, the node has a living cell
+}
+
+/**
+ * @brief HashLife::rehash Moves every node into a new hash table of the given size.
+ * @param newBucketCount The number of buckets of the new table.
+ */
+void HashLife::rehash(size_t newBucketCount) {
+    Node** newBuckets = new Node*[newBucketCount]();
+    for (size_t i = 0; i < bucketCount; i++) {
+        Node* current = buckets[i];
+        while (current != nullptr) {
+            Node* following = current->next;
+            size_t bucketIndex = current->hash % newBucketCount;
+            current->next = newBuckets[bucketIndex];
+            newBuckets[bucketIndex] = current;
+            current = following;
+        }
+    }
+    delete [] buckets;
+    buckets = newBuckets;
+    bucketCount = newBucketCount;
+}
+
+/**
+ * @brief HashLife::protect Keeps a node (and its descendants) alive if a garbage collection
+ * happens before the recursion that holds it returns.
+ * @param node The node to protect.
+ */
+void HashLife::protect(Node* node) {
+    protectedNodes.push_back(node);
+}
+
+/**
+ * @brief HashLife::collectGarbage Deletes every node that is not reachable from the root, the
+ * empty nodes or the nodes held by the recursion, keeping the memoized results of the reachable
+ * nodes, which are what makes HashLife fast. If the nodes kept still take more than half of the
+ * cap, the collection is repeated without the memoized results, which are then forgotten. If the
+ * reachable nodes alone take more than three quarters of the cap, the universe does not fit in it
+ * and a string exception is thrown.
+ */
+void HashLife::collectGarbage() {
+    sweep(true);
+    if (nodeCount > maxNodes / 2) {
+        sweep(false);
+    }
+    collections++;
+    if (nodeCount > maxNodes / 4 * 3) {
+        throw("The universe needs more memory than the cap of the node cache.");
+    }
+}
+
+/**
+ * @brief HashLife::sweep Marks the nodes that are reachable and deletes the others. The memoized
+ * results pointing to deleted nodes are forgotten.
+ * @param keepResults True if the memoized results of the reachable nodes are reachable too.
+ */
+void HashLife::sweep(bool keepResults) {
+    if (root != nullptr) {
+        mark(root, keepResults);
+    }
+    for (Node* node : emptyNodes) {
+        mark(node, keepResults);
+    }
+    for (Node* node : protectedNodes) {
+        mark(node, keepResults);
+    }
+    //the results are forgotten before any node is deleted, a result may be deleted earlier in
+    //the same bucket scan than the node pointing to it
+    for (size_t i = 0; i < bucketCount; i++) {
+        for (Node* current = buckets[i]; current != nullptr; current = current->next) {
+            if (current->marked && current->result != nullptr && !current->result->marked) {
+                current->result = nullptr;
+                current->resultStep = -1;
+            }
+        }
+    }
+    for (size_t i = 0; i < bucketCount; i++) {
+        Node** link = &buckets[i];
+        while (*link != nullptr) {
+            Node* current = *link;
+            if (current->marked) {
+                link = &current->next;
+            } else {
+                *link = current->next;
+                delete current;
+                nodeCount--;
+            }
+        }
+    }
+    for (size_t i = 0; i < bucketCount; i++) {
+        for (Node* current = buckets[i]; current != nullptr; current = current->next) {
+            current->marked = false;
+        }
+    }
+}
+
+/**
+ * @brief HashLife::mark Marks a node and its descendants as reachable.
+ * @param node The node to mark.
+ * @param keepResults True to mark the memoized result of every node marked as well.
+ */
+void HashLife::mark(Node* node, bool keepResults) {
+    if (node->level == 0 || node->marked) {
+        return;
+    }
+    node->marked = true;
+    mark(node->nw, keepResults);
+    mark(node->ne, keepResults);
+    mark(node->sw, keepResults);
+    mark(node->se, keepResults);
+    if (keepResults && node->result != nullptr) {
+        mark(node->result, keepResults);
+    }
+}
+
+/**
+ * @brief HashLife::clear Deletes every node of the hash table and forgets the root.
+ */
+void HashLife::clear() {
+    for (size_t i = 0; i < bucketCount; i++) {
+        while (buckets[i] != nullptr) {
+            Node* trash = buckets[i];
+            buckets[i] = buckets[i]->next;
+            delete trash;
+        }
+    }
+    nodeCount = 0;
+    emptyNodes.resize(1);
+    protectedNodes.clear();
+    root = nullptr;
+}
+
+/**
+ * @brief gridMargin Finds how many rows and columns lie between the living cells of a grid and
+ * its nearest edge.
+ * @param grid The grid.
+ * @return The number of dead rows or columns before the nearest edge, -1 if every cell is dead.
+ */
+static long long gridMargin(const BitGrid &grid) {
+    int top = -1;
+    int bottom = -1;
+    int left = grid.numCols();
+    int right = -1;
+    for (int r = 0; r < grid.numRows(); r++) {
+        int first = grid.findCell(r, 0, true);
+        if (first == grid.numCols()) {
+            continue;
+        }
+        if (top < 0) {
+            top = r;
+        }
+        bottom = r;
+        left = min(left, first);
+        //the last living cell of the row, a word at a time
+        const uint64_t* words = grid.rowWords(r);
+        int w = grid.rowWordCount() - 1;
+        while (words[w] == 0) {
+            w--;
+        }
+        right = max(right, w * 64 + 63 - __builtin_clzll(words[w]));
+    }
+    if (top < 0) {
+        return -1;
+    }
+    return min(min(top, left), min(grid.numRows() - 1 - bottom, grid.numCols() - 1 - right));
+}
+
+/**
+ * @brief skipGrid Advances a bounded grid by any number of generations with its boundary, giving
+ * the same cells as that many calls to grid.advance(boundary). While the living cells are at
+ * least SKIP_MIN_JUMP rows and columns away from every edge, the colony jumps on a HashLife plane
+ * by as many generations as that distance, since no cell can reach an edge in that time. Closer
+ * to an edge, the grid advances itself, and once it repeats itself only the generations the rest
+ * of the cycle needs are computed. Rules with B0, and colonies that outgrow the memory cap of the
+ * node cache, are only advanced on the grid.
+ * @param grid The grid to advance, its size, rule and boundary stay the same.
+ * @param boundary What lies beyond the edges of the grid.
+ * @param generations The number of generations.
+ * @param maxMemory The memory cap of the HashLife node cache.
+ */
+void skipGrid(BitGrid &grid, Boundary boundary, uint64_t generations, size_t maxMemory) {
+    bool plane = !ruleBirthsFromNothing(grid.getRule()); //B0 brings the whole plane to life
+    CycleDetector cycles;
+    function<uint64_t()> hash = [&grid] { return grid.hash(); };
+    cycles.check(hash);
+    while (generations > 0) {
+        long long margin = gridMargin(grid);
+        if (margin < 0 && plane) {
+            return; //nothing is ever born among dead cells
+        }
+        if (plane && margin >= SKIP_MIN_JUMP && generations >= (uint64_t) SKIP_MIN_JUMP) {
+            HashLife universe(maxMemory);
+            uint64_t jumped = 0;
+            try {
+                universe.load(grid);
+                long long top, left, bottom, right;
+                do {
+                    uint64_t jump = min((uint64_t) margin, generations - jumped);
+                    universe.advance(jump);
+                    jumped += jump;
+                    if (!universe.getBounds(top, left, bottom, right)) {
+                        jumped = generations; //the colony died out
+                        break;
+                    }
+                    margin = min(min(top, left), min(grid.numRows() - 1 - bottom, grid.numCols() - 1 - right));
+                } while (jumped < generations && margin >= SKIP_MIN_JUMP);
+            } catch (const char*) {
+                //the colony does not fit in the node cache, the grid goes on from where the jumps started
+                plane = false;
+                continue;
+            }
+            universe.store(grid);
+            generations -= jumped;
+            cycles.clear(); //the generations in between were not recorded
+            cycles.check(hash);
+            continue;
+        }
+        grid.advance(boundary);
+        generations--;
+        int period = cycles.check(hash);
+        if (period > 0) {
+            generations %= period; //the remaining generations go around the cycle
+        }
+    }
+}
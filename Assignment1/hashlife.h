@@ -0,0 +1,96 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * HashLife class, a memoized quadtree universe that can advance a colony by huge numbers of
+ * generations at once.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bitgrid.h"
+#include "chunkeduniverse.h"
+using namespace std;
+
+//constant decleration(s)
+const size_t HASHLIFE_DEFAULT_MEMORY = 256 * 1024 * 1024; //default memory cap of the node cache
+const int SKIP_MIN_JUMP = 64; //shorter jumps advance the grid itself, loading the plane costs more
+
+class HashLife {
+public:
+    HashLife(size_t maxMemory = HASHLIFE_DEFAULT_MEMORY); //constructor with the node cache cap
+    ~HashLife(); //destructor
+
+    void load(const BitGrid &grid); //replaces the universe with the cells and the rule of a grid
+    void store(BitGrid &grid) const; //copies the cells inside the grid's rectangle into the grid
+    void load(const ChunkedUniverse &universe); //replaces the universe with an unbounded plane
+    void store(ChunkedUniverse &universe) const; //copies every cell and the rule into a plane
+    RuleMask getRule() const; //accessor method for the rule, which is given by load
+    bool get(long long row, long long col) const; //returns true if the cell is alive
+    void advance(uint64_t generations); //advances the universe by any number of generations
+    uint64_t getGeneration() const; //number of generations advanced since the last load
+    uint64_t getPopulation() const; //number of living cells
+    bool getBounds(long long &top, long long &left, long long &bottom, long long &right) const; //false if empty
+    size_t getNodeCount() const; //number of nodes in the cache
+    size_t getCollections() const; //number of garbage collections so far
+
+private:
+    struct Node { //a square of 2^level x 2^level cells, stored only once
+        Node* nw; //quadrants of the square, nullptr for single cells (level 0)
+        Node* ne;
+        Node* sw;
+        Node* se;
+        Node* result; //memoized center of the square after 2^resultStep generations
+        Node* next; //next node in the same bucket of the hash table
+        uint64_t population;
+        uint64_t hash;
+        int level;
+        int resultStep;
+        bool marked; //used by the garbage collector
+    };
+
+    Node* findNode(Node* nw, Node* ne, Node* sw, Node* se); //returns the unique node for the quadrants
+    Node* emptyNode(int level); //returns the square of dead cells
+    Node* centeredSubnode(Node* node);
+    Node* expand(Node* node); //returns the node one level up with the node at its center
+    Node* successor(Node* node, int step); //returns the center of the node after 2^step generations
+    Node* advanceBase(Node* node); //successor of a 4x4 square, computed cell by cell
+    Node* build(const BitGrid &grid, int level, long long row, long long col);
+    void extract(Node* node, long long row, long long col, BitGrid &grid) const;
+    Node* buildChunk(const uint64_t* cells, int level, int row, int col);
+    Node* insertChunk(Node* node, long long row, long long col, long long chunkRow, long long chunkCol,
+                      Node* chunk); //returns the node with the chunk replacing the square at its place
+    void extract(Node* node, long long row, long long col, ChunkedUniverse &universe) const;
+    void extractChunk(Node* node, int row, int col, uint64_t* cells) const;
+    bool hasEmptyBorder(Node* node); //true if all cells are in the central quarter
+    long long findEdge(Node* node, bool rows, bool last) const; //first or last row/column with a living cell
+    void rehash(size_t bucketCount);
+    void protect(Node* node); //keeps a node alive during a garbage collection
+    void collectGarbage(); //throws if the reachable nodes do not fit in the cap
+    void sweep(bool keepResults); //deletes the nodes that are not reachable
+    void mark(Node* node, bool keepResults);
+    void clear(); //frees every node
+
+    Node** buckets; //hash table of all the nodes
+    size_t bucketCount;
+    size_t nodeCount;
+    size_t maxNodes; //the node cache is collected when it grows to this, the cap of the memory
+    size_t collections;
+    Node* deadCell; //the two level 0 nodes
+    Node* liveCell;
+    vector<Node*> emptyNodes; //emptyNodes[level] is the empty square of that level
+    vector<Node*> protectedNodes; //nodes held by the recursion, roots of the garbage collector
+    Node* root; //the universe, centered on the origin
+    RuleMask rule; //the memoized results are only valid for this rule, load clears them
+    uint64_t generation;
+
+    HashLife(const HashLife &other); //not copyable
+    HashLife& operator= (const HashLife &other);
+};
+
+//advances a bounded grid by any number of generations, exactly as that many calls to advance
+void skipGrid(BitGrid &grid, Boundary boundary, uint64_t generations, size_t maxMemory = HASHLIFE_DEFAULT_MEMORY);
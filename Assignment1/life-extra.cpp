@@ -7,18 +7,29 @@
   * to model the game. The program also contains some extensions. Those extensions involve
   * random pattern generation and GUI. Random pattern generation code can be found in the
   * function named generateRandomGrid and GUI codes are added inside displayGrid, advanceGrid
-  * and main functions.
+  * and main functions. The colony is stored in a BitGrid, and the console and the GUI are
+  * updated by a separate rendering thread, so the simulation does not wait for them. Only the
+  * cells that changed since the last drawn frame are sent to the GUI, and at most one frame is
+  * drawn every FRAME_INTERVAL milliseconds, the frames made in between are skipped. A headless
+  * batch mode runs many generations and only refreshes the display every few of them. The census
+  * mode searches thousands of random soups in parallel and reports the objects they settle into
+  * (see soupcensus.h). Built with -DLIFE_STATS, the population, births, deaths and bounding box
+  * of every generation and the time spent stepping and displaying it are dumped to stderr (or to
+  * STATS_FILE) every STATS_DUMP_INTERVAL generations.
   * @author EFE ACER
   * CS106B - Section Leader: Ryan Kurohara
   */
 
 //necessary includes
+#include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include "console.h"
 #include "filelib.h"
 #include "grid.h"
@@ -27,6 +38,11 @@
 #include "strlib.h"
 #include "lifegui.h"
 #include "random.h" //added it for the extensions
+#include "bitgrid.h"
+#include "framerenderer.h"
+#include "lifestats.h"
+#include "rle.h"
+#include "soupcensus.h"
 using namespace std;
 
 //Constant declerations (for further changes)
@@ -38,19 +54,33 @@ const string WELCOME_MESSAGE = "Welcome to the CS 106B Game of Life,\n"
                                "- Locations with 3 neighbors will create life.\n"
                                "- A cell with 4 or more neighbors dies.\n\n";
 const string PROMPT_FILE = "Grid input file name? ";
-const string RANDOM = "(type \"random\" to generate a random pattern) ";
+const string RANDOM = "(type \"random\" to generate a random pattern or \"census\" to search random soups) ";
 const string FILE_ERROR = "Unable to open that file.  Try again.\n";
-const string OPTIONS = "Should the simulation wrap around the grid (y/n)? ";
-const string MENU = "a)nimate, t)ick, q)uit? ";
+const string OPTIONS = "Should the simulation wrap around the grid (y/n, r to reflect at the edges)? ";
+const string MENU = "a)nimate, t)ick, b)atch, q)uit? ";
 const string PROMPT_FRAME_NUMBER = "How many frames? ";
+const string PROMPT_BATCH_NUMBER = "How many generations? ";
+const string PROMPT_REFRESH_INTERVAL = "Refresh the display every how many generations (0 for the last one only)? ";
+const string PROMPT_SOUP_NUMBER = "How many soups? ";
+const string PROMPT_CENSUS_THREADS = "How many threads (0 for one per core)? ";
 const string ERROR = "Invalid choice; please try again.\n";
 const int PAUSE = 50;
+const int FRAME_INTERVAL = 16; //least number of milliseconds between two drawn frames (60 per second)
+#ifdef LIFE_STATS
+const string STATS_FILE = ""; //file the counters are appended to, "" for stderr
+#endif
 
 //Function declerations
-void displayGrid(Grid<string> &grid, LifeGUI &GUIgrid);
-void advanceGrid(Grid<string> &grid, bool wrapping, LifeGUI &GUIgrid);
-int countNeighbours(Grid<string> &grid, int row, int col, bool wrapping);
-void generateRandomGrid(Grid<string> &grid, LifeGUI &GUIgrid);
+void displayGrid(const BitGrid &grid, LifeGUI &GUIgrid, BitGrid &shown);
+FrameConsumer makePresenter(LifeGUI &GUIgrid, BitGrid &shown);
+void advanceGrid(BitGrid &grid, Boundary boundary, LifeGUI &GUIgrid, BitGrid &shown);
+void runBatch(BitGrid &grid, Boundary boundary, LifeGUI &GUIgrid, BitGrid &shown);
+void generateRandomGrid(BitGrid &grid, LifeGUI &GUIgrid);
+void runCensus();
+
+#ifdef LIFE_STATS
+LifeStats lifeStats; //counters of the generations of the grid
+#endif
 
 //main function of the program
 int main() {
@@ -62,12 +92,13 @@ int main() {
     string toPut;
     string wrap;
     string choice;
-    bool wrapAround;
+    Boundary boundary;
     bool random;
     int frameNo;
 
     //Displaying the intro welcome message
     cout << WELCOME_MESSAGE;
+    LIFE_STATS_ONLY(lifeStats.setOutput(STATS_FILE, STATS_DUMP_INTERVAL);)
 
     //Prompting a file and processing it
     random = false;
@@ -76,15 +107,25 @@ int main() {
         if (file == "random") { //additional code for random world generation
             random = true;
         }
+        else if (file == "census") { //additional code for the soup census
+            runCensus();
+            cout << "Have a nice Life!" << endl;
+            return 0;
+        }
         else if (!isFile(file)) {
             cout << FILE_ERROR;
         }
     } while (!isFile(file) && file != "random");
     LifeGUI GUIgrid; //Grid<string> grid;
-    Grid<string> grid;
+    BitGrid grid;
+    BitGrid shown; //the cells the GUI shows, empty until the first frame is drawn
     if (random) {
         generateRandomGrid(grid, GUIgrid);
     }
+    else if (isRLEFile(file)) {
+        loadRLE(file, grid);
+        GUIgrid.resize(grid.numRows(), grid.numCols());
+    }
     else {
         openFile(stream, file);
         //Constructing the grid, using the information in the file
@@ -96,43 +137,54 @@ int main() {
         for (int r = 0; r < grid.numRows(); r++) {
             getline(stream, toPut);
             for (int c = 0; c < grid.numCols(); c++) {
-                grid[r][c] = toPut[c];
+                grid.set(r, c, toPut[c] == 'X');
             }
         }
     }
     //Updating the grid and the menu options
     do {
         wrap = getLine(OPTIONS);
-        if (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n")) {
+        if (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n") && !equalsIgnoreCase(wrap, "r")) {
             cout << ERROR;
         }
-    } while (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n"));
+    } while (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n") && !equalsIgnoreCase(wrap, "r"));
     if (equalsIgnoreCase(wrap, "y")) {
-        wrapAround = true;
+        boundary = TOROIDAL_BOUNDARY;
     }
-    else if (equalsIgnoreCase(wrap, "n")) {
-        wrapAround = false;
+    else if (equalsIgnoreCase(wrap, "r")) {
+        boundary = REFLECTIVE_BOUNDARY;
     }
-    displayGrid(grid, GUIgrid);
+    else {
+        boundary = DEAD_BOUNDARY;
+    }
+    displayGrid(grid, GUIgrid, shown);
     do {
         choice = getLine(MENU);
         if (equalsIgnoreCase(choice, "a")) {
             //animating the pattern
             frameNo = getInteger(PROMPT_FRAME_NUMBER);
-            for (int i = 0; i < frameNo; i++) {
-                clearConsole();
-                advanceGrid(grid, wrapAround, GUIgrid);
-                pause(PAUSE);
-            }
+            FrameRenderer display(makePresenter(GUIgrid, shown), true, true);
+            display.present([&grid, boundary, frameNo, &display] {
+                for (int i = 1; i <= frameNo; i++) {
+                    grid.advance(boundary);
+                    LIFE_STATS_ONLY(lifeStats.record(grid.getStats());)
+                    display.submit(grid, i);
+                    this_thread::sleep_for(chrono::milliseconds(PAUSE));
+                }
+            });
         }
         else if (equalsIgnoreCase(choice, "t")) {
-            advanceGrid(grid, wrapAround, GUIgrid);
+            advanceGrid(grid, boundary, GUIgrid, shown);
+        }
+        else if (equalsIgnoreCase(choice, "b")) {
+            runBatch(grid, boundary, GUIgrid, shown);
         }
         else if (equalsIgnoreCase(choice, "q")) {}
         else {
             cout << ERROR;
         }
     } while (!equalsIgnoreCase(choice, "q"));
+    LIFE_STATS_ONLY(lifeStats.dump();)
 
     //ending message
     cout << "Have a nice Life!" << endl;
@@ -141,113 +193,110 @@ int main() {
 
 /**
  * @brief displayGrid Prints the parametrized grid to the console, also displays the GUI
- * representation of the grid.
+ * representation of the grid. The console text of the whole grid is written at once, while only
+ * the cells that differ from the grid the GUI shows are drawn again, found a word at a time.
  * @param grid The grid that will be printed.
  * @param GUIgrid The GUI reference of the grid, which will be displayed.
+ * @param shown The cells the GUI shows, updated to the grid. Every cell is drawn if its
+ * dimensions are not those of the grid.
  */
-void displayGrid(Grid<string> &grid, LifeGUI &GUIgrid) {
+void displayGrid(const BitGrid &grid, LifeGUI &GUIgrid, BitGrid &shown) {
+    string text;
+    text.reserve((size_t) grid.numRows() * (grid.numCols() + 1));
+    bool redraw = shown.numRows() != grid.numRows() || shown.numCols() != grid.numCols();
     for (int r = 0; r < grid.numRows(); r++) {
-        for (int c = 0; c < grid.numCols(); c++) {
-            cout << grid[r][c];
-            if (grid[r][c] == "X") {
-                GUIgrid.drawCell(r, c, true);
+        if (redraw) {
+            for (int c = 0; c < grid.numCols(); c++) {
+                GUIgrid.drawCell(r, c, grid.get(r, c));
             }
-            else if (grid[r][c] == "-") {
-                GUIgrid.drawCell(r, c, false);
+        } else {
+            int c = grid.findChange(shown, r, 0);
+            while (c < grid.numCols()) {
+                GUIgrid.drawCell(r, c, grid.get(r, c));
+                c = grid.findChange(shown, r, c + 1);
             }
         }
-        cout << endl;
+        text += grid.toString(r);
+        text += '\n';
     }
+    shown.copyCells(grid);
+    cout << text << flush;
+}
+
+/**
+ * @brief makePresenter Returns the consumer that displays a frame on the main thread and then
+ * waits until FRAME_INTERVAL milliseconds have passed since it started. The simulation runs on a
+ * thread of its own and does not wait meanwhile, the frames it hands over replace each other in
+ * the mailbox of the renderer and only the newest one is displayed next.
+ * @param GUIgrid The GUI reference of the grid, which will be displayed.
+ * @param shown The cells the GUI shows.
+ * @return The consumer.
+ */
+FrameConsumer makePresenter(LifeGUI &GUIgrid, BitGrid &shown) {
+    return [&GUIgrid, &shown](const BitGrid &frame, long long) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        clearConsole();
+        displayGrid(frame, GUIgrid, shown);
+        LIFE_STATS_ONLY(lifeStats.addDisplayTime(start);)
+        this_thread::sleep_until(start + chrono::milliseconds(FRAME_INTERVAL));
+    };
 }
 
 /**
  * @brief advanceGrid Advances the grid to the next generation based on a bunch of rules, prints it
  * to the console and displays it with a GUI.
  * @param grid The grid that will be advanced.
- * @param wrapping A bool type expression indicating whether the grid is wrapping around
- * itself or not.
+ * @param boundary What lies beyond the edges of the grid: dead cells, the opposite edge or a
+ * mirror image of the grid.
  * @param GUIgrid The GUI reference of the grid, which will be updated to its' next generation.
+ * @param shown The cells the GUI shows.
  */
-void advanceGrid(Grid<string> &grid, bool wrapping, LifeGUI &GUIgrid) {
-    Grid<int> counts(grid.numRows(), grid.numCols());
-    for (int r = 0; r < grid.numRows(); r++) {
-        for (int c = 0; c < grid.numCols(); c++) {
-            counts[r][c] = countNeighbours(grid, r, c, wrapping);
-        }
-    }
-    for (int r = 0; r < grid.numRows(); r++) {
-        for (int c = 0; c < grid.numCols(); c++) {
-            if (counts[r][c] <= 1 || counts[r][c] >= 4) {
-                GUIgrid.drawCell(r, c, false);
-                grid[r][c] = "-";
-            }
-            else if (counts[r][c] == 3) {
-                GUIgrid.drawCell(r, c, true);
-                grid[r][c] = "X";
-            }
-        }
-    }
-    displayGrid(grid, GUIgrid);
+void advanceGrid(BitGrid &grid, Boundary boundary, LifeGUI &GUIgrid, BitGrid &shown) {
+    grid.advance(boundary);
+    LIFE_STATS_START(clock);
+    displayGrid(grid, GUIgrid, shown);
+    LIFE_STATS_ONLY(lifeStats.addDisplayTime(clock);)
+    LIFE_STATS_ONLY(lifeStats.record(grid.getStats());)
 }
 
 /**
- * @brief countNeighbours Counts the neighbour cells of a specified one.
- * @param grid The grid that contains the cells.
- * @param row The row number of the specified cell.
- * @param col The column number of the specified cell.
- * @param wrapping A bool type expression indicating whether the grid is wrapping around
- * itself or not.
- * @return The number of neighbours of the specified cell.
+ * @brief runBatch Advances the grid by a number of generations as fast as possible. The
+ * simulation runs on a separate thread, while the main thread refreshes the console and the GUI
+ * only every given number of generations (and after the last one), a refresh that is still
+ * waiting when the next one is due is dropped. The
+ * throughput of the simulation is reported at the end. This one is a part of extensions.
+ * @param grid The grid that will be advanced.
+ * @param boundary What lies beyond the edges of the grid.
+ * @param GUIgrid The GUI reference of the grid, which will be refreshed.
+ * @param shown The cells the GUI shows.
  */
-int countNeighbours(Grid<string> &grid, int row, int col, bool wrapping) {
-    int count = 0;
-    if (!wrapping) {
-        for (int r = row - 1; r <= row + 1; r++) {
-            for (int c = col - 1; c <= col + 1; c++) {
-                if (row != r || col != c) {
-                    if (grid.inBounds(r, c)) {
-                        if (grid[r][c] == "X") {
-                            count++;
-                        }
-                    }
-                }
-            }
+void runBatch(BitGrid &grid, Boundary boundary, LifeGUI &GUIgrid, BitGrid &shown) {
+    int generations = getInteger(PROMPT_BATCH_NUMBER);
+    int interval;
+    do {
+        interval = getInteger(PROMPT_REFRESH_INTERVAL);
+        if (interval < 0) {
+            cout << ERROR;
         }
-    }
-    else {
-        int numRows = grid.numRows();
-        int numCols = grid.numCols();
-        for (int r = row - 1; r <= row + 1; r++) {
-            for (int c = col - 1; c <= col + 1; c++) {
-                if (row != r || col != c) {
-                    if (grid.inBounds(r, c)) {
-                        if (grid[r][c] == "X") {
-                            count++;
-                        }
-                    }
-                    else {
-                        if ((r == -1 || r == numRows) && (c == -1 || c == numCols)) {
-                            if (grid[(r + numRows) % numRows][(c + numCols) % numCols] == "X") {
-                                count++;
-                            }
-
-                        }
-                        else if (r == -1 || r == numRows) {
-                            if (grid[(r + numRows) % numRows][c] == "X") {
-                                count++;
-                            }
-                        }
-                        else if (c == -1 || c == numCols) {
-                            if (grid[r][(c + numCols) % numCols] == "X") {
-                                count++;
-                            }
-                        }
-                    }
-                }
+    } while (interval < 0);
+    FrameRenderer display(makePresenter(GUIgrid, shown), true, true);
+    double seconds = 0;
+    display.present([&grid, boundary, generations, interval, &display, &seconds] {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 1; i <= generations; i++) {
+            grid.advance(boundary);
+            LIFE_STATS_ONLY(lifeStats.record(grid.getStats());)
+            if (i == generations || (interval > 0 && i % interval == 0)) {
+                display.submit(grid, i);
             }
         }
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    });
+    cout << "Advanced " << max(generations, 0) << " generations in " << seconds << " seconds";
+    if (seconds > 0) {
+        cout << " (" << (long long) (max(generations, 0) / seconds) << " generations per second)";
     }
-    return count;
+    cout << "." << endl;
 }
 
 /**
@@ -256,7 +305,7 @@ int countNeighbours(Grid<string> &grid, int row, int col, bool wrapping) {
  * @param grid The referenced grid that will be randomly sized and filled.
  * @param GUIgrid The GUI reference of the grid that will be updated.
  */
-void generateRandomGrid(Grid<string> &grid, LifeGUI &GUIgrid) {
+void generateRandomGrid(BitGrid &grid, LifeGUI &GUIgrid) {
     int randomRow = randomInteger(1, 50);
     int randomCol = randomInteger(1, 50);
     GUIgrid.resize(randomRow, randomCol);
@@ -267,14 +316,42 @@ void generateRandomGrid(Grid<string> &grid, LifeGUI &GUIgrid) {
         for (int c = 0; c < grid.numCols(); c++) {
             if (randomInteger(1, 20) <= possibility) { //placing the living cells depending on the random
                 GUIgrid.drawCell(r, c, true);               //possibility
-                grid[r][c] = "X";
+                grid.set(r, c, true);
             }
             else {
                 GUIgrid.drawCell(r, c, false);
-                grid[r][c] = "-";
             }
         }
     }
 }
 
-
+/**
+ * @brief runCensus Searches a number of random soups in parallel, one thread per core by
+ * default, and prints the objects they settled into along with the number of soups searched per
+ * second. The seed is printed too, so the same census can be run again. This one is a part of
+ * extensions.
+ */
+void runCensus() {
+    int soups;
+    int threads;
+    do {
+        soups = getInteger(PROMPT_SOUP_NUMBER);
+        if (soups < 1) {
+            cout << ERROR;
+        }
+    } while (soups < 1);
+    do {
+        threads = getInteger(PROMPT_CENSUS_THREADS);
+        if (threads < 0) {
+            cout << ERROR;
+        }
+    } while (threads < 0);
+    if (threads == 0) {
+        threads = max(1, (int) thread::hardware_concurrency());
+    }
+    uint64_t seed = ((uint64_t) randomInteger(0, 1 << 30) << 30) | (uint64_t) randomInteger(0, (1 << 30) - 1);
+    cout << "Searching " << soups << " soups with the seed " << seed << "..." << endl;
+    SoupCensus census;
+    census.run(soups, threads, seed);
+    census.report(cout);
+}
@@ -3,18 +3,36 @@
   * a simulation for modelling the life cycle of bacteria using a two-dimensional grid
   * of cells. The game simulates the birth and death of future generations based on
   * an initial pattern and some simple rules. The code involves variables and fuctions
-  * to model the game.
+  * to model the game. The colony is stored in a BitGrid (one bit per cell), which advances
+  * up to 256 cells at a time with the SIMD row kernel picked for the processor. The colony
+  * can also live on an unbounded plane made of 64x64 chunks, in which case the rectangle of
+  * the input file is only the window that is printed. Besides the grid files, patterns in the
+  * RLE format (*.rle) can be loaded and every generation can be written as an RLE pattern.
+  * Long runs can be saved to and resumed from binary checkpoints (*.ckpt), which the batch mode
+  * writes on a separate thread every given number of generations.
+  * Besides the rule of the Game of Life (B3/S23), any Life-like rule can be given as a
+  * rulestring (e.g. B36/S23), which the row kernels turn into bit-sliced logic.
+  * The frames are rendered by a separate thread, and a headless batch mode runs any number of
+  * generations without a display, writing only the requested snapshots. Both stop computing
+  * once the colony becomes a still life or an oscillator, whose later generations are known.
+  * Built with -DLIFE_STATS, the population, births, deaths and bounding box of every generation
+  * of the grid and the time spent stepping and displaying it are dumped to stderr (or to
+  * STATS_FILE) every STATS_DUMP_INTERVAL generations.
   * @author EFE ACER
   * CS106B - Section Leader: Ryan Kurohara
   */
 
 //necessary includes
+#include <algorithm>
+#include <chrono>
 #include <cctype>
 #include <cmath>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include "console.h"
 #include "filelib.h"
 #include "grid.h"
@@ -22,6 +40,14 @@
 #include "simpio.h"
 #include "strlib.h"
 #include "lifegui.h"
+#include "bitgrid.h"
+#include "chunkeduniverse.h"
+#include "checkpoint.h"
+#include "cycledetector.h"
+#include "framerenderer.h"
+#include "hashlife.h"
+#include "lifestats.h"
+#include "rle.h"
 using namespace std;
 
 //Constant declerations (for further changes)
@@ -31,19 +57,51 @@ const string WELCOME_MESSAGE = "Welcome to the CS 106B Game of Life,\n"
                                "- A cell with 1 or fewer neighbors dies.\n"
                                "- Locations with 2 neighbors remain stable.\n"
                                "- Locations with 3 neighbors will create life.\n"
-                               "- A cell with 4 or more neighbors dies.\n\n";
+                               "- A cell with 4 or more neighbors dies.\n"
+                               "Other Life-like rules, such as HighLife (B36/S23), can be chosen too.\n\n";
 const string PROMPT_FILE = "Grid input file name? ";
 const string FILE_ERROR = "Unable to open that file.  Try again.\n";
-const string OPTIONS = "Should the simulation wrap around the grid (y/n)? ";
-const string MENU = "a)nimate, t)ick, q)uit? ";
+const string PROMPT_RULE = "Rule (e.g. B36/S23, B3678/S34678 or B2/S; Enter keeps ";
+const string OPTIONS = "Should the simulation wrap around the grid (y/n, r to reflect at the edges, u for an unbounded plane)? ";
+const string PROMPT_THREADS = "How many threads (0 to use every core)? ";
+const string TRACKING = "Only recompute the parts of the grid that change (y/n)? ";
+const string LOOKUP_TABLE = "Advance the grid with the 4x4 lookup table instead of the row kernel (y/n)? ";
+const string MENU = "a)nimate, t)ick, s)kip, b)atch, w)rite, q)uit? ";
 const string PROMPT_FRAME_NUMBER = "How many frames? ";
+const string PROMPT_OUTPUT_FILE = "Output file name (*.rle for a pattern, *.ckpt for a checkpoint, "
+                                  "Enter to skip)? ";
+const string PROMPT_BATCH_NUMBER = "How many generations (nothing is displayed)? ";
+const string PROMPT_SNAPSHOT_INTERVAL = "Write a snapshot every how many generations (0 for the last one only)? ";
+const string PROMPT_SNAPSHOT_PREFIX = "Snapshot file name prefix? ";
+const string PROMPT_CHECKPOINT_INTERVAL = "Write a checkpoint every how many generations (0 for none)? ";
+const string PROMPT_CHECKPOINT_FILE = "Checkpoint file name (*.ckpt)? ";
+const string PROMPT_SKIP_NUMBER = "How many generations to skip? ";
+const string UNBOUNDED_NOTE = "(the plane is unbounded, only the rectangle of the file is printed)\n";
+const string B0_NOTE = "Rules with B0 bring the whole unbounded plane to life, only bounded grids can use them.\n";
+const size_t SKIP_MEMORY = 512 * 1024 * 1024; //memory cap of the HashLife node cache
 const string ERROR = "Invalid choice; please try again.\n";
 const int PAUSE = 50;
+#ifdef LIFE_STATS
+const string STATS_FILE = ""; //file the counters are appended to, "" for stderr
+#endif
 
 //Function declerations
-void displayGrid(Grid<string> &grid);
-void advanceGrid(Grid<string> &grid, bool wrapping);
-int countNeighbours(Grid<string> &grid, int row, int col, bool wrapping);
+void displayGrid(const BitGrid &grid);
+void advanceGrid(BitGrid &grid, Boundary boundary);
+void animate(const function<void()> &advance, const function<const BitGrid&()> &frame,
+             const function<uint64_t()> &hash, int frames);
+void runBatch(const function<void()> &advance, const function<const BitGrid&()> &snapshot,
+              const function<uint64_t()> &hash, long long &generation, bool checkpoints);
+void reportCycle(int period, long long generation, long long skipped);
+void runUnbounded(BitGrid &grid);
+void displayUniverse(ChunkedUniverse &universe, BitGrid &window);
+void advanceUniverse(ChunkedUniverse &universe, BitGrid &window);
+void storeColony(const ChunkedUniverse &universe, BitGrid &colony);
+void writeGrid(const BitGrid &grid, long long generation, bool checkpoints);
+
+#ifdef LIFE_STATS
+LifeStats lifeStats; //counters of the generations of the grid
+#endif
 
 int main() {
     //Variables
@@ -52,67 +110,177 @@ int main() {
     string row;
     string col;
     string toPut;
+    string ruleString;
     string wrap;
+    string track;
+    string engine;
     string choice;
-    bool wrapAround;
+    Boundary boundary;
+    bool unbounded;
     int frameNo;
+    int skipNo;
+    int threads;
+    long long generation; //number of generations since the start of the run
 
     //Displaying the intro welcome message
     cout << WELCOME_MESSAGE;
+    LIFE_STATS_ONLY(lifeStats.setOutput(STATS_FILE, STATS_DUMP_INTERVAL);)
 
-    //Prompting a file and processing it
+    //Prompting a file and processing it, until one is loaded
+    BitGrid grid;
+    generation = 0;
+    bool loaded = false;
     do {
-        file = getLine(PROMPT_FILE);
-        if (!isFile(file)) {
-            cout << FILE_ERROR;
-        }
-    } while (!isFile(file));
-    openFile(stream, file);
-    //Constructing the grid, using the information in the file
-    getline(stream, row);
-    getline(stream, col);
-    Grid<string> grid(stringToInteger(row), stringToInteger(col));
-    //filling the grid accordingly
-    for (int r = 0; r < grid.numRows(); r++) {
-        getline(stream, toPut);
-        for (int c = 0; c < grid.numCols(); c++) {
-            grid[r][c] = toPut[c];
+        do {
+            file = getLine(PROMPT_FILE);
+            if (!isFile(file)) {
+                cout << FILE_ERROR;
+            }
+        } while (!isFile(file));
+        try {
+            if (isCheckpointFile(file)) {
+                //a checkpoint resumes a run, with its rule and its generation
+                generation = loadCheckpoint(file, grid);
+                cout << "Resuming the run at generation " << generation << "." << endl;
+            } else if (isRLEFile(file)) {
+                //the RLE patterns are decoded straight into the bits of the grid
+                loadRLE(file, grid);
+            } else {
+                openFile(stream, file);
+                //Constructing the grid, using the information in the file
+                getline(stream, row);
+                getline(stream, col);
+                grid.resize(stringToInteger(row), stringToInteger(col));
+                //filling the grid accordingly
+                for (int r = 0; r < grid.numRows(); r++) {
+                    getline(stream, toPut);
+                    for (int c = 0; c < grid.numCols(); c++) {
+                        grid.set(r, c, toPut[c] == 'X');
+                    }
+                }
+                stream.close();
+            }
+            loaded = true;
+        } catch (const char* message) {
+            cout << message << endl;
+        }
+    } while (!loaded);
+
+    //choosing the rule, an RLE pattern or a checkpoint may have given one already
+    while (true) {
+        ruleString = getLine(PROMPT_RULE + ruleToString(grid.getRule()) + ")? ");
+        if (ruleString.empty()) {
+            break;
+        }
+        try {
+            grid.setRule(parseRule(ruleString));
+            break;
+        } catch (const char* message) {
+            cout << message << endl;
         }
     }
 
     //Updating the grid and the menu options
     do {
         wrap = getLine(OPTIONS);
-        if (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n")) {
+        if (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n") && !equalsIgnoreCase(wrap, "r")
+            && !equalsIgnoreCase(wrap, "u")) {
             cout << ERROR;
+        } else if (equalsIgnoreCase(wrap, "u") && ruleBirthsFromNothing(grid.getRule())) {
+            cout << B0_NOTE;
+            wrap = "";
         }
-    } while (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n"));
+    } while (!equalsIgnoreCase(wrap, "y") && !equalsIgnoreCase(wrap, "n") && !equalsIgnoreCase(wrap, "r")
+             && !equalsIgnoreCase(wrap, "u"));
     if (equalsIgnoreCase(wrap, "y")) {
-        wrapAround = true;
+        boundary = TOROIDAL_BOUNDARY;
+    }
+    else if (equalsIgnoreCase(wrap, "r")) {
+        boundary = REFLECTIVE_BOUNDARY;
+    }
+    else {
+        boundary = DEAD_BOUNDARY;
+    }
+    unbounded = equalsIgnoreCase(wrap, "u");
+    if (unbounded) {
+        runUnbounded(grid);
+        cout << "Have a nice Life!" << endl;
+        return 0;
     }
-    else if (equalsIgnoreCase(wrap, "n")) {
-        wrapAround = false;
+    //splitting the grid into horizontal bands advanced by parallel threads
+    do {
+        threads = getInteger(PROMPT_THREADS);
+        if (threads < 0) {
+            cout << ERROR;
+        }
+    } while (threads < 0);
+    if (threads == 0) {
+        threads = max(1, (int) thread::hardware_concurrency());
     }
+    grid.setThreadCount(threads);
+    //tracking the tiles of the grid so that the stable parts are not recomputed
+    do {
+        track = getLine(TRACKING);
+        if (!equalsIgnoreCase(track, "y") && !equalsIgnoreCase(track, "n")) {
+            cout << ERROR;
+        }
+    } while (!equalsIgnoreCase(track, "y") && !equalsIgnoreCase(track, "n"));
+    grid.setTracking(equalsIgnoreCase(track, "y"));
+    //choosing the stepping engine, both give the same generations
+    do {
+        engine = getLine(LOOKUP_TABLE);
+        if (!equalsIgnoreCase(engine, "y") && !equalsIgnoreCase(engine, "n")) {
+            cout << ERROR;
+        }
+    } while (!equalsIgnoreCase(engine, "y") && !equalsIgnoreCase(engine, "n"));
+    grid.setLookupTable(equalsIgnoreCase(engine, "y"));
     displayGrid(grid);
     do {
         choice = getLine(MENU);
         if (equalsIgnoreCase(choice, "a")) {
             //animating the pattern
             frameNo = getInteger(PROMPT_FRAME_NUMBER);
-            for (int i = 0; i < frameNo; i++) {
-                clearConsole();
-                advanceGrid(grid, wrapAround);
-                pause(PAUSE);
+            animate([&grid, boundary] {
+                        grid.advance(boundary);
+                        LIFE_STATS_ONLY(lifeStats.record(grid.getStats());)
+                    },
+                    [&grid]() -> const BitGrid& { return grid; }, [&grid] { return grid.hash(); }, frameNo);
+            generation += max(frameNo, 0);
+            if (grid.isTracking() && grid.getTotalTiles() > 0) {
+                cout << "Skipped " << 100 * grid.getTotalTilesSkipped() / grid.getTotalTiles()
+                     << "% of the tiles so far." << endl;
             }
         }
         else if (equalsIgnoreCase(choice, "t")) {
-            advanceGrid(grid, wrapAround);
+            advanceGrid(grid, boundary);
+            generation++;
+        }
+        else if (equalsIgnoreCase(choice, "s")) {
+            //jumping ahead with HashLife while the colony is far from the edges of the grid
+            skipNo = getInteger(PROMPT_SKIP_NUMBER);
+            if (skipNo > 0) {
+                skipGrid(grid, boundary, skipNo, SKIP_MEMORY);
+                generation += skipNo;
+            }
+            displayGrid(grid);
+        }
+        else if (equalsIgnoreCase(choice, "b")) {
+            runBatch([&grid, boundary] {
+                         grid.advance(boundary);
+                         LIFE_STATS_ONLY(lifeStats.record(grid.getStats());)
+                     },
+                     [&grid]() -> const BitGrid& { return grid; }, [&grid] { return grid.hash(); },
+                     generation, true);
+        }
+        else if (equalsIgnoreCase(choice, "w")) {
+            writeGrid(grid, generation, true);
         }
         else if (equalsIgnoreCase(choice, "q")) {}
         else {
             cout << ERROR;
         }
     } while (!equalsIgnoreCase(choice, "q"));
+    LIFE_STATS_ONLY(lifeStats.dump();)
 
     //ending message
     cout << "Have a nice Life!" << endl;
@@ -123,100 +291,325 @@ int main() {
  * @brief displayGrid Prints the parametrized grid to the console.
  * @param grid The grid that will be printed.
  */
-void displayGrid(Grid<string> &grid) {
+void displayGrid(const BitGrid &grid) {
+    string text; //the whole grid is written at once, the console is flushed only once per frame
+    text.reserve((size_t) grid.numRows() * (grid.numCols() + 1));
     for (int r = 0; r < grid.numRows(); r++) {
-        for (int c = 0; c < grid.numCols(); c++) {
-            cout << grid[r][c];
-        }
-        cout << endl;
+        text += grid.toString(r);
+        text += '\n';
     }
+    cout << text << flush;
 }
 
 /**
  * @brief advanceGrid Advances the grid to the next generation based on a bunch of rules.
+ * The neighbours of up to 256 cells are counted at once by the bit-packed grid.
  * @param grid The grid that will be advanced.
- * @param wrapping A bool type expression indicating whether the grid is wrapping around
- * itself or not.
+ * @param boundary What lies beyond the edges of the grid: dead cells, the opposite edge or a
+ * mirror image of the grid.
  */
-void advanceGrid(Grid<string> &grid, bool wrapping) {
-    Grid<int> counts(grid.numRows(), grid.numCols());
-    for (int r = 0; r < grid.numRows(); r++) {
-        for (int c = 0; c < grid.numCols(); c++) {
-            counts[r][c] = countNeighbours(grid, r, c, wrapping);
+void advanceGrid(BitGrid &grid, Boundary boundary) {
+    grid.advance(boundary);
+    LIFE_STATS_START(clock);
+    displayGrid(grid);
+    LIFE_STATS_ONLY(lifeStats.addDisplayTime(clock);)
+    LIFE_STATS_ONLY(lifeStats.record(grid.getStats());)
+}
+
+/**
+ * @brief animate Advances the colony frame by frame. The colony is advanced by a separate thread
+ * while the main thread prints the frames, so a slow console only makes the animation drop frames
+ * instead of slowing the simulation down.
+ * Once the colony repeats itself, the animation stops and jumps straight to the last frame, which
+ * is the frame of the cycle the remaining number of frames leads to.
+ * @param advance Advances the colony to the next generation.
+ * @param frame Returns the grid to print for the current generation.
+ * @param hash Returns the hash of the current generation.
+ * @param frames The number of generations to animate.
+ */
+void animate(const function<void()> &advance, const function<const BitGrid&()> &frame,
+             const function<uint64_t()> &hash, int frames) {
+    FrameRenderer console([](const BitGrid &grid, long long) {
+        LIFE_STATS_START(clock);
+        clearConsole();
+        displayGrid(grid);
+        LIFE_STATS_ONLY(lifeStats.addDisplayTime(clock);)
+    }, true, true);
+    int period = 0;
+    int i;
+    int remaining = 0;
+    console.present([&] {
+        CycleDetector cycles;
+        cycles.check(hash);
+        for (i = 1; i <= frames && period == 0; i++) {
+            advance();
+            period = cycles.check(hash);
+            console.submit(frame(), i);
+            this_thread::sleep_for(chrono::milliseconds(PAUSE));
         }
-    }
-    for (int r = 0; r < grid.numRows(); r++) {
-        for (int c = 0; c < grid.numCols(); c++) {
-            if (counts[r][c] <= 1 || counts[r][c] >= 4) {
-                grid.set(r, c, "-");
-            }
-            else if (counts[r][c] == 3) {
-                grid.set(r, c, "X");
+        remaining = frames - (i - 1);
+        if (period > 0 && remaining > 0) {
+            for (int j = 0; j < remaining % period; j++) {
+                advance();
             }
+            console.submit(frame(), frames);
         }
+    });
+    if (period > 0) {
+        reportCycle(period, i - 1, remaining);
     }
-    displayGrid(grid);
 }
 
 /**
- * @brief countNeighbours Counts the neighbour cells of a specified one.
- * @param grid The grid that contains the cells.
- * @param row The row number of the specified cell.
- * @param col The column number of the specified cell.
- * @param wrapping A bool type expression indicating whether the grid is wrapping around
- * itself or not.
- * @return The number of neighbours of the specified cell.
+ * @brief runBatch Advances the colony by a number of generations without displaying anything.
+ * A snapshot of the colony is written as an RLE pattern every given number of generations and
+ * after the last one, and a checkpoint every given number of generations. The snapshots and the
+ * checkpoints are written by separate threads while the simulation goes on, so a checkpoint only
+ * costs the simulation a copy of the grid, then the throughput of the simulation is reported.
+ * Once the colony repeats itself, only the generations that are written are computed, each one
+ * less than a period away from the last.
+ * @param advance Advances the colony to the next generation.
+ * @param snapshot Returns the grid to write for the current generation.
+ * @param hash Returns the hash of the current generation.
+ * @param generation The generation of the colony since the start of the run, which names the
+ * snapshots and is saved in the checkpoints. It is advanced with the colony.
+ * @param checkpoints True if checkpoints of the snapshot grid may be written.
  */
-int countNeighbours(Grid<string> &grid, int row, int col, bool wrapping) {
-    int count = 0;
-    if (!wrapping) {
-        for (int r = row - 1; r <= row + 1; r++) {
-            for (int c = col - 1; c <= col + 1; c++) {
-                if (row != r || col != c) {
-                    if (grid.inBounds(r, c)) {
-                        if (grid[r][c] == "X") {
-                            count++;
-                        }
-                    }
-                }
+void runBatch(const function<void()> &advance, const function<const BitGrid&()> &snapshot,
+              const function<uint64_t()> &hash, long long &generation, bool checkpoints) {
+    int generations = getInteger(PROMPT_BATCH_NUMBER);
+    int interval;
+    do {
+        interval = getInteger(PROMPT_SNAPSHOT_INTERVAL);
+        if (interval < 0) {
+            cout << ERROR;
+        }
+    } while (interval < 0);
+    string prefix = getLine(PROMPT_SNAPSHOT_PREFIX);
+    int checkpointInterval = 0;
+    string checkpointFile;
+    if (checkpoints) {
+        do {
+            checkpointInterval = getInteger(PROMPT_CHECKPOINT_INTERVAL);
+            if (checkpointInterval < 0) {
+                cout << ERROR;
             }
+        } while (checkpointInterval < 0);
+        if (checkpointInterval > 0) {
+            checkpointFile = getLine(PROMPT_CHECKPOINT_FILE);
         }
     }
-    else {
-        int numRows = grid.numRows();
-        int numCols = grid.numCols();
-        for (int r = row - 1; r <= row + 1; r++) {
-            for (int c = col - 1; c <= col + 1; c++) {
-                if (row != r || col != c) {
-                    if (grid.inBounds(r, c)) {
-                        if (grid[r][c] == "X") {
-                            count++;
-                        }
-                    }
-                    else {
-                        if ((r == -1 || r == numRows) && (c == -1 || c == numCols)) {
-                            if (grid[(r + numRows) % numRows][(c + numCols) % numCols] == "X") {
-                                count++;
-                            }
-
-                        }
-                        else if (r == -1 || r == numRows) {
-                            if (grid[(r + numRows) % numRows][c] == "X") {
-                                count++;
-                            }
-                        }
-                        else if (c == -1 || c == numCols) {
-                            if (grid[r][(c + numCols) % numCols] == "X") {
-                                count++;
-                            }
-                        }
-                    }
-                }
+    long long first = generation; //generation of the colony before the batch
+    //a file that cannot be written is reported and the batch goes on
+    FrameRenderer writer([&prefix](const BitGrid &grid, long long generation) {
+        try {
+            saveRLE(prefix + "-" + to_string(generation) + ".rle", grid);
+        } catch (const char* message) {
+            cout << message << endl;
+        }
+    }, false);
+    //a checkpoint that is still waiting to be written is replaced by the next one
+    FrameRenderer checkpointWriter([&checkpointFile](const BitGrid &grid, long long generation) {
+        try {
+            saveCheckpoint(checkpointFile, grid, generation);
+        } catch (const char* message) {
+            cout << message << endl;
+        }
+    }, true);
+    CycleDetector cycles;
+    cycles.check(hash);
+    int period = 0;
+    int current = 0; //generation of the colony
+    int detected = 0; //generation the repetition was detected at
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 1; i <= generations; i++) {
+        bool written = i == generations || (interval > 0 && i % interval == 0);
+        bool saved = checkpointInterval > 0 && (first + i) % checkpointInterval == 0;
+        if (period == 0) {
+            advance();
+            current = i;
+            period = cycles.check(hash);
+            detected = i;
+        } else if (written || saved) {
+            //the colony at generation i is the colony (i - current) % period generations ahead
+            for (int j = 0; j < (i - current) % period; j++) {
+                advance();
             }
+            current = i;
+        } else {
+            continue;
         }
+        if (written) {
+            writer.submit(snapshot(), first + i);
+        }
+        if (saved) {
+            checkpointWriter.submit(snapshot(), first + i);
+        }
+    }
+    generation = first + max(generations, 0);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    writer.flush();
+    checkpointWriter.flush();
+    cout << "Advanced " << max(generations, 0) << " generations in " << seconds << " seconds";
+    if (seconds > 0) {
+        cout << " (" << (long long) (max(generations, 0) / seconds) << " generations per second)";
     }
-    return count;
+    cout << ", wrote " << writer.getFramesRendered() << " snapshots";
+    if (checkpointInterval > 0) {
+        cout << " and " << checkpointWriter.getFramesRendered() << " checkpoints";
+    }
+    cout << "." << endl;
+    if (period > 0) {
+        reportCycle(period, detected, generations - detected);
+    }
+}
+
+/**
+ * @brief reportCycle Tells the user that the colony repeats itself.
+ * @param period The period of the colony, 1 for a still life.
+ * @param generation The generation the repetition was detected at.
+ * @param skipped The number of generations that were not computed one by one.
+ */
+void reportCycle(int period, long long generation, long long skipped) {
+    if (period == 1) {
+        cout << "The colony became a still life";
+    } else {
+        cout << "The colony became an oscillator of period " << period;
+    }
+    cout << " (detected at generation " << generation << "), " << skipped
+         << " generations were fast-forwarded." << endl;
+}
+
+/**
+ * @brief runUnbounded Runs the menu of the simulation on an unbounded plane. The cells of the
+ * grid are placed at the same coordinates on the plane and the grid is reused as the window
+ * that is printed, so the colony can grow beyond it without running into an edge.
+ * @param grid The initial pattern, also the printed window of the plane.
+ */
+void runUnbounded(BitGrid &grid) {
+    ChunkedUniverse universe;
+    string choice;
+    int frameNo;
+    int skipNo;
+    universe.load(grid);
+    cout << UNBOUNDED_NOTE;
+    displayUniverse(universe, grid);
+    do {
+        choice = getLine(MENU);
+        if (equalsIgnoreCase(choice, "a")) {
+            //animating the pattern
+            frameNo = getInteger(PROMPT_FRAME_NUMBER);
+            animate([&universe] { universe.advance(); },
+                    [&universe, &grid]() -> const BitGrid& { universe.store(grid, 0, 0); return grid; },
+                    [&universe] { return universe.hash(); }, frameNo);
+            cout << "Population " << universe.getPopulation() << " in " << universe.getChunkCount()
+                 << " chunks." << endl;
+        }
+        else if (equalsIgnoreCase(choice, "t")) {
+            advanceUniverse(universe, grid);
+        }
+        else if (equalsIgnoreCase(choice, "s")) {
+            //both universes are unbounded, so no cell is lost by the skip
+            skipNo = getInteger(PROMPT_SKIP_NUMBER);
+            if (skipNo > 0) {
+                HashLife skipper(SKIP_MEMORY);
+                skipper.load(universe);
+                try {
+                    skipper.advance(skipNo);
+                    skipper.store(universe);
+                } catch (const char* message) {
+                    cout << message << endl; //the plane is left as it was
+                }
+            }
+            displayUniverse(universe, grid);
+        }
+        else if (equalsIgnoreCase(choice, "b")) {
+            //the snapshots hold the whole colony, wherever it is on the plane
+            //a checkpoint holds a bounded grid rather than the plane, so none are written
+            BitGrid colony;
+            long long generation = universe.getGeneration();
+            runBatch([&universe] { universe.advance(); },
+                     [&universe, &colony]() -> const BitGrid& { storeColony(universe, colony); return colony; },
+                     [&universe] { return universe.hash(); }, generation, false);
+        }
+        else if (equalsIgnoreCase(choice, "w")) {
+            //writing the bounding box of the colony, wherever it is on the plane
+            //the plane is always written as a pattern
+            BitGrid colony;
+            storeColony(universe, colony);
+            writeGrid(colony, universe.getGeneration(), false);
+        }
+        else if (equalsIgnoreCase(choice, "q")) {}
+        else {
+            cout << ERROR;
+        }
+    } while (!equalsIgnoreCase(choice, "q"));
 }
 
+/**
+ * @brief displayUniverse Prints the window of the plane to the console, followed by the
+ * population and the number of chunks holding it.
+ * @param universe The plane that will be printed.
+ * @param window The grid the rectangle of the plane at the origin is copied into.
+ */
+void displayUniverse(ChunkedUniverse &universe, BitGrid &window) {
+    universe.store(window, 0, 0);
+    displayGrid(window);
+    cout << "Population " << universe.getPopulation() << " in " << universe.getChunkCount()
+         << " chunks." << endl;
+}
 
+/**
+ * @brief advanceUniverse Advances the plane to the next generation and prints its window.
+ * @param universe The plane that will be advanced.
+ * @param window The grid the rectangle of the plane at the origin is copied into.
+ */
+void advanceUniverse(ChunkedUniverse &universe, BitGrid &window) {
+    universe.advance();
+    displayUniverse(universe, window);
+}
 
+/**
+ * @brief storeColony Copies the bounding box of the living cells of the plane into a grid.
+ * @param universe The plane to copy.
+ * @param colony The grid, resized to the bounding box (or to nothing if the plane is empty).
+ */
+void storeColony(const ChunkedUniverse &universe, BitGrid &colony) {
+    long long top, left, bottom, right;
+    if (!universe.getBounds(top, left, bottom, right)) {
+        colony.resize(0, 0);
+        return;
+    }
+    if (colony.numRows() != bottom - top + 1 || colony.numCols() != right - left + 1) {
+        colony.resize(bottom - top + 1, right - left + 1);
+    }
+    universe.store(colony, top, left);
+}
+
+/**
+ * @brief writeGrid Asks for the name of an output file and writes the grid in it, as a
+ * checkpoint if the name ends with .ckpt and checkpoints are allowed, as an RLE pattern
+ * otherwise. A file that cannot be written is reported and another name is asked for, until
+ * the grid is written or the name is empty.
+ * @param grid The grid to write.
+ * @param generation The generation of the grid, saved in a checkpoint.
+ * @param checkpoints True if the grid may be written as a checkpoint.
+ */
+void writeGrid(const BitGrid &grid, long long generation, bool checkpoints) {
+    while (true) {
+        string output = getLine(PROMPT_OUTPUT_FILE);
+        if (output.empty()) {
+            break;
+        }
+        try {
+            if (checkpoints && isCheckpointFile(output)) {
+                saveCheckpoint(output, grid, generation);
+            } else {
+                saveRLE(output, grid);
+            }
+            break;
+        } catch (const char* message) {
+            cout << message << endl;
+        }
+    }
+}
@@ -0,0 +1,532 @@
+/**
+  * LIFE - BENCHMARK
+  * This program measures how fast the Game of Life engines advance a colony. It runs the colony
+  * of mycolony.txt and random soups of 64x64 up to 32768x32768 cells, with toroidal, dead and
+  * reflective boundaries, through every engine and prints one JSON object per line for every
+  * run, e.g.
+  *   {"engine":"bitgrid-avx2","pattern":"soup","rows":4096,"cols":4096,"boundary":"toroidal",...}
+  * with the generations per second, the cells per second, the resident memory of the process
+  * while the engine runs, its peak so far and the percentiles of the time a single advance takes (a
+  * generation, HASHLIFE_STEP of them for HashLife). Only the engine being measured holds a copy of
+  * the colony, it is built right before its run and freed right after it. The engines are the
+  * original Grid<string> algorithm (as the baseline, on the smaller grids only), the BitGrid with
+  * every row kernel the processor supports, the BitGrid stepped by the 4x4 lookup table, the
+  * BitGrid on every core, the BitGrid tracking its tiles, the BitGrid with other Life-like rules,
+  * both those with kernels of their own and one read at runtime, which should all keep up with the
+  * Game of Life, the tile processes of lifetiles.cpp on every core, HashLife skipping HASHLIFE_STEP
+  * generations at a time as the s)kip command of life.cpp does (on the grids up to
+  * HASHLIFE_LARGEST_SIZE, whose nodes fit in its cache) and the chunked plane of the unbounded
+  * mode, which has no boundary and runs once per colony ("boundary":"unbounded"). The memory of the
+  * tile processes is the one of the coordinator, the tiles are held by the worker processes. Any
+  * new engine should be added here and compared against them.
+  * The soup census is measured last, on a single thread and on every core, in soups per second
+  * and soups per second per core.
+  * The program does not use the console/GUI libraries, so it can be built on its own, e.g.
+  *   g++ -O2 -std=c++11 -pthread lifebench.cpp bitgrid.cpp bandworkers.cpp lifekernel.cpp
+  *       lifekernel_sse2.cpp lifekernel_avx2.cpp lifetable.cpp liferule.cpp
+  *       chunkeduniverse.cpp soupcensus.cpp hashlife.cpp cycledetector.cpp tileprocesses.cpp
+  *       checkpoint.cpp mappedfile.cpp -o lifebench
+  * and run as "lifebench [pattern file] [largest size] [seconds per run]".
+  * @author EFE ACER
+  * CS106B - Section Leader: Ryan Kurohara
+  */
+
+//necessary includes
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "bitgrid.h"
+#include "checkpoint.h"
+#include "chunkeduniverse.h"
+#include "hashlife.h"
+#include "soupcensus.h"
+#include "tileprocesses.h"
+using namespace std;
+
+//Constant declerations (for further changes)
+const string DEFAULT_PATTERN = "mycolony.txt";
+const int SMALLEST_SIZE = 64;
+const int DEFAULT_LARGEST_SIZE = 32768;
+const int SIZE_STEP = 4; //every size is this many times the previous one, per side
+const int REFERENCE_LARGEST_SIZE = 1024; //the original algorithm is too slow for larger grids
+const int HASHLIFE_LARGEST_SIZE = 4096; //the nodes of larger soups do not fit in the cache
+const long long HASHLIFE_STEP = 1024; //generations HashLife skips at a time
+const double DEFAULT_SECONDS = 1.0; //time spent on a single run
+const int MIN_ADVANCES = 3; //every run advances the colony at least this many times
+const int MAX_ADVANCES = 100000;
+const uint64_t SOUP_SEED = 106; //the soups are the same on every run of the benchmark
+//rules benchmarked besides B3/S23, the last one has no kernel of its own
+const vector<string> BENCHMARK_RULES = {"B36/S23", "B3678/S34678", "B2/S", "B35678/S5678", "B345/S5"};
+const long long CENSUS_FIRST_SOUPS = 16; //the census doubles its soups until it runs long enough
+
+/**
+ * The kinds of engines, each holding its copy of the colony its own way.
+ */
+enum EngineKind {
+    REFERENCE_ENGINE, //the original engine, which has no BitGrid
+    BITGRID_ENGINE,
+    TILES_ENGINE, //a packed checkpoint of the colony, read by the tile processes
+    HASHLIFE_ENGINE, //a BitGrid skipped by HashLife
+    PLANE_ENGINE //the colony on an unbounded ChunkedUniverse
+};
+
+/**
+ * An engine under test. The BitGrid engines are set up on their own copy of the colony, which
+ * only exists during their run.
+ */
+struct Engine {
+    string name;
+    EngineKind kind;
+    function<void(BitGrid &grid)> setup; //picks the options of the copy of the colony
+};
+
+/**
+ * The original engine of life.cpp: a grid of "X"/"-" strings, whose neighbours are counted one by
+ * one into a grid of counts before the cells are updated.
+ */
+struct ReferenceGrid {
+    int rows;
+    int cols;
+    vector<string> cells; //row major, rows * cols strings
+    vector<int> counts;
+};
+
+//Function declerations
+void loadPattern(const string &file, BitGrid &grid);
+void fillSoup(BitGrid &grid, uint64_t seed);
+void loadReference(const BitGrid &grid, ReferenceGrid &reference);
+void advanceReference(ReferenceGrid &reference, Boundary boundary);
+int countReferenceNeighbours(const ReferenceGrid &reference, int row, int col, Boundary boundary);
+int referenceSource(int coordinate, int size, Boundary boundary);
+string boundaryName(Boundary boundary);
+vector<Engine> makeEngines(const BitGrid &colony);
+void runEngine(const Engine &engine, const string &pattern, const BitGrid &colony, Boundary boundary,
+               double seconds);
+void runBenchmark(const string &engine, const function<void()> &advance, long long step,
+                  const string &pattern, int rows, int cols, const string &boundary, double seconds);
+void benchmarkColony(const string &pattern, const BitGrid &colony, double seconds);
+void benchmarkCensus(int threads, double seconds);
+long peakMemoryKilobytes();
+long currentMemoryKilobytes();
+
+//main function of the program
+int main(int argc, char** argv) {
+    string file = (argc > 1) ? argv[1] : DEFAULT_PATTERN;
+    int largest = (argc > 2) ? atoi(argv[2]) : DEFAULT_LARGEST_SIZE;
+    double seconds = (argc > 3) ? atof(argv[3]) : DEFAULT_SECONDS;
+    try {
+        BitGrid colony;
+        loadPattern(file, colony);
+        benchmarkColony("mycolony", colony, seconds);
+        for (int size = SMALLEST_SIZE; size <= largest; size *= SIZE_STEP) {
+            BitGrid soup(size, size);
+            fillSoup(soup, SOUP_SEED + size);
+            benchmarkColony("soup", soup, seconds);
+        }
+        int cores = max(1, (int) thread::hardware_concurrency());
+        benchmarkCensus(1, seconds);
+        if (cores > 1) {
+            benchmarkCensus(cores, seconds);
+        }
+    } catch (const char* message) {
+        cerr << "lifebench: " << message << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief loadPattern Reads a colony in the text format of the grid files: the number of rows,
+ * the number of columns and then a line of "X"/"-" for every row.
+ * @param file The name of the grid file.
+ * @param grid The grid to fill.
+ */
+void loadPattern(const string &file, BitGrid &grid) {
+    ifstream stream(file.c_str());
+    string row;
+    string col;
+    string toPut;
+    if (!getline(stream, row) || !getline(stream, col)) {
+        throw("Unable to read the pattern file.");
+    }
+    grid.resize(atoi(row.c_str()), atoi(col.c_str()));
+    for (int r = 0; r < grid.numRows() && getline(stream, toPut); r++) {
+        for (int c = 0; c < grid.numCols() && c < (int) toPut.size(); c++) {
+            grid.set(r, c, toPut[c] == 'X');
+        }
+    }
+}
+
+/**
+ * @brief fillSoup Fills a grid with a random soup, every cell being alive with probability 1/2.
+ * The bits come from splitmix64, so the soup only depends on the seed, and they are set a run
+ * of living cells at a time.
+ * @param grid The grid to fill.
+ * @param seed The seed of the generator.
+ */
+void fillSoup(BitGrid &grid, uint64_t seed) {
+    for (int r = 0; r < grid.numRows(); r++) {
+        for (int c = 0; c < grid.numCols(); c += 64) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t bits = seed;
+            bits = (bits ^ (bits >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            bits = (bits ^ (bits >> 27)) * 0x94d049bb133111ebULL;
+            bits ^= bits >> 31;
+            int width = min(64, grid.numCols() - c);
+            int bit = 0;
+            while (bit < width) {
+                if (((bits >> bit) & 1) == 0) {
+                    bit++;
+                    continue;
+                }
+                int start = bit;
+                while (bit < width && ((bits >> bit) & 1)) {
+                    bit++;
+                }
+                grid.setRun(r, c + start, bit - start);
+            }
+        }
+    }
+}
+
+/**
+ * @brief loadReference Copies a colony into a grid of the original engine.
+ * @param grid The colony.
+ * @param reference The grid of the original engine.
+ */
+void loadReference(const BitGrid &grid, ReferenceGrid &reference) {
+    reference.rows = grid.numRows();
+    reference.cols = grid.numCols();
+    reference.cells.assign((size_t) reference.rows * reference.cols, "-");
+    reference.counts.assign((size_t) reference.rows * reference.cols, 0);
+    for (int r = 0; r < reference.rows; r++) {
+        for (int c = 0; c < reference.cols; c++) {
+            if (grid.get(r, c)) {
+                reference.cells[(size_t) r * reference.cols + c] = "X";
+            }
+        }
+    }
+}
+
+/**
+ * @brief advanceReference Advances a grid of the original engine to the next generation, the
+ * same way advanceGrid of life.cpp used to.
+ * @param reference The grid.
+ * @param boundary What lies beyond the edges of the grid.
+ */
+void advanceReference(ReferenceGrid &reference, Boundary boundary) {
+    for (int r = 0; r < reference.rows; r++) {
+        for (int c = 0; c < reference.cols; c++) {
+            reference.counts[(size_t) r * reference.cols + c] = countReferenceNeighbours(reference, r, c, boundary);
+        }
+    }
+    for (size_t i = 0; i < reference.cells.size(); i++) {
+        if (reference.counts[i] <= 1 || reference.counts[i] >= 4) {
+            reference.cells[i] = "-";
+        } else if (reference.counts[i] == 3) {
+            reference.cells[i] = "X";
+        }
+    }
+}
+
+/**
+ * @brief countReferenceNeighbours Counts the neighbour cells of a cell of a grid of the original
+ * engine, one neighbour at a time.
+ * @param reference The grid.
+ * @param row The row number of the cell.
+ * @param col The column number of the cell.
+ * @param boundary What lies beyond the edges of the grid.
+ * @return The number of neighbours of the cell.
+ */
+int countReferenceNeighbours(const ReferenceGrid &reference, int row, int col, Boundary boundary) {
+    int count = 0;
+    for (int r = row - 1; r <= row + 1; r++) {
+        for (int c = col - 1; c <= col + 1; c++) {
+            if (row == r && col == c) {
+                continue;
+            }
+            int neighbourRow = referenceSource(r, reference.rows, boundary);
+            int neighbourCol = referenceSource(c, reference.cols, boundary);
+            if (neighbourRow < 0 || neighbourCol < 0) {
+                continue;
+            }
+            if (reference.cells[(size_t) neighbourRow * reference.cols + neighbourCol] == "X") {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief referenceSource Maps a row or a column, which may be just outside the grid, to the row
+ * or column of the grid whose cell is there.
+ * @param coordinate The row or column, from -1 to size.
+ * @param size The number of rows or columns of the grid.
+ * @param boundary What lies beyond the edges of the grid.
+ * @return The row or column in the grid, -1 if there is a dead cell.
+ */
+int referenceSource(int coordinate, int size, Boundary boundary) {
+    if (coordinate >= 0 && coordinate < size) {
+        return coordinate;
+    } else if (boundary == TOROIDAL_BOUNDARY) {
+        return (coordinate + size) % size;
+    } else if (boundary == REFLECTIVE_BOUNDARY) {
+        return (coordinate < 0) ? 0 : size - 1;
+    }
+    return -1;
+}
+
+/**
+ * @brief boundaryName Returns the name of a boundary in the output.
+ * @param boundary The boundary.
+ * @return "toroidal", "dead" or "reflective".
+ */
+string boundaryName(Boundary boundary) {
+    if (boundary == TOROIDAL_BOUNDARY) {
+        return "toroidal";
+    } else if (boundary == REFLECTIVE_BOUNDARY) {
+        return "reflective";
+    }
+    return "dead";
+}
+
+/**
+ * @brief makeEngines Lists every engine for a colony, without copying the colony.
+ * @param colony The colony.
+ * @return The engines, the original one only for the smaller colonies.
+ */
+vector<Engine> makeEngines(const BitGrid &colony) {
+    vector<RowKernel> kernels;
+    kernels.push_back(scalarRowKernel);
+#ifdef LIFE_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        kernels.push_back(sse2RowKernel);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back(avx2RowKernel);
+    }
+#endif
+    int cores = max(1, (int) thread::hardware_concurrency());
+    string selected = rowKernelName(selectRowKernel());
+    vector<Engine> engines;
+    if (colony.numRows() <= REFERENCE_LARGEST_SIZE && colony.numCols() <= REFERENCE_LARGEST_SIZE) {
+        engines.push_back(Engine{"reference", REFERENCE_ENGINE, nullptr});
+    }
+    for (RowKernel kernel : kernels) {
+        engines.push_back(Engine{"bitgrid-" + rowKernelName(kernel), BITGRID_ENGINE,
+                                 [kernel](BitGrid &grid) {
+            grid.setKernel(kernel);
+        }});
+    }
+    engines.push_back(Engine{"bitgrid-lookup-table", BITGRID_ENGINE, [](BitGrid &grid) {
+        grid.setLookupTable(true);
+    }});
+    if (cores > 1) {
+        ostringstream name;
+        name << "bitgrid-" << selected << "-threads" << cores;
+        engines.push_back(Engine{name.str(), BITGRID_ENGINE, [cores](BitGrid &grid) {
+            grid.setThreadCount(cores);
+        }});
+    }
+    engines.push_back(Engine{"bitgrid-" + selected + "-tracking", BITGRID_ENGINE, [](BitGrid &grid) {
+        grid.setTracking(true);
+    }});
+    for (const string &rule : BENCHMARK_RULES) {
+        RuleMask mask = parseRule(rule);
+        engines.push_back(Engine{"bitgrid-" + selected + "-" + rule, BITGRID_ENGINE,
+                                 [mask](BitGrid &grid) {
+            grid.setRule(mask);
+        }});
+    }
+    engines.push_back(Engine{"tiles-processes" + to_string(cores), TILES_ENGINE, nullptr});
+    if (colony.numRows() <= HASHLIFE_LARGEST_SIZE && colony.numCols() <= HASHLIFE_LARGEST_SIZE) {
+        engines.push_back(Engine{"hashlife", HASHLIFE_ENGINE, nullptr});
+    }
+    engines.push_back(Engine{"chunked-universe", PLANE_ENGINE, nullptr});
+    return engines;
+}
+
+/**
+ * @brief benchmarkColony Runs every engine on a colony, with every boundary, the plane once.
+ * @param pattern The name of the colony in the output.
+ * @param colony The colony.
+ * @param seconds The time spent on a single run.
+ */
+void benchmarkColony(const string &pattern, const BitGrid &colony, double seconds) {
+    const Boundary boundaries[] = {TOROIDAL_BOUNDARY, DEAD_BOUNDARY, REFLECTIVE_BOUNDARY};
+    vector<Engine> engines = makeEngines(colony);
+    for (Boundary boundary : boundaries) {
+        for (const Engine &engine : engines) {
+            if (engine.kind != PLANE_ENGINE || boundary == boundaries[0]) {
+                runEngine(engine, pattern, colony, boundary, seconds);
+            }
+        }
+    }
+}
+
+/**
+ * @brief runEngine Copies the colony for an engine, runs the benchmark of the engine and frees
+ * the copy, so the memory of the process only holds the engine being measured.
+ * @param engine The engine.
+ * @param pattern The name of the colony.
+ * @param colony The colony.
+ * @param boundary What lies beyond the edges of the colony, ignored by the plane.
+ * @param seconds The time spent on the run.
+ */
+void runEngine(const Engine &engine, const string &pattern, const BitGrid &colony, Boundary boundary,
+               double seconds) {
+    int rows = colony.numRows();
+    int cols = colony.numCols();
+    if (engine.kind == REFERENCE_ENGINE) {
+        ReferenceGrid reference;
+        loadReference(colony, reference);
+        runBenchmark(engine.name, [&reference, boundary] {
+            advanceReference(reference, boundary);
+        }, 1, pattern, rows, cols, boundaryName(boundary), seconds);
+    } else if (engine.kind == BITGRID_ENGINE) {
+        BitGrid grid;
+        grid.copyCells(colony);
+        engine.setup(grid);
+        runBenchmark(engine.name, [&grid, boundary] {
+            grid.advance(boundary);
+        }, 1, pattern, rows, cols, boundaryName(boundary), seconds);
+    } else if (engine.kind == TILES_ENGINE) {
+        //the processes read their rows of a packed checkpoint, as lifetiles does
+        string checkpoint = "lifebench." + to_string(getpid()) + ".ckpt";
+        saveCheckpoint(checkpoint, colony, 0, false);
+        try {
+            TileProcesses tiles(checkpoint, max(1, (int) thread::hardware_concurrency()), boundary);
+            remove(checkpoint.c_str());
+            runBenchmark(engine.name, [&tiles] {
+                tiles.advance(1);
+            }, 1, pattern, rows, cols, boundaryName(boundary), seconds);
+        } catch (...) {
+            remove(checkpoint.c_str());
+            throw;
+        }
+    } else if (engine.kind == HASHLIFE_ENGINE) {
+        BitGrid grid;
+        grid.copyCells(colony);
+        runBenchmark(engine.name, [&grid, boundary] {
+            skipGrid(grid, boundary, HASHLIFE_STEP);
+        }, HASHLIFE_STEP, pattern, rows, cols, boundaryName(boundary), seconds);
+    } else {
+        ChunkedUniverse universe;
+        universe.load(colony);
+        runBenchmark(engine.name, [&universe] {
+            universe.advance();
+        }, 1, pattern, rows, cols, "unbounded", seconds);
+    }
+}
+
+/**
+ * @brief runBenchmark Advances the colony of an engine until the time of the run is up, timing
+ * every advance, and prints the results as a single line of JSON.
+ * @param engine The name of the engine.
+ * @param advance Advances the copy of the colony of the engine by step generations.
+ * @param step The number of generations of an advance, whose latency is measured.
+ * @param pattern The name of the colony.
+ * @param rows The number of rows of the colony.
+ * @param cols The number of columns of the colony.
+ * @param boundary The name of what lies beyond the edges of the colony.
+ * @param seconds The time spent on the run.
+ */
+void runBenchmark(const string &engine, const function<void()> &advance, long long step,
+                  const string &pattern, int rows, int cols, const string &boundary, double seconds) {
+    vector<double> latencies; //microseconds per advance
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    double elapsed = 0;
+    while ((int) latencies.size() < MAX_ADVANCES
+           && (elapsed < seconds || (int) latencies.size() < MIN_ADVANCES)) {
+        chrono::steady_clock::time_point before = chrono::steady_clock::now();
+        advance();
+        chrono::steady_clock::time_point after = chrono::steady_clock::now();
+        latencies.push_back(chrono::duration<double, micro>(after - before).count());
+        elapsed = chrono::duration<double>(after - start).count();
+    }
+    vector<double> sorted = latencies;
+    sort(sorted.begin(), sorted.end());
+    function<double(double)> percentile = [&sorted](double fraction) {
+        return sorted[min(sorted.size() - 1, (size_t) (fraction * sorted.size()))];
+    };
+    double generationsPerSecond = latencies.size() * step / elapsed;
+    cout << "{\"engine\":\"" << engine << "\",\"pattern\":\"" << pattern << "\""
+         << ",\"rows\":" << rows << ",\"cols\":" << cols
+         << ",\"boundary\":\"" << boundary << "\""
+         << ",\"generations\":" << latencies.size() * step
+         << ",\"generations_per_advance\":" << step
+         << ",\"seconds\":" << elapsed
+         << ",\"generations_per_second\":" << generationsPerSecond
+         << ",\"cells_per_second\":" << generationsPerSecond * rows * cols
+         << ",\"rss_kb\":" << currentMemoryKilobytes()
+         << ",\"peak_rss_kb\":" << peakMemoryKilobytes()
+         << ",\"latency_us\":{\"p50\":" << percentile(0.50) << ",\"p90\":" << percentile(0.90)
+         << ",\"p99\":" << percentile(0.99) << ",\"max\":" << sorted.back() << "}}" << endl;
+}
+
+/**
+ * @brief benchmarkCensus Runs soup censuses of twice as many soups each time until one takes
+ * the time of a run, and prints the throughput of the last one as a single line of JSON.
+ * @param threads The number of threads of the census.
+ * @param seconds The least time spent on the last census.
+ */
+void benchmarkCensus(int threads, double seconds) {
+    SoupCensus census;
+    long long soups = CENSUS_FIRST_SOUPS;
+    census.run(soups, threads, SOUP_SEED);
+    while (census.getSeconds() < seconds) {
+        soups *= 2;
+        census.run(soups, threads, SOUP_SEED);
+    }
+    double soupsPerSecond = soups / census.getSeconds();
+    cout << "{\"engine\":\"soup-census\",\"pattern\":\"soup\""
+         << ",\"rows\":" << SOUP_SIZE << ",\"cols\":" << SOUP_SIZE
+         << ",\"rule\":\"" << ruleToString(census.getRule()) << "\""
+         << ",\"threads\":" << threads
+         << ",\"soups\":" << soups
+         << ",\"seconds\":" << census.getSeconds()
+         << ",\"soups_per_second\":" << soupsPerSecond
+         << ",\"soups_per_second_per_core\":" << soupsPerSecond / threads
+         << ",\"peak_rss_kb\":" << peakMemoryKilobytes() << "}" << endl;
+}
+
+/**
+ * @brief peakMemoryKilobytes Returns the largest resident memory of the process so far.
+ * @return The peak resident set size in kilobytes.
+ */
+long peakMemoryKilobytes() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; //bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+/**
+ * @brief currentMemoryKilobytes Returns the resident memory of the process now, which unlike the
+ * peak drops again once an engine is freed.
+ * @return The resident set size in kilobytes, the peak where /proc is not available.
+ */
+long currentMemoryKilobytes() {
+    ifstream statm("/proc/self/statm");
+    long pages;
+    long resident;
+    if (!(statm >> pages >> resident)) {
+        return peakMemoryKilobytes();
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
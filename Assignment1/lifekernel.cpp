@@ -0,0 +1,153 @@
+/**
+ * @brief The following code involves the portable row kernels and the runtime selection of the
+ * fastest row kernel supported by the processor. The vectorized kernels can be found in
+ * lifekernel_sse2.cpp and lifekernel_avx2.cpp.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "lifekernel.h"
+#include "lifekernelimpl.h"
+
+/**
+ * @brief scalarRowKernel Computes the next generation of a part of a row, 64 cells at a time.
+ * @param above, current, below The first word to compute in the three rows.
+ * @param result The first word of the output row.
+ * @param count The number of words to compute.
+ * @param rule Unused, the kernel advances the board with the rule of the Game of Life.
+ */
+void scalarRowKernel(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                     uint64_t* result, int count, RuleMask rule) {
+    stepRow<ScalarLanes, ConwayRule>(above, current, below, result, count, rule);
+}
+
+/**
+ * @brief scalarRuleKernel Returns the portable row kernel for a rule.
+ * @param rule The rule.
+ * @return The row kernel, which advances 64 cells at a time.
+ */
+RowKernel scalarRuleKernel(RuleMask rule) {
+    if (rule == CONWAY_RULE) {
+        return scalarRowKernel;
+    }
+    return kernelForRule<ScalarLanes>(rule);
+}
+
+/**
+ * @brief detectRowKernel Checks which instruction sets the processor supports.
+ * @return The AVX2 kernel if available, else the SSE2 kernel if available, else the portable one.
+ */
+static RowKernel detectRowKernel() {
+    RowKernel kernel = scalarRowKernel;
+#ifdef LIFE_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        kernel = avx2RowKernel;
+    } else if (__builtin_cpu_supports("sse2")) {
+        kernel = sse2RowKernel;
+    }
+#endif
+    return kernel;
+}
+
+/**
+ * @brief selectRowKernel Returns the fastest row kernel the processor supports, checking the
+ * processor only once. The check initializes a static variable, which C++11 guarantees to
+ * happen once even if several threads call the function at the same time.
+ * @return The AVX2 kernel if available, else the SSE2 kernel if available, else the portable one.
+ */
+RowKernel selectRowKernel() {
+    static const RowKernel selected = detectRowKernel();
+    return selected;
+}
+
+/**
+ * @brief rowKernelForRule Returns the kernel for a rule that uses the same instruction set as
+ * another kernel.
+ * @param kernel A Game of Life kernel, e.g. the one returned by selectRowKernel.
+ * @param rule The rule.
+ * @return The kernel for the rule.
+ */
+RowKernel rowKernelForRule(RowKernel kernel, RuleMask rule) {
+#ifdef LIFE_X86_KERNELS
+    if (kernel == avx2RowKernel) {
+        return avx2RuleKernel(rule);
+    } else if (kernel == sse2RowKernel) {
+        return sse2RuleKernel(rule);
+    }
+#endif
+    return scalarRuleKernel(rule);
+}
+
+/**
+ * @brief rowKernelName Returns the name of the instruction set a row kernel uses.
+ * @param kernel The row kernel.
+ * @return "avx2", "sse2" or "scalar".
+ */
+string rowKernelName(RowKernel kernel) {
+#ifdef LIFE_X86_KERNELS
+    if (kernel == avx2RowKernel) {
+        return "avx2";
+    } else if (kernel == sse2RowKernel) {
+        return "sse2";
+    }
+#endif
+    return "scalar";
+}
+
+#ifdef LIFE_STATS
+
+/**
+ * @brief scalarCountKernel Counts the living, born and dead cells of a part of some rows, a word
+ * at a time.
+ * @param current The first word to count in the current generation of the first row.
+ * @param previous The first word to count in the previous generation of the first row.
+ * @param count The number of words to count in every row.
+ * @param rows The number of rows.
+ * @param stride The number of words from a row to the next one.
+ * @param columns The count words the words of every row are ORed into.
+ * @param counts The counts the cells are added to.
+ */
+void scalarCountKernel(const uint64_t* current, const uint64_t* previous, int count, int rows,
+                       int stride, uint64_t* columns, CellCounts &counts) {
+    for (int r = 0; r < rows; r++, current += stride, previous += stride) {
+        uint64_t any = 0;
+        for (int w = 0; w < count; w++) {
+            uint64_t changed = current[w] ^ previous[w];
+            any |= current[w];
+            columns[w] |= current[w];
+            if (current[w] != 0) {
+                counts.population += __builtin_popcountll(current[w]);
+            }
+            if (changed != 0) {
+                int born = __builtin_popcountll(changed & current[w]);
+                counts.births += born;
+                counts.deaths += __builtin_popcountll(changed) - born;
+            }
+        }
+        if (any != 0) {
+            if (counts.firstRow < 0) {
+                counts.firstRow = r;
+            }
+            counts.lastRow = r;
+        }
+    }
+}
+
+/**
+ * @brief countKernelFor Returns the count kernel that uses the same instruction set as a row
+ * kernel, SSE2 has no fast way to count bits so its row kernels get the portable one.
+ * @param kernel A Game of Life row kernel.
+ * @return The count kernel.
+ */
+CountKernel countKernelFor(RowKernel kernel) {
+#ifdef LIFE_X86_KERNELS
+    if (kernel == avx2RowKernel) {
+        return avx2CountKernel;
+    }
+#endif
+    return scalarCountKernel;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * @brief The header file declaring the row kernels that advance a bit-packed row of a Game of
+ * Life board by one generation. There is a portable kernel (64 cells per operation) and, on x86
+ * processors, SSE2 (128 cells) and AVX2 (256 cells) kernels, the best of which is picked at
+ * runtime. All kernels give bit-identical results. Every instruction set has kernels of its own
+ * for the most used rules, and any other Life-like rule gets one of 32 kernels that leave out
+ * the neighbour counts the rule kills every cell with.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "liferule.h"
+using namespace std;
+
+//the vectorized kernels need the GCC/Clang vector extensions and their x86 intrinsics
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LIFE_X86_KERNELS 1
+#endif
+
+/**
+ * A row kernel computes "count" words of the next generation of a row from the current
+ * generation of the row and of the rows above and below it. The words just before and just
+ * after the computed range (index -1 and index count) must be readable in the three input rows,
+ * they hold the west and east neighbours of the edge cells. The rule is only read by the kernels
+ * shared by the rules without a kernel of their own.
+ */
+typedef void (*RowKernel)(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                          uint64_t* result, int count, RuleMask rule);
+
+//the Game of Life (B3/S23) kernels
+void scalarRowKernel(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                     uint64_t* result, int count, RuleMask rule); //64 cells per operation, runs everywhere
+#ifdef LIFE_X86_KERNELS
+void sse2RowKernel(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                   uint64_t* result, int count, RuleMask rule); //128 cells per operation
+void avx2RowKernel(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                   uint64_t* result, int count, RuleMask rule); //256 cells per operation
+#endif
+
+//the kernels of an instruction set for any rule
+RowKernel scalarRuleKernel(RuleMask rule);
+#ifdef LIFE_X86_KERNELS
+RowKernel sse2RuleKernel(RuleMask rule);
+RowKernel avx2RuleKernel(RuleMask rule);
+#endif
+
+RowKernel selectRowKernel(); //returns the fastest Game of Life kernel the processor supports
+RowKernel rowKernelForRule(RowKernel kernel, RuleMask rule); //same instruction set, another rule
+string rowKernelName(RowKernel kernel); //returns "avx2", "sse2" or "scalar"
+
+#ifdef LIFE_STATS
+/**
+ * The cells counted by a count kernel.
+ */
+struct CellCounts {
+    long long population; //living cells
+    long long births; //cells that came alive since the previous generation
+    long long deaths; //cells that died since the previous generation
+    int firstRow; //first and last row with a living cell, counted from 0, -1 if there are none
+    int lastRow;
+};
+
+/**
+ * A count kernel counts the cells of "count" words of "rows" rows, "stride" words apart, for
+ * the instrumentation counters (see lifestats.h) and ORs the words of every row into "columns",
+ * which then has a bit set for every column with a living cell. The counts are added to those
+ * already in "counts", the rows are only updated if a row has a living cell.
+ */
+typedef void (*CountKernel)(const uint64_t* current, const uint64_t* previous, int count, int rows,
+                            int stride, uint64_t* columns, CellCounts &counts);
+
+void scalarCountKernel(const uint64_t* current, const uint64_t* previous, int count, int rows,
+                       int stride, uint64_t* columns, CellCounts &counts); //a word at a time
+#ifdef LIFE_X86_KERNELS
+void avx2CountKernel(const uint64_t* current, const uint64_t* previous, int count, int rows,
+                     int stride, uint64_t* columns, CellCounts &counts); //4 words at a time
+#endif
+
+CountKernel countKernelFor(RowKernel kernel); //the count kernel of the same instruction set
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @brief The following code involves the AVX2 row kernel, which advances 256 cells per
+ * operation, and the AVX2 count kernel of the instrumentation counters. The whole translation
+ * unit is compiled for AVX2, the kernels are only called after selectRowKernel has checked that
+ * the processor supports it.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "lifekernel.h"
+
+#ifdef LIFE_X86_KERNELS
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "lifekernelimpl.h"
+
+namespace {
+
+/**
+ * A lane type for the row loop that holds 4 words in a 256 bit register.
+ */
+struct Avx2Lanes {
+    typedef __m256i Word;
+    static const int WORDS = 4; //number of 64 bit words processed at once
+    static inline Word load(const uint64_t* p) { return _mm256_loadu_si256((const __m256i*) p); }
+    static inline void store(uint64_t* p, Word value) { _mm256_storeu_si256((__m256i*) p, value); }
+    static inline Word west(Word cells, Word before) {
+        return _mm256_or_si256(_mm256_slli_epi64(cells, 1), _mm256_srli_epi64(before, 63));
+    }
+    static inline Word east(Word cells, Word after) {
+        return _mm256_or_si256(_mm256_srli_epi64(cells, 1), _mm256_slli_epi64(after, 63));
+    }
+};
+
+} //namespace
+
+/**
+ * @brief avx2RowKernel Computes the next generation of a part of a row, 256 cells at a time.
+ * @param above, current, below The first word to compute in the three rows.
+ * @param result The first word of the output row.
+ * @param count The number of words to compute.
+ * @param rule Unused, the kernel advances the board with the rule of the Game of Life.
+ */
+void avx2RowKernel(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                   uint64_t* result, int count, RuleMask rule) {
+    stepRow<Avx2Lanes, ConwayRule>(above, current, below, result, count, rule);
+}
+
+/**
+ * @brief avx2RuleKernel Returns the AVX2 row kernel for a rule.
+ * @param rule The rule.
+ * @return The row kernel, which advances 256 cells at a time.
+ */
+RowKernel avx2RuleKernel(RuleMask rule) {
+    if (rule == CONWAY_RULE) {
+        return avx2RowKernel;
+    }
+    return kernelForRule<Avx2Lanes>(rule);
+}
+
+#ifdef LIFE_STATS
+
+/**
+ * @brief countBits Counts the set bits of every byte: the bits of every nibble are looked up in
+ * a table of 16 bytes.
+ * @param value The bytes.
+ * @return The number of set bits of every byte, at most 8.
+ */
+static inline __m256i countBits(__m256i value) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(value, nibble));
+    __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble));
+    return _mm256_add_epi8(low, high);
+}
+
+/**
+ * @brief sumLanes Adds up the four 64 bit lanes of a register.
+ * @param value The lanes.
+ * @return The sum.
+ */
+static inline long long sumLanes(__m256i value) {
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, value);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+/**
+ * @brief avx2CountKernel Counts the living, born and dead cells of a part of some rows, 4 words
+ * at a time. The bit counts of the bytes are summed up as bytes for up to 31 steps, which is as
+ * many as they can hold, and only then widened.
+ * @param current The first word to count in the current generation of the first row.
+ * @param previous The first word to count in the previous generation of the first row.
+ * @param count The number of words to count in every row.
+ * @param rows The number of rows.
+ * @param stride The number of words from a row to the next one.
+ * @param columns The count words the words of every row are ORed into.
+ * @param counts The counts the cells are added to.
+ */
+void avx2CountKernel(const uint64_t* current, const uint64_t* previous, int count, int rows,
+                     int stride, uint64_t* columns, CellCounts &counts) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i totals[3] = {zero, zero, zero}; //population, changed cells and births
+    __m256i bytes[3] = {zero, zero, zero};
+    int steps = 0;
+    int vectorCount = count & ~3;
+    for (int r = 0; r < rows; r++) {
+        const uint64_t* now = current + (size_t) r * stride;
+        const uint64_t* before = previous + (size_t) r * stride;
+        __m256i any = zero;
+        for (int w = 0; w < vectorCount; w += 4) {
+            __m256i cells = _mm256_loadu_si256((const __m256i*) (now + w));
+            __m256i changed = _mm256_xor_si256(cells, _mm256_loadu_si256((const __m256i*) (before + w)));
+            any = _mm256_or_si256(any, cells);
+            _mm256_storeu_si256((__m256i*) (columns + w),
+                                _mm256_or_si256(cells, _mm256_loadu_si256((const __m256i*) (columns + w))));
+            bytes[0] = _mm256_add_epi8(bytes[0], countBits(cells));
+            bytes[1] = _mm256_add_epi8(bytes[1], countBits(changed));
+            bytes[2] = _mm256_add_epi8(bytes[2], countBits(_mm256_and_si256(changed, cells)));
+            if (++steps == 31) {
+                for (int i = 0; i < 3; i++) {
+                    totals[i] = _mm256_add_epi64(totals[i], _mm256_sad_epu8(bytes[i], zero));
+                    bytes[i] = zero;
+                }
+                steps = 0;
+            }
+        }
+        if (!_mm256_testz_si256(any, any)) {
+            if (counts.firstRow < 0) {
+                counts.firstRow = r;
+            }
+            counts.lastRow = r;
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        totals[i] = _mm256_add_epi64(totals[i], _mm256_sad_epu8(bytes[i], zero));
+    }
+    long long born = sumLanes(totals[2]);
+    counts.population += sumLanes(totals[0]);
+    counts.births += born;
+    counts.deaths += sumLanes(totals[1]) - born;
+    if (vectorCount < count) {
+        //the rest of the words, the rows they find alive are merged with the rows found above
+        CellCounts rest = {0, 0, 0, -1, -1};
+        scalarCountKernel(current + vectorCount, previous + vectorCount, count - vectorCount, rows, stride,
+                          columns + vectorCount, rest);
+        counts.population += rest.population;
+        counts.births += rest.births;
+        counts.deaths += rest.deaths;
+        if (rest.firstRow >= 0) {
+            counts.firstRow = (counts.firstRow < 0) ? rest.firstRow : min(counts.firstRow, rest.firstRow);
+            counts.lastRow = max(counts.lastRow, rest.lastRow);
+        }
+    }
+}
+
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
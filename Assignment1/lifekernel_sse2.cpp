@@ -0,0 +1,75 @@
+/**
+ * @brief The following code involves the SSE2 row kernel, which advances 128 cells per
+ * operation. The whole translation unit is compiled for SSE2, the kernel is only called after
+ * selectRowKernel has checked that the processor supports it.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "lifekernel.h"
+
+#ifdef LIFE_X86_KERNELS
+
+#include <emmintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#include "lifekernelimpl.h"
+
+namespace {
+
+/**
+ * A lane type for the row loop that holds 2 words in a 128 bit register.
+ */
+struct Sse2Lanes {
+    typedef __m128i Word;
+    static const int WORDS = 2; //number of 64 bit words processed at once
+    static inline Word load(const uint64_t* p) { return _mm_loadu_si128((const __m128i*) p); }
+    static inline void store(uint64_t* p, Word value) { _mm_storeu_si128((__m128i*) p, value); }
+    static inline Word west(Word cells, Word before) {
+        return _mm_or_si128(_mm_slli_epi64(cells, 1), _mm_srli_epi64(before, 63));
+    }
+    static inline Word east(Word cells, Word after) {
+        return _mm_or_si128(_mm_srli_epi64(cells, 1), _mm_slli_epi64(after, 63));
+    }
+};
+
+} //namespace
+
+/**
+ * @brief sse2RowKernel Computes the next generation of a part of a row, 128 cells at a time.
+ * @param above, current, below The first word to compute in the three rows.
+ * @param result The first word of the output row.
+ * @param count The number of words to compute.
+ * @param rule Unused, the kernel advances the board with the rule of the Game of Life.
+ */
+void sse2RowKernel(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                   uint64_t* result, int count, RuleMask rule) {
+    stepRow<Sse2Lanes, ConwayRule>(above, current, below, result, count, rule);
+}
+
+/**
+ * @brief sse2RuleKernel Returns the SSE2 row kernel for a rule.
+ * @param rule The rule.
+ * @return The row kernel, which advances 128 cells at a time.
+ */
+RowKernel sse2RuleKernel(RuleMask rule) {
+    if (rule == CONWAY_RULE) {
+        return sse2RowKernel;
+    }
+    return kernelForRule<Sse2Lanes>(rule);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,428 @@
+/**
+ * @brief The internal header shared by the row kernel translation units. It contains the
+ * bit-sliced rules and the row loop as templates, so that every instruction set gets the same
+ * logic. Everything here lives in an unnamed namespace so that each translation unit keeps
+ * its own copy, compiled for its own instruction set, and the linker never mixes them up.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "lifekernel.h"
+#include "liferule.h"
+using namespace std;
+
+namespace {
+
+/**
+ * @brief countNeighbours Computes the neighbour counts of a word of cells at once. The eight
+ * neighbour words are summed with bit-sliced full adders, so that the four bits of every cell's
+ * neighbour count are obtained with a few logical operations instead of eight comparisons.
+ * @param nw, n, ne The neighbours in the row above (north-west, north, north-east).
+ * @param w, e The neighbours in the same row (west, east).
+ * @param sw, s, se The neighbours in the row below (south-west, south, south-east).
+ * @param bit0, bit1, bit2, bit3 The bits of the counts, bit3 is only set for 8 neighbours.
+ */
+template <typename Word>
+inline void countNeighbours(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word &bit0, Word &bit1, Word &bit2, Word &bit3) {
+    //three full adders reduce the eight neighbours to three ones bits and three twos bits
+    Word ones1 = nw ^ n ^ ne;
+    Word twos1 = (nw & n) | (ne & (nw ^ n));
+    Word ones2 = w ^ e ^ sw;
+    Word twos2 = (w & e) | (sw & (w ^ e));
+    Word ones3 = s ^ se;
+    Word twos3 = s & se;
+    //summing the ones bits gives bit 0 of the count and one more twos bit
+    bit0 = ones1 ^ ones2 ^ ones3;
+    Word twos4 = (ones1 & ones2) | (ones3 & (ones1 ^ ones2));
+    //summing the four twos bits gives bit 1 of the count and two fours bits
+    Word twosSum = twos1 ^ twos2 ^ twos3;
+    Word foursA = (twos1 & twos2) | (twos3 & (twos1 ^ twos2));
+    bit1 = twosSum ^ twos4;
+    Word foursB = twosSum & twos4;
+    bit2 = foursA ^ foursB;
+    bit3 = foursA & foursB;
+}
+
+/**
+ * @brief lifeRule Computes the next generation of a word of cells at once with the rule of the
+ * Game of Life (B3/S23), which only needs the bits (count mod 8) of the neighbour counts.
+ * @param nw, n, ne The neighbours in the row above (north-west, north, north-east).
+ * @param w, e The neighbours in the same row (west, east).
+ * @param sw, s, se The neighbours in the row below (south-west, south, south-east).
+ * @param alive The current state of the cells.
+ * @return The next state of the cells.
+ */
+template <typename Word>
+inline Word lifeRule(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se, Word alive) {
+    Word bit0, bit1, bit2, bit3;
+    countNeighbours<Word>(nw, n, ne, w, e, sw, s, se, bit0, bit1, bit2, bit3);
+    //a cell lives with exactly 3 neighbours, or with 2 neighbours if it is already alive (bit3
+    //is left unused, 8 neighbours wrap to 0)
+    return bit1 & ~bit2 & (bit0 | alive);
+}
+
+/**
+ * @brief choose Picks the bits of "ifSet" where the condition is set and the bits of "ifClear"
+ * elsewhere.
+ */
+template <typename Word>
+inline Word choose(Word condition, Word ifSet, Word ifClear) {
+    return ifClear ^ (condition & (ifSet ^ ifClear));
+}
+
+/**
+ * @brief highLifeRule Computes the next generation of a word of cells at once with HighLife
+ * (B36/S23): the cells of the Game of Life, plus the dead cells with 6 neighbours.
+ * @param nw, n, ne The neighbours in the row above (north-west, north, north-east).
+ * @param w, e The neighbours in the same row (west, east).
+ * @param sw, s, se The neighbours in the row below (south-west, south, south-east).
+ * @param alive The current state of the cells.
+ * @return The next state of the cells.
+ */
+template <typename Word>
+inline Word highLifeRule(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                         Word alive) {
+    Word bit0, bit1, bit2, bit3;
+    countNeighbours<Word>(nw, n, ne, w, e, sw, s, se, bit0, bit1, bit2, bit3);
+    //bit1 is set for 2, 3, 6 and 7 neighbours: below 4 the cells of the Game of Life live, from
+    //4 on exactly the others, the dead cells with 6 neighbours
+    return bit1 & (bit2 ^ (bit0 | alive));
+}
+
+/**
+ * @brief dayAndNightRule Computes the next generation of a word of cells at once with Day &
+ * Night (B3678/S34678), where a cell lives with 3, 6, 7 or 8 neighbours, or with 4 neighbours if
+ * it is already alive.
+ * @param nw, n, ne The neighbours in the row above (north-west, north, north-east).
+ * @param w, e The neighbours in the same row (west, east).
+ * @param sw, s, se The neighbours in the row below (south-west, south, south-east).
+ * @param alive The current state of the cells.
+ * @return The next state of the cells.
+ */
+template <typename Word>
+inline Word dayAndNightRule(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word alive) {
+    Word bit0, bit1, bit2, bit3;
+    countNeighbours<Word>(nw, n, ne, w, e, sw, s, se, bit0, bit1, bit2, bit3);
+    //an odd count lives if it is 3 or 7 (bit1), an even one if it is 6, or 4 if alive (bit2),
+    //besides 8 (bit3)
+    return bit3 | choose<Word>(bit0, bit1, bit2 & (bit1 | alive));
+}
+
+/**
+ * @brief seedsRule Computes the next generation of a word of cells at once with Seeds (B2/S),
+ * where only the dead cells with exactly 2 neighbours live.
+ * @param nw, n, ne The neighbours in the row above (north-west, north, north-east).
+ * @param w, e The neighbours in the same row (west, east).
+ * @param sw, s, se The neighbours in the row below (south-west, south, south-east).
+ * @param alive The current state of the cells.
+ * @return The next state of the cells.
+ */
+template <typename Word>
+inline Word seedsRule(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                      Word alive) {
+    Word bit0, bit1, bit2, bit3;
+    countNeighbours<Word>(nw, n, ne, w, e, sw, s, se, bit0, bit1, bit2, bit3);
+    //8 neighbours wrap to 0, so bit3 is left unused
+    return bit1 & ~(bit0 | bit2 | alive);
+}
+
+/**
+ * @brief ruleOutcome Returns the next state of the cells that have a given neighbour count: all
+ * dead, all alive, the current state or its opposite, depending on whether the count is a birth
+ * count and a survival count of the rule.
+ * @param rule The rule.
+ * @param count The neighbour count.
+ * @param alive The current state of the cells.
+ * @return The next state of the cells with that count.
+ */
+template <typename Word>
+inline Word ruleOutcome(RuleMask rule, int count, Word alive) {
+    Word none = alive ^ alive;
+    Word born = ((rule >> count) & 1) ? ~none : none;
+    Word survives = ((rule >> (9 + count)) & 1) ? ~none : none;
+    return choose<Word>(alive, survives, born);
+}
+
+/**
+ * @brief anyRule Computes the next generation of a word of cells at once with any Life-like
+ * rule. The outcomes of the nine neighbour counts are the leaves of a tree of selections on the
+ * bits of the count. When the rule is a compile time constant, the outcomes are constants and the
+ * compiler folds the tree into the few operations that rule needs; otherwise the outcomes do not
+ * depend on the cells and are hoisted out of the row loop.
+ * @param nw, n, ne The neighbours in the row above (north-west, north, north-east).
+ * @param w, e The neighbours in the same row (west, east).
+ * @param sw, s, se The neighbours in the row below (south-west, south, south-east).
+ * @param alive The current state of the cells.
+ * @param rule The rule.
+ * @return The next state of the cells.
+ */
+template <typename Word>
+inline Word anyRule(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se, Word alive,
+                    RuleMask rule) {
+    Word bit0, bit1, bit2, bit3;
+    countNeighbours<Word>(nw, n, ne, w, e, sw, s, se, bit0, bit1, bit2, bit3);
+    Word count01 = choose<Word>(bit0, ruleOutcome<Word>(rule, 1, alive), ruleOutcome<Word>(rule, 0, alive));
+    Word count23 = choose<Word>(bit0, ruleOutcome<Word>(rule, 3, alive), ruleOutcome<Word>(rule, 2, alive));
+    Word count45 = choose<Word>(bit0, ruleOutcome<Word>(rule, 5, alive), ruleOutcome<Word>(rule, 4, alive));
+    Word count67 = choose<Word>(bit0, ruleOutcome<Word>(rule, 7, alive), ruleOutcome<Word>(rule, 6, alive));
+    Word count0to3 = choose<Word>(bit1, count23, count01);
+    Word count4to7 = choose<Word>(bit1, count67, count45);
+    //bit3 is only set for 8 neighbours, when the other bits are clear
+    return choose<Word>(bit3, ruleOutcome<Word>(rule, 8, alive), choose<Word>(bit2, count4to7, count0to3));
+}
+
+//constant decleration(s)
+const int RULE_SHAPES = 32; //number of shapes ruleShape returns
+
+/**
+ * @brief ruleShape Returns which parts of the selection tree of anyRule a rule needs: bit 0 to 3
+ * are set if a cell with 0-1, 2-3, 4-5 or 6-7 neighbours may be alive next, bit 4 if a cell
+ * with 8 neighbours is not treated as one with 0 neighbours. A cell with 8 neighbours has the
+ * bits of 0 neighbours besides bit3, so without bit 4 its outcome is the one of 0 neighbours.
+ * @param rule The rule.
+ * @return The shape, from 0 to RULE_SHAPES - 1.
+ */
+inline int ruleShape(RuleMask rule) {
+    int shape = 0;
+    for (int pair = 0; pair < 4; pair++) {
+        RuleMask counts = 3u << (2 * pair);
+        if ((rule & (counts | (counts << 9))) != 0) {
+            shape |= 1 << pair;
+        }
+    }
+    if (((rule >> 8) & 1) != (rule & 1) || ((rule >> 17) & 1) != ((rule >> 9) & 1)) {
+        shape |= 1 << 4;
+    }
+    return shape;
+}
+
+/**
+ * @brief shapedRule Computes the next generation of a word of cells at once with a rule read at
+ * runtime, like anyRule, leaving out the parts of the selection tree where every cell dies. The
+ * shape is a compile time constant, so each of the RULE_SHAPES kernels only has the selections
+ * its rules need, e.g. B3/S23 only selects among the cells with 2 and 3 neighbours.
+ * @param nw, n, ne The neighbours in the row above (north-west, north, north-east).
+ * @param w, e The neighbours in the same row (west, east).
+ * @param sw, s, se The neighbours in the row below (south-west, south, south-east).
+ * @param alive The current state of the cells.
+ * @param rule The rule, its shape must be SHAPE.
+ * @return The next state of the cells.
+ */
+template <typename Word, int SHAPE>
+inline Word shapedRule(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se, Word alive,
+                       RuleMask rule) {
+    Word bit0, bit1, bit2, bit3;
+    countNeighbours<Word>(nw, n, ne, w, e, sw, s, se, bit0, bit1, bit2, bit3);
+    Word low = alive ^ alive; //cells with 0 to 3 neighbours
+    if (SHAPE & 1) {
+        low = choose<Word>(bit0, ruleOutcome<Word>(rule, 1, alive), ruleOutcome<Word>(rule, 0, alive));
+    }
+    if (SHAPE & 2) {
+        Word count23 = choose<Word>(bit0, ruleOutcome<Word>(rule, 3, alive), ruleOutcome<Word>(rule, 2, alive));
+        low = (SHAPE & 1) ? choose<Word>(bit1, count23, low) : bit1 & count23;
+    } else if (SHAPE & 1) {
+        low = ~bit1 & low;
+    }
+    Word high = alive ^ alive; //cells with 4 to 7 neighbours
+    if (SHAPE & 4) {
+        high = choose<Word>(bit0, ruleOutcome<Word>(rule, 5, alive), ruleOutcome<Word>(rule, 4, alive));
+    }
+    if (SHAPE & 8) {
+        Word count67 = choose<Word>(bit0, ruleOutcome<Word>(rule, 7, alive), ruleOutcome<Word>(rule, 6, alive));
+        high = (SHAPE & 4) ? choose<Word>(bit1, count67, high) : bit1 & count67;
+    } else if (SHAPE & 4) {
+        high = ~bit1 & high;
+    }
+    Word result;
+    if ((SHAPE & 3) && (SHAPE & 12)) {
+        result = choose<Word>(bit2, high, low);
+    } else if (SHAPE & 3) {
+        result = ~bit2 & low;
+    } else {
+        result = bit2 & high;
+    }
+    if (SHAPE & 16) {
+        //bit3 is only set for 8 neighbours, when the other bits are clear
+        result = choose<Word>(bit3, ruleOutcome<Word>(rule, 8, alive), result);
+    }
+    return result;
+}
+
+/**
+ * The rule policies of the row loop. ConwayRule, HighLifeRule, DayAndNightRule and SeedsRule
+ * use the shorter logic written for those rules, FixedRule bakes a rule into the instantiation
+ * and ShapedRule reads it at runtime, with only the selections the shape of the rule needs.
+ */
+struct ConwayRule {
+    template <typename Word>
+    static inline Word next(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word alive, RuleMask) {
+        return lifeRule<Word>(nw, n, ne, w, e, sw, s, se, alive);
+    }
+};
+
+struct HighLifeRule {
+    template <typename Word>
+    static inline Word next(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word alive, RuleMask) {
+        return highLifeRule<Word>(nw, n, ne, w, e, sw, s, se, alive);
+    }
+};
+
+struct DayAndNightRule {
+    template <typename Word>
+    static inline Word next(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word alive, RuleMask) {
+        return dayAndNightRule<Word>(nw, n, ne, w, e, sw, s, se, alive);
+    }
+};
+
+struct SeedsRule {
+    template <typename Word>
+    static inline Word next(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word alive, RuleMask) {
+        return seedsRule<Word>(nw, n, ne, w, e, sw, s, se, alive);
+    }
+};
+
+template <RuleMask RULE>
+struct FixedRule {
+    template <typename Word>
+    static inline Word next(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word alive, RuleMask) {
+        return anyRule<Word>(nw, n, ne, w, e, sw, s, se, alive, RULE);
+    }
+};
+
+template <int SHAPE>
+struct ShapedRule {
+    template <typename Word>
+    static inline Word next(Word nw, Word n, Word ne, Word w, Word e, Word sw, Word s, Word se,
+                            Word alive, RuleMask rule) {
+        return shapedRule<Word, SHAPE>(nw, n, ne, w, e, sw, s, se, alive, rule);
+    }
+};
+
+/**
+ * A lane type for the row loop that holds a single 64 bit word. The vectorized translation
+ * units define their own lane types with the same members.
+ */
+struct ScalarLanes {
+    typedef uint64_t Word;
+    static const int WORDS = 1; //number of 64 bit words processed at once
+    static inline Word load(const uint64_t* p) { return *p; }
+    static inline void store(uint64_t* p, Word value) { *p = value; }
+    static inline Word west(Word cells, Word before) { return (cells << 1) | (before >> 63); }
+    static inline Word east(Word cells, Word after) { return (cells >> 1) | (after << 63); }
+};
+
+/**
+ * @brief stepRow Computes the next generation of "count" words of a row, Lanes::WORDS words at a
+ * time, and finishes the remaining words one at a time.
+ * @param above, current, below The first word to compute in the three rows.
+ * @param result The first word of the output row.
+ * @param count The number of words to compute.
+ * @param rule The rule, only read by the ShapedRule policies.
+ */
+template <typename Lanes, typename Rule>
+inline void stepRow(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                    uint64_t* result, int count, RuleMask rule) {
+    typedef typename Lanes::Word Word;
+    int i = 0;
+    for (; i + Lanes::WORDS <= count; i += Lanes::WORDS) {
+        //the unaligned loads one word back and one word ahead provide the bits that are shifted
+        //in across the word boundaries
+        Word a = Lanes::load(above + i);
+        Word c = Lanes::load(current + i);
+        Word b = Lanes::load(below + i);
+        Word cells = Rule::template next<Word>(Lanes::west(a, Lanes::load(above + i - 1)), a,
+                                               Lanes::east(a, Lanes::load(above + i + 1)),
+                                               Lanes::west(c, Lanes::load(current + i - 1)),
+                                               Lanes::east(c, Lanes::load(current + i + 1)),
+                                               Lanes::west(b, Lanes::load(below + i - 1)), b,
+                                               Lanes::east(b, Lanes::load(below + i + 1)), c, rule);
+        Lanes::store(result + i, cells);
+    }
+    for (; i < count; i++) {
+        result[i] = Rule::template next<uint64_t>(ScalarLanes::west(above[i], above[i - 1]), above[i],
+                                                  ScalarLanes::east(above[i], above[i + 1]),
+                                                  ScalarLanes::west(current[i], current[i - 1]),
+                                                  ScalarLanes::east(current[i], current[i + 1]),
+                                                  ScalarLanes::west(below[i], below[i - 1]), below[i],
+                                                  ScalarLanes::east(below[i], below[i + 1]), current[i],
+                                                  rule);
+    }
+}
+
+/**
+ * @brief ruleRowKernel A row kernel advancing the rows with a rule policy.
+ */
+template <typename Lanes, typename Rule>
+void ruleRowKernel(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                   uint64_t* result, int count, RuleMask rule) {
+    stepRow<Lanes, Rule>(above, current, below, result, count, rule);
+}
+
+/**
+ * The kernels of the rule shapes up to SHAPE, instantiated at compile time and looked up by the
+ * shape of a rule read at runtime.
+ */
+template <typename Lanes, int SHAPE>
+struct ShapedKernels {
+    static RowKernel get(int shape) {
+        if (shape == SHAPE) {
+            return ruleRowKernel<Lanes, ShapedRule<SHAPE> >;
+        }
+        return ShapedKernels<Lanes, SHAPE - 1>::get(shape);
+    }
+};
+
+template <typename Lanes>
+struct ShapedKernels<Lanes, -1> {
+    static RowKernel get(int) {
+        return nullptr;
+    }
+};
+
+/**
+ * @brief kernelForRule Returns the row kernel of a lane type for a rule other than the Game of
+ * Life. HighLife, Day & Night and Seeds have logic of their own, as the Game of Life does, the
+ * other rules that are used the most have kernels compiled with the rule as a constant, the
+ * others share the kernel of their shape, which reads the rule at runtime but leaves out the
+ * neighbour counts where every cell dies.
+ * @param rule The rule.
+ * @return The row kernel.
+ */
+template <typename Lanes>
+RowKernel kernelForRule(RuleMask rule) {
+    switch (rule) {
+    case HIGHLIFE_RULE:
+        return ruleRowKernel<Lanes, HighLifeRule>;
+    case DAY_AND_NIGHT_RULE:
+        return ruleRowKernel<Lanes, DayAndNightRule>;
+    case SEEDS_RULE:
+        return ruleRowKernel<Lanes, SeedsRule>;
+    case LIFE_WITHOUT_DEATH_RULE:
+        return ruleRowKernel<Lanes, FixedRule<LIFE_WITHOUT_DEATH_RULE> >;
+    case MAZE_RULE:
+        return ruleRowKernel<Lanes, FixedRule<MAZE_RULE> >;
+    case TWO_BY_TWO_RULE:
+        return ruleRowKernel<Lanes, FixedRule<TWO_BY_TWO_RULE> >;
+    case MORLEY_RULE:
+        return ruleRowKernel<Lanes, FixedRule<MORLEY_RULE> >;
+    case REPLICATOR_RULE:
+        return ruleRowKernel<Lanes, FixedRule<REPLICATOR_RULE> >;
+    case DIAMOEBA_RULE:
+        return ruleRowKernel<Lanes, FixedRule<DIAMOEBA_RULE> >;
+    default:
+        return ShapedKernels<Lanes, RULE_SHAPES - 1>::get(ruleShape(rule));
+    }
+}
+
+} //namespace
@@ -0,0 +1,113 @@
+/**
+ * @brief The following code involves the functions neccessary to read and write the rulestrings
+ * of Life-like rules. A rule is kept as the two sets of neighbour counts it names, the row
+ * kernels turn it into bit-sliced logic (see lifekernelimpl.h).
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "liferule.h"
+#include <cctype>
+
+//constant decleration(s)
+const int MAX_NEIGHBOURS = 8;
+
+/**
+ * @brief parseCounts Reads the neighbour counts of a part of a rulestring, e.g. "36".
+ * @param counts The digits of the part.
+ * @return The counts, bit k for k neighbours.
+ */
+static RuleMask parseCounts(const string &counts) {
+    RuleMask mask = 0;
+    for (char ch : counts) {
+        if (ch < '0' || ch > '0' + MAX_NEIGHBOURS) {
+            throw("Invalid rulestring, the neighbour counts must be digits from 0 to 8.");
+        }
+        mask |= 1 << (ch - '0');
+    }
+    return mask;
+}
+
+/**
+ * @brief parseRule Reads a rulestring, either in the "B36/S23" notation (in any case, in any
+ * order and with or without the slash) or in the older "23/36" notation, which lists the
+ * survival counts first.
+ * @param rulestring The rulestring.
+ * @return The rule.
+ */
+RuleMask parseRule(const string &rulestring) {
+    string rule;
+    for (char ch : rulestring) {
+        if (!isspace((unsigned char) ch)) {
+            rule += (char) toupper((unsigned char) ch);
+        }
+    }
+    if (rule.empty()) {
+        throw("Invalid rulestring, it is empty.");
+    }
+    size_t slash = rule.find('/');
+    if (rule.find_first_of("BS") == string::npos) {
+        if (slash == string::npos || rule.find('/', slash + 1) != string::npos) {
+            throw("Invalid rulestring, expected a rule such as B3/S23 or 23/3.");
+        }
+        return makeRule(parseCounts(rule.substr(slash + 1)), parseCounts(rule.substr(0, slash)));
+    }
+    RuleMask birth = 0;
+    RuleMask survival = 0;
+    bool seen[2] = {false, false};
+    size_t i = 0;
+    while (i < rule.size()) {
+        char letter = rule[i++];
+        if (letter != 'B' && letter != 'S') {
+            throw("Invalid rulestring, expected a rule such as B3/S23 or 23/3.");
+        }
+        bool isBirth = letter == 'B';
+        if (seen[isBirth]) {
+            throw("Invalid rulestring, the births or survivals are given twice.");
+        }
+        seen[isBirth] = true;
+        size_t end = rule.find_first_of("BS/", i);
+        if (end == string::npos) {
+            end = rule.size();
+        }
+        (isBirth ? birth : survival) = parseCounts(rule.substr(i, end - i));
+        i = end;
+        if (i < rule.size() && rule[i] == '/') {
+            i++;
+            if (i == rule.size()) {
+                throw("Invalid rulestring, expected a rule such as B3/S23 or 23/3.");
+            }
+        }
+    }
+    return makeRule(birth, survival);
+}
+
+/**
+ * @brief ruleToString Writes a rule in the "B36/S23" notation.
+ * @param rule The rule.
+ * @return The rulestring.
+ */
+string ruleToString(RuleMask rule) {
+    string birth = "B";
+    string survival = "S";
+    for (int k = 0; k <= MAX_NEIGHBOURS; k++) {
+        if ((rule >> k) & 1) {
+            birth += (char) ('0' + k);
+        }
+        if ((rule >> (MAX_NEIGHBOURS + 1 + k)) & 1) {
+            survival += (char) ('0' + k);
+        }
+    }
+    return birth + "/" + survival;
+}
+
+/**
+ * @brief ruleBirthsFromNothing Checks whether or not a rule gives birth to dead cells without any
+ * living neighbours, which turns the empty space of an unbounded universe alive.
+ * @param rule The rule.
+ * @return True if the rule contains B0.
+ */
+bool ruleBirthsFromNothing(RuleMask rule) {
+    return (rule & 1) != 0;
+}
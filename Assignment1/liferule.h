@@ -0,0 +1,47 @@
+/**
+ * @brief The header file declaring the Life-like rules a board can be advanced with, e.g. the
+ * Game of Life (B3/S23), HighLife (B36/S23), Day & Night (B3678/S34678) or Seeds (B2/S), and the
+ * functions converting them from and to their rulestrings.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+using namespace std;
+
+/**
+ * A rule as two sets of neighbour counts: bit k (0 to 8) is set if a dead cell with k living
+ * neighbours is born, bit 9 + k is set if a living cell with k living neighbours survives.
+ */
+typedef uint32_t RuleMask;
+
+/**
+ * @brief makeRule Builds a rule from its birth and survival counts.
+ * @param birth The counts a dead cell is born with, bit k for k neighbours.
+ * @param survival The counts a living cell survives with, bit k for k neighbours.
+ * @return The rule.
+ */
+constexpr RuleMask makeRule(RuleMask birth, RuleMask survival) {
+    return birth | (survival << 9);
+}
+
+//constant decleration(s)
+//the counts are written as hexadecimal masks, bit k standing for k neighbours
+const RuleMask CONWAY_RULE = makeRule(0x8, 0xC); //B3/S23
+const RuleMask HIGHLIFE_RULE = makeRule(0x48, 0xC); //B36/S23
+const RuleMask DAY_AND_NIGHT_RULE = makeRule(0x1C8, 0x1D8); //B3678/S34678
+const RuleMask SEEDS_RULE = makeRule(0x4, 0x0); //B2/S
+const RuleMask LIFE_WITHOUT_DEATH_RULE = makeRule(0x8, 0x1FF); //B3/S012345678
+const RuleMask MAZE_RULE = makeRule(0x8, 0x3E); //B3/S12345
+const RuleMask TWO_BY_TWO_RULE = makeRule(0x48, 0x26); //B36/S125
+const RuleMask MORLEY_RULE = makeRule(0x148, 0x34); //B368/S245
+const RuleMask REPLICATOR_RULE = makeRule(0xAA, 0xAA); //B1357/S1357
+const RuleMask DIAMOEBA_RULE = makeRule(0x1E8, 0x1E0); //B35678/S5678
+
+RuleMask parseRule(const string &rulestring); //reads "B36/S23", "S23/B36" or "23/36"
+string ruleToString(RuleMask rule); //returns the rule in the "B36/S23" notation
+bool ruleBirthsFromNothing(RuleMask rule); //true for B0 rules, which fill an unbounded universe
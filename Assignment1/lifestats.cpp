@@ -0,0 +1,114 @@
+/**
+ * @brief The following code involves the methods neccessary to sum up the instrumentation
+ * counters of the generations and to dump them to stderr or to a stats file, a line of JSON
+ * every few generations with the counters of the last generation, the totals and the average
+ * times since the previous dump. It is only built with -DLIFE_STATS.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "lifestats.h"
+
+#ifdef LIFE_STATS
+
+#include <iostream>
+
+/**
+ * @brief LifeStats::LifeStats The constructor of the LifeStats class.
+ */
+LifeStats::LifeStats() {
+    last = GenerationStats();
+    last.top = last.left = last.bottom = last.right = -1;
+    generations = 0;
+    totalBirths = 0;
+    totalDeaths = 0;
+    sinceDump = 0;
+    boundaryNanos = 0;
+    stepNanos = 0;
+    countNanos = 0;
+    displayNanos = 0;
+    interval = STATS_DUMP_INTERVAL;
+}
+
+/**
+ * @brief LifeStats::setOutput Chooses where and how often the counters are dumped.
+ * @param fileName The stats file, the lines are appended to it, or "" for stderr.
+ * @param interval The number of generations between two dumps, 0 to only dump on request.
+ */
+void LifeStats::setOutput(const string &fileName, int interval) {
+    if (interval < 0) {
+        throw("The interval of the dumps must not be negative.");
+    }
+    if (file.is_open()) {
+        file.close();
+    }
+    if (!fileName.empty()) {
+        file.open(fileName.c_str(), ios::app);
+        if (!file) {
+            throw("Unable to open the stats file.");
+        }
+    }
+    this->interval = interval;
+}
+
+/**
+ * @brief LifeStats::record Adds the counters of a generation and dumps them every interval
+ * generations.
+ * @param generation The counters of the generation.
+ */
+void LifeStats::record(const GenerationStats &generation) {
+    last = generation;
+    generations++;
+    sinceDump++;
+    totalBirths += generation.births;
+    totalDeaths += generation.deaths;
+    boundaryNanos += generation.boundaryNanos;
+    stepNanos += generation.stepNanos;
+    countNanos += generation.countNanos;
+    if (interval > 0 && sinceDump >= interval) {
+        dump();
+    }
+}
+
+/**
+ * @brief LifeStats::addDisplayTime Adds the time spent displaying a generation. It may be called
+ * by a rendering thread while the generations are recorded.
+ * @param start The time the display started.
+ */
+void LifeStats::addDisplayTime(StatsClock::time_point start) {
+    displayNanos += chrono::duration_cast<chrono::nanoseconds>(StatsClock::now() - start).count();
+}
+
+/**
+ * @brief LifeStats::dump Writes the counters of the last generation, the totals and the
+ * average time per generation of every phase since the previous dump as a single line of JSON,
+ * e.g. {"generations":100,"population":181,"births":20,"deaths":22,...}.
+ */
+void LifeStats::dump() {
+    ostream &out = file.is_open() ? (ostream&) file : cerr;
+    double per = (sinceDump > 0) ? 1.0 / sinceDump : 0;
+    out << "{\"generations\":" << generations
+        << ",\"population\":" << last.population
+        << ",\"births\":" << last.births << ",\"deaths\":" << last.deaths
+        << ",\"total_births\":" << totalBirths << ",\"total_deaths\":" << totalDeaths
+        << ",\"bounding_box\":{\"top\":" << last.top << ",\"left\":" << last.left
+        << ",\"bottom\":" << last.bottom << ",\"right\":" << last.right << "}"
+        << ",\"ns_per_generation\":{\"boundary\":" << boundaryNanos * per
+        << ",\"step\":" << stepNanos * per << ",\"count\":" << countNanos * per
+        << ",\"display\":" << displayNanos.exchange(0) * per << "}}" << endl;
+    sinceDump = 0;
+    boundaryNanos = 0;
+    stepNanos = 0;
+    countNanos = 0;
+}
+
+/**
+ * @brief LifeStats::getGenerations Returns the number of generations recorded so far.
+ * @return The number of generations.
+ */
+long long LifeStats::getGenerations() const {
+    return generations;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @brief The header file defining the instrumentation counters of the Game of Life: the
+ * population, births, deaths and bounding box of every generation and the time spent filling
+ * the ghost cells, stepping the cells, counting them and displaying them. The counters only
+ * exist when the program is built with -DLIFE_STATS, otherwise the macros below expand to
+ * nothing and the simulation does not pay for them. Every file of a program must be built with
+ * the same setting, since the BitGrid class keeps the counters of its last generation.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#ifdef LIFE_STATS
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+using namespace std;
+
+//constant decleration(s)
+const int STATS_DUMP_INTERVAL = 100; //generations between two dumps of the counters
+
+typedef chrono::steady_clock StatsClock;
+
+/**
+ * The counters of a single generation. The row kernels count the neighbours and apply the rule
+ * in the same pass over a word, so both are timed together as the step. The cells are counted
+ * as they are stepped, a group of rows or a tile at a time, so the step includes that counting
+ * and the count is only the time spent merging the counters of the bands or the tiles.
+ */
+struct GenerationStats {
+    long long population;
+    long long births; //dead cells that came alive
+    long long deaths; //living cells that died
+    int top; //bounding box of the living cells, all -1 if there are none
+    int left;
+    int bottom;
+    int right;
+    long long boundaryNanos; //filling the ghost cells
+    long long stepNanos; //counting the neighbours, applying the rule and counting the new cells
+    long long countNanos; //merging the population, births, deaths and bounding box
+};
+
+class LifeStats {
+public:
+    LifeStats(); //constructor, dumps to stderr every STATS_DUMP_INTERVAL generations
+    void setOutput(const string &fileName, int interval); //"" for stderr, 0 to dump on request
+    void record(const GenerationStats &generation); //adds a generation, dumps if it is time
+    void addDisplayTime(StatsClock::time_point start); //adds the time since start, from any thread
+    void dump(); //writes the counters as a single line of JSON
+    long long getGenerations() const; //number of generations recorded
+
+private:
+    GenerationStats last; //the last generation recorded
+    long long generations;
+    long long totalBirths;
+    long long totalDeaths;
+    long long sinceDump; //generations recorded since the last dump
+    long long boundaryNanos; //times since the last dump
+    long long stepNanos;
+    long long countNanos;
+    atomic<long long> displayNanos; //added by the rendering threads too
+    int interval;
+    ofstream file; //the stats file, not open when dumping to stderr
+
+    LifeStats(const LifeStats &other); //not copyable
+    LifeStats& operator= (const LifeStats &other);
+};
+
+/**
+ * @brief statsLap Adds the time since a clock reading to a counter and reads the clock again,
+ * so consecutive phases can be timed with a single reading between them.
+ * @param total The counter, in nanoseconds.
+ * @param clock The last reading, replaced with the current time.
+ */
+inline void statsLap(long long &total, StatsClock::time_point &clock) {
+    StatsClock::time_point now = StatsClock::now();
+    total += chrono::duration_cast<chrono::nanoseconds>(now - clock).count();
+    clock = now;
+}
+
+#define LIFE_STATS_ONLY(...) __VA_ARGS__
+#define LIFE_STATS_START(clock) StatsClock::time_point clock = StatsClock::now()
+#define LIFE_STATS_LAP(total, clock) statsLap(total, clock)
+
+#else
+
+#define LIFE_STATS_ONLY(...)
+#define LIFE_STATS_START(clock)
+#define LIFE_STATS_LAP(total, clock)
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @brief The following code involves the functions neccessary to advance a bit-packed board
+ * with a lookup table. The 16 cells of a 4x4 square form a 16 bit index into a table of 65536
+ * entries, each holding the next generation of the 2x2 square at the center, so that a single
+ * load replaces the neighbour counting of four cells. The table (64 KB) of a rule is built once,
+ * the first time it is asked for, and kept for the rest of the program.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "lifetable.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+//constant decleration(s)
+const int TABLE_SIZE = 1 << 16; //one entry for every 4x4 square
+
+/**
+ * @brief buildTable Computes the next generation of the 2x2 center of every 4x4 square.
+ * Bit 4 * row + col of an index is the cell at that row and column of the square, bit
+ * 2 * row + col of an entry is the cell at that row and column of the center.
+ * @param rule The rule the squares are advanced with.
+ * @return The table.
+ */
+static vector<uint8_t> buildTable(RuleMask rule) {
+    vector<uint8_t> table(TABLE_SIZE);
+    for (int index = 0; index < TABLE_SIZE; index++) {
+        uint8_t center = 0;
+        for (int row = 1; row <= 2; row++) {
+            for (int col = 1; col <= 2; col++) {
+                int count = 0;
+                for (int r = row - 1; r <= row + 1; r++) {
+                    for (int c = col - 1; c <= col + 1; c++) {
+                        if (r != row || c != col) {
+                            count += (index >> (4 * r + c)) & 1;
+                        }
+                    }
+                }
+                bool alive = (index >> (4 * row + col)) & 1;
+                if ((rule >> (alive ? 9 + count : count)) & 1) {
+                    center |= 1 << (2 * (row - 1) + (col - 1));
+                }
+            }
+        }
+        table[index] = center;
+    }
+    return table;
+}
+
+/**
+ * @brief lookupTableFor Returns the table of a rule, building it if it was never asked for. The
+ * tables are never freed, so the pointer stays valid and may be used by any thread.
+ * @param rule The rule.
+ * @return The first entry of the table.
+ */
+const uint8_t* lookupTableFor(RuleMask rule) {
+    static mutex lock;
+    static map<RuleMask, vector<uint8_t> > tables;
+    lock_guard<mutex> guard(lock);
+    auto found = tables.find(rule);
+    if (found == tables.end()) {
+        found = tables.insert(make_pair(rule, buildTable(rule))).first;
+    }
+    return found->second.data();
+}
+
+/**
+ * @brief lookupTableRowPair Computes the next generation of a part of two rows, looking up the
+ * 2x2 squares of a word one after the other.
+ * @param above, first, second, below The first word to compute in the four rows.
+ * @param firstResult The first word of the output row of "first".
+ * @param secondResult The first word of the output row of "second".
+ * @param count The number of words to compute.
+ * @param lookup The table of the rule.
+ */
+void lookupTableRowPair(const uint64_t* above, const uint64_t* first, const uint64_t* second,
+                        const uint64_t* below, uint64_t* firstResult, uint64_t* secondResult,
+                        int count, const uint8_t* lookup) {
+    const uint64_t* rows[4] = {above, first, second, below};
+    for (int w = 0; w < count; w++) {
+        //low[i] holds the columns -1 to 62 of the word, high[i] the columns 63 and 64
+        uint64_t low[4];
+        uint64_t high[4];
+        for (int i = 0; i < 4; i++) {
+            low[i] = (rows[i][w] << 1) | (rows[i][w - 1] >> 63);
+            high[i] = (rows[i][w] >> 63) | (rows[i][w + 1] << 1);
+        }
+        uint64_t firstWord = 0;
+        uint64_t secondWord = 0;
+        for (int bit = 0; bit < 62; bit += 2) {
+            int index = ((low[0] >> bit) & 0xF) | (((low[1] >> bit) & 0xF) << 4)
+                        | (((low[2] >> bit) & 0xF) << 8) | (((low[3] >> bit) & 0xF) << 12);
+            uint64_t center = lookup[index];
+            firstWord |= (center & 3) << bit;
+            secondWord |= (center >> 2) << bit;
+        }
+        //the last square of the word reaches into the next word
+        int index = 0;
+        for (int i = 0; i < 4; i++) {
+            index |= (int) (((low[i] >> 62) | ((high[i] & 3) << 2)) << (4 * i));
+        }
+        uint64_t center = lookup[index];
+        firstResult[w] = firstWord | ((center & 3) << 62);
+        secondResult[w] = secondWord | ((center >> 2) << 62);
+    }
+}
@@ -0,0 +1,26 @@
+/**
+ * @brief The header file declaring the lookup table stepper, which advances a bit-packed Game of
+ * Life board two rows and two columns at a time by looking every 4x4 neighbourhood up in a
+ * precomputed table of its next generation 2x2 center. Every rule has a table of its own.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "liferule.h"
+using namespace std;
+
+const uint8_t* lookupTableFor(RuleMask rule); //builds the table of a rule the first time it is asked
+
+/**
+ * Computes "count" words of the next generation of two consecutive rows ("first" and "second")
+ * from the current generation of those rows and of the rows above and below them. As with the
+ * row kernels, the words just before and just after the computed range must be readable in the
+ * four input rows. The table is the one returned by lookupTableFor.
+ */
+void lookupTableRowPair(const uint64_t* above, const uint64_t* first, const uint64_t* second,
+                        const uint64_t* below, uint64_t* firstResult, uint64_t* secondResult,
+                        int count, const uint8_t* lookup);
@@ -0,0 +1,537 @@
+/**
+  * LIFE - TESTS
+  * This program checks the Game of Life engines against each other: every check advances the
+  * same colony in two ways that must give the same cells and prints one line with its result.
+  * The program returns 1 if any check failed, so it can be run after every change, e.g.
+  *   g++ -O2 -std=c++11 -pthread lifetests.cpp bitgrid.cpp bandworkers.cpp lifekernel.cpp
+  *       lifekernel_sse2.cpp lifekernel_avx2.cpp lifetable.cpp liferule.cpp
+  *       chunkeduniverse.cpp hashlife.cpp cycledetector.cpp -o lifetests && ./lifetests
+  * The checks are:
+  * - skipping a grid with HashLife (the s)kip command of life.cpp) against advancing it one
+  *   generation at a time, with every boundary, for colonies that stay far from the edges, that
+  *   run into them and that start on them.
+  * - jumping a soup on the unbounded plane with HashLife, with a node cache so small that the
+  *   garbage collector has to forget memoized results, against advancing the plane itself
+  *   (built with -fsanitize=address, it also catches a collection reading a deleted node).
+  * - storing a window of the plane into the same grid every generation against a new grid, with
+  *   and without tracking.
+  * - advancing a soup with the row kernels of every instruction set for rules read at runtime,
+  *   of every shape of the selection tree (see lifekernelimpl.h), and for the named rules with
+  *   kernels of their own, against the lookup table.
+  * - the bits after the last column of every row staying 0, with every boundary and stepper.
+  * - finding the period of a colony from the hashes of every CYCLE_CHECK_INTERVAL-th generation
+  *   against finding it from the hash of every generation.
+  * - built with -DLIFE_STATS (and lifestats.cpp), the counters of every generation against
+  *   counting the cells one by one, with every boundary and stepper, with and without threads.
+  * @author EFE ACER
+  * CS106B - Section Leader: Ryan Kurohara
+  */
+
+//necessary includes
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "bitgrid.h"
+#include "chunkeduniverse.h"
+#include "cycledetector.h"
+#include "hashlife.h"
+#include "lifestats.h"
+using namespace std;
+
+//Constant declerations (for further changes)
+const vector<Boundary> BOUNDARIES = {DEAD_BOUNDARY, TOROIDAL_BOUNDARY, REFLECTIVE_BOUNDARY};
+const vector<uint64_t> SKIP_LENGTHS = {1, 63, 64, 200, 1000, 3000};
+const uint64_t SOUP_SEED = 106;
+const size_t SKIP_TEST_MEMORY = 1024 * 1024; //small, so the node cache is collected too
+const vector<int> CYCLE_TRANSIENTS = {0, 5, 77};
+const vector<uint64_t> PLANE_SKIP_LENGTHS = {150, 200, 256, 350};
+const int RULE_CHECKS = 256; //random rules advanced by both steppers
+const vector<RuleMask> NAMED_RULES = {CONWAY_RULE, HIGHLIFE_RULE, DAY_AND_NIGHT_RULE, SEEDS_RULE,
+                                      LIFE_WITHOUT_DEATH_RULE, MAZE_RULE, TWO_BY_TWO_RULE,
+                                      MORLEY_RULE, REPLICATOR_RULE, DIAMOEBA_RULE}; //own kernels
+const int RULE_GENERATIONS = 8;
+const int STATS_THREADS = 3; //bands of the threaded stats checks
+
+/**
+ * A colony the checks start from.
+ */
+struct TestColony {
+    string name;
+    BitGrid grid;
+};
+
+//Function declerations
+vector<TestColony> makeColonies();
+void placeCells(BitGrid &grid, int row, int col, const vector<string> &cells);
+void fillSoup(BitGrid &grid, int top, int left, int rows, int cols, uint64_t seed);
+bool checkSkip(const TestColony &colony, Boundary boundary, uint64_t generations);
+bool checkPlaneSkip(uint64_t generations);
+bool checkWindow(bool tracking);
+bool checkCycle(int transient, int period);
+bool checkPadding(Boundary boundary, bool tracking, bool lookupTable);
+bool checkRule(RuleMask rule, Boundary boundary, RowKernel kernel);
+#ifdef LIFE_STATS
+bool checkStats(Boundary boundary, bool tracking, bool lookupTable, int threadCount);
+#endif
+vector<RowKernel> supportedKernels();
+RuleMask randomRule(uint64_t &seed);
+bool sameCells(const BitGrid &first, const BitGrid &second);
+string boundaryName(Boundary boundary);
+
+//main function of the program
+int main() {
+    int failures = 0;
+    int checks = 0;
+    try {
+        vector<TestColony> colonies = makeColonies();
+        for (const TestColony &colony : colonies) {
+            for (Boundary boundary : BOUNDARIES) {
+                for (uint64_t generations : SKIP_LENGTHS) {
+                    checks++;
+                    if (!checkSkip(colony, boundary, generations)) {
+                        failures++;
+                    }
+                }
+            }
+        }
+        for (uint64_t generations : PLANE_SKIP_LENGTHS) {
+            checks++;
+            if (!checkPlaneSkip(generations)) {
+                failures++;
+            }
+        }
+        for (int tracking = 0; tracking < 2; tracking++) {
+            checks++;
+            if (!checkWindow(tracking)) {
+                failures++;
+            }
+        }
+        for (Boundary boundary : BOUNDARIES) {
+            for (int stepper = 0; stepper < 4; stepper++) {
+                checks++;
+                if (!checkPadding(boundary, stepper & 1, stepper & 2)) {
+                    failures++;
+                }
+            }
+        }
+        uint64_t seed = SOUP_SEED;
+        vector<RowKernel> kernels = supportedKernels();
+        for (int i = 0; i < RULE_CHECKS; i++) {
+            RuleMask rule = randomRule(seed);
+            for (RowKernel kernel : kernels) {
+                checks++;
+                if (!checkRule(rule, BOUNDARIES[i % BOUNDARIES.size()], kernel)) {
+                    failures++;
+                }
+            }
+        }
+        for (RuleMask rule : NAMED_RULES) {
+            for (Boundary boundary : BOUNDARIES) {
+                for (RowKernel kernel : kernels) {
+                    checks++;
+                    if (!checkRule(rule, boundary, kernel)) {
+                        failures++;
+                    }
+                }
+            }
+        }
+#ifdef LIFE_STATS
+        for (Boundary boundary : BOUNDARIES) {
+            for (int stepper = 0; stepper < 8; stepper++) {
+                checks++;
+                if (!checkStats(boundary, stepper & 1, stepper & 2, (stepper & 4) ? STATS_THREADS : 1)) {
+                    failures++;
+                }
+            }
+        }
+#endif
+        for (int transient : CYCLE_TRANSIENTS) {
+            for (int period = 1; period <= CYCLE_MAX_PERIOD; period++) {
+                checks++;
+                if (!checkCycle(transient, period)) {
+                    failures++;
+                }
+            }
+        }
+    } catch (const char* message) {
+        cerr << "lifetests: " << message << endl;
+        return 1;
+    }
+    cout << (checks - failures) << " of " << checks << " checks passed." << endl;
+    return failures == 0 ? 0 : 1;
+}
+
+/**
+ * @brief makeColonies Builds the colonies of the checks.
+ * @return The colonies.
+ */
+vector<TestColony> makeColonies() {
+    vector<TestColony> colonies;
+    TestColony colony;
+    //a glider in the middle, which reaches the south east corner after a few hundred generations
+    colony.name = "glider";
+    colony.grid.resize(200, 150);
+    placeCells(colony.grid, 100, 75, {"-X-", "--X", "XXX"});
+    colonies.push_back(colony);
+    //an R-pentomino, whose debris and gliders fill a small grid
+    colony.name = "r-pentomino";
+    colony.grid.resize(96, 130);
+    placeCells(colony.grid, 48, 65, {"-XX", "XX-", "-X-"});
+    colonies.push_back(colony);
+    //a soup far from the edges, which HashLife can jump over
+    colony.name = "soup";
+    colony.grid.resize(300, 333);
+    fillSoup(colony.grid, 130, 140, 40, 50, SOUP_SEED);
+    colonies.push_back(colony);
+    //a soup on the edges from the start
+    colony.name = "edge-soup";
+    colony.grid.resize(70, 100);
+    fillSoup(colony.grid, 0, 0, 70, 100, SOUP_SEED + 1);
+    colonies.push_back(colony);
+    //a soup of another rule, far from the edges
+    colony.name = "highlife-soup";
+    colony.grid.resize(256, 256);
+    colony.grid.setRule(parseRule("B36/S23"));
+    fillSoup(colony.grid, 100, 100, 56, 56, SOUP_SEED + 2);
+    colonies.push_back(colony);
+    //a rule with B0, which must never be skipped on the plane
+    colony.name = "b0-soup";
+    colony.grid.resize(40, 40);
+    colony.grid.setRule(parseRule("B0123478/S34678"));
+    fillSoup(colony.grid, 10, 10, 20, 20, SOUP_SEED + 3);
+    colonies.push_back(colony);
+    return colonies;
+}
+
+/**
+ * @brief placeCells Makes the "X" cells of a small pattern alive.
+ * @param grid The grid.
+ * @param row The row of the top left corner of the pattern.
+ * @param col The column of the top left corner of the pattern.
+ * @param cells The rows of the pattern, "X" for a living cell.
+ */
+void placeCells(BitGrid &grid, int row, int col, const vector<string> &cells) {
+    for (int r = 0; r < (int) cells.size(); r++) {
+        for (int c = 0; c < (int) cells[r].size(); c++) {
+            if (cells[r][c] == 'X') {
+                grid.set(row + r, col + c, true);
+            }
+        }
+    }
+}
+
+/**
+ * @brief fillSoup Fills a rectangle of a grid with a random soup, every cell being alive with
+ * probability 1/2, the same for the same seed.
+ * @param grid The grid.
+ * @param top, left The top left corner of the rectangle.
+ * @param rows, cols The size of the rectangle.
+ * @param seed The seed of the random numbers.
+ */
+void fillSoup(BitGrid &grid, int top, int left, int rows, int cols, uint64_t seed) {
+    uint64_t bits = 0;
+    int remaining = 0;
+    for (int r = top; r < top + rows; r++) {
+        for (int c = left; c < left + cols; c++) {
+            if (remaining == 0) {
+                uint64_t value = (seed += 0x9e3779b97f4a7c15ULL);
+                value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+                bits = value ^ (value >> 31);
+                remaining = 64;
+            }
+            grid.set(r, c, bits & 1);
+            bits >>= 1;
+            remaining--;
+        }
+    }
+}
+
+/**
+ * @brief checkSkip Skips a copy of a colony by a number of generations and advances another copy
+ * one generation at a time, then compares them and prints the result.
+ * @param colony The colony.
+ * @param boundary What lies beyond the edges of the grid.
+ * @param generations The number of generations.
+ * @return True if both copies have the same cells.
+ */
+bool checkSkip(const TestColony &colony, Boundary boundary, uint64_t generations) {
+    BitGrid skipped = colony.grid;
+    BitGrid ticked = colony.grid;
+    skipGrid(skipped, boundary, generations, SKIP_TEST_MEMORY);
+    for (uint64_t i = 0; i < generations; i++) {
+        ticked.advance(boundary);
+    }
+    bool passed = sameCells(skipped, ticked);
+    cout << (passed ? "ok   " : "FAIL ") << "skip " << colony.name << " " << boundaryName(boundary)
+         << " " << generations << endl;
+    return passed;
+}
+
+/**
+ * @brief checkPlaneSkip Jumps a soup on the unbounded plane by a number of generations with
+ * HashLife and advances a copy of the plane one generation at a time, then compares them and
+ * prints the result. The node cache is capped at SKIP_TEST_MEMORY, which the soup outgrows even
+ * after its unreachable nodes are collected, so the memoized results are collected too (the
+ * second sweep of HashLife::collectGarbage).
+ * @param generations The number of generations.
+ * @return True if both planes have the same cells.
+ */
+bool checkPlaneSkip(uint64_t generations) {
+    BitGrid soup(200, 200);
+    fillSoup(soup, 0, 0, 200, 200, SOUP_SEED + 6);
+    ChunkedUniverse ticked;
+    ticked.load(soup);
+    HashLife hashLife(SKIP_TEST_MEMORY);
+    hashLife.load(ticked);
+    hashLife.advance(generations);
+    ChunkedUniverse skipped;
+    hashLife.store(skipped);
+    for (uint64_t i = 0; i < generations; i++) {
+        ticked.advance();
+    }
+    bool passed = skipped.hash() == ticked.hash() && skipped.getPopulation() == ticked.getPopulation();
+    cout << (passed ? "ok   " : "FAIL ") << "plane skip soup " << generations << endl;
+    return passed;
+}
+
+/**
+ * @brief checkWindow Stores a window of a soup on the plane into the same grid every
+ * generation, as the unbounded mode of life.cpp does, and advances that grid by one generation,
+ * against a new grid every generation, then prints the result. The grid is cleared in place by
+ * the store, so it must also forget the tiles it tracked.
+ * @param tracking Whether or not the reused grid tracks its tiles.
+ * @return True if both grids have the same cells every generation.
+ */
+bool checkWindow(bool tracking) {
+    BitGrid soup(100, 150);
+    fillSoup(soup, 0, 0, 40, 150, SOUP_SEED + 7);
+    placeCells(soup, 85, 110, {"XX", "XX"}); //a block, whose tile a tracking grid skips
+    ChunkedUniverse universe;
+    universe.load(soup);
+    BitGrid window(90, 130);
+    window.setTracking(tracking);
+    bool passed = true;
+    for (int i = 0; i < RULE_GENERATIONS * 4 && passed; i++) {
+        long long top = (i % 3 == 2) ? 1000 : 5; //an empty window sets no cell after the clear
+        universe.store(window, top, 10);
+        BitGrid fresh(90, 130);
+        universe.store(fresh, top, 10);
+        passed = sameCells(window, fresh);
+        window.advance(DEAD_BOUNDARY);
+        fresh.advance(DEAD_BOUNDARY);
+        passed = passed && sameCells(window, fresh);
+        universe.advance();
+    }
+    cout << (passed ? "ok   " : "FAIL ") << "window soup" << (tracking ? " tracking" : "") << endl;
+    return passed;
+}
+
+/**
+ * @brief checkCycle Counts the generations of a colony that changes for a number of generations
+ * and then repeats itself with a period, by check and by record, and prints the result. The
+ * hashes are made up: the generations of the transient have hashes of their own and every
+ * generation of the cycle has the hash of its phase.
+ * @param transient The number of generations before the cycle.
+ * @param period The period of the cycle.
+ * @return True if check finds the period, at a generation of the cycle.
+ */
+bool checkCycle(int transient, int period) {
+    CycleDetector sampled;
+    CycleDetector recorded;
+    int found = 0;
+    int recordedFound = 0;
+    long long generation = 0;
+    for (; generation < transient + 4LL * period * CYCLE_CHECK_INTERVAL && found == 0; generation++) {
+        uint64_t hash = generation < transient ? 1000000 + generation : (generation - transient) % period;
+        found = sampled.check([hash] { return hash; });
+        if (recordedFound == 0) {
+            recordedFound = recorded.record(hash);
+        }
+    }
+    bool passed = found == period && recordedFound == period && generation - 1 - found >= transient;
+    cout << (passed ? "ok   " : "FAIL ") << "cycle transient " << transient << " period " << period
+         << " found " << found << " at " << (generation - 1) << endl;
+    return passed;
+}
+
+/**
+ * @brief checkPadding Advances a soup with blocks on the west and east edges, which become the
+ * ghost cells after the last column and are left in the skipped tiles of a tracking grid, and
+ * checks that the bits after the last column of every row are 0 after every generation, as
+ * rowWords promises, then prints the result.
+ * @param boundary What lies beyond the edges of the grid.
+ * @param tracking True if the grid tracks its tiles.
+ * @param lookupTable True if the grid is advanced by the lookup table stepper.
+ * @return True if the bits stayed 0.
+ */
+bool checkPadding(Boundary boundary, bool tracking, bool lookupTable) {
+    BitGrid grid(100, 100);
+    fillSoup(grid, 60, 30, 10, 10, SOUP_SEED + 4);
+    placeCells(grid, 2, 0, {"XX", "XX"});
+    placeCells(grid, 20, 98, {"XX", "XX"});
+    grid.setTracking(tracking);
+    grid.setLookupTable(lookupTable);
+    uint64_t padding = ~(((uint64_t) 1 << (grid.numCols() % 64)) - 1);
+    bool passed = true;
+    for (int i = 0; i < 100 && passed; i++) {
+        grid.advance(boundary);
+        for (int r = 0; r < grid.numRows(); r++) {
+            if (grid.rowWords(r)[grid.rowWordCount() - 1] & padding) {
+                passed = false;
+            }
+        }
+    }
+    cout << (passed ? "ok   " : "FAIL ") << "padding " << boundaryName(boundary)
+         << (tracking ? " tracking" : "") << (lookupTable ? " lookup-table" : "") << endl;
+    return passed;
+}
+
+/**
+ * @brief checkRule Advances a soup with the row kernel of an instruction set for a rule and
+ * another copy with the lookup table stepper, then compares them and prints the result.
+ * @param rule The rule.
+ * @param boundary What lies beyond the edges of the grid.
+ * @param kernel The Game of Life kernel of the instruction set.
+ * @return True if both copies have the same cells.
+ */
+bool checkRule(RuleMask rule, Boundary boundary, RowKernel kernel) {
+    BitGrid kernelGrid(64, 200);
+    fillSoup(kernelGrid, 0, 0, 64, 200, SOUP_SEED + rule);
+    kernelGrid.setRule(rule);
+    BitGrid table = kernelGrid;
+    kernelGrid.setKernel(kernel);
+    table.setLookupTable(true);
+    for (int i = 0; i < RULE_GENERATIONS; i++) {
+        kernelGrid.advance(boundary);
+        table.advance(boundary);
+    }
+    bool passed = sameCells(kernelGrid, table);
+    cout << (passed ? "ok   " : "FAIL ") << "rule " << ruleToString(rule) << " " << rowKernelName(kernel)
+         << " " << boundaryName(boundary) << endl;
+    return passed;
+}
+
+#ifdef LIFE_STATS
+
+/**
+ * @brief checkStats Advances a soup and a glider that travels across the board, so a tracking
+ * grid skips most of its tiles, and checks the population, births, deaths and bounding box of
+ * every generation against counting the cells one by one, then prints the result.
+ * @param boundary What lies beyond the edges of the grid.
+ * @param tracking True if the grid tracks its tiles.
+ * @param lookupTable True if the grid is advanced by the lookup table stepper.
+ * @param threadCount The number of bands of the grid.
+ * @return True if the counters were right after every generation.
+ */
+bool checkStats(Boundary boundary, bool tracking, bool lookupTable, int threadCount) {
+    BitGrid grid(100, 150);
+    fillSoup(grid, 70, 100, 12, 12, SOUP_SEED + 5);
+    placeCells(grid, 1, 1, {"-X-", "--X", "XXX"});
+    grid.setTracking(tracking);
+    grid.setLookupTable(lookupTable);
+    grid.setThreadCount(threadCount);
+    bool passed = true;
+    for (int i = 0; i < 150 && passed; i++) {
+        BitGrid previous = grid;
+        grid.advance(boundary);
+        GenerationStats expected = GenerationStats();
+        expected.top = expected.left = expected.bottom = expected.right = -1;
+        for (int r = 0; r < grid.numRows(); r++) {
+            for (int c = 0; c < grid.numCols(); c++) {
+                bool alive = grid.get(r, c);
+                if (alive != previous.get(r, c)) {
+                    (alive ? expected.births : expected.deaths)++;
+                }
+                if (alive) {
+                    expected.population++;
+                    if (expected.top < 0) {
+                        expected.top = r;
+                    }
+                    expected.bottom = r;
+                    expected.left = (expected.left < 0) ? c : min(expected.left, c);
+                    expected.right = max(expected.right, c);
+                }
+            }
+        }
+        const GenerationStats &stats = grid.getStats();
+        passed = stats.population == expected.population && stats.births == expected.births
+                 && stats.deaths == expected.deaths && stats.top == expected.top
+                 && stats.left == expected.left && stats.bottom == expected.bottom
+                 && stats.right == expected.right;
+    }
+    cout << (passed ? "ok   " : "FAIL ") << "stats " << boundaryName(boundary)
+         << (tracking ? " tracking" : "") << (lookupTable ? " lookup-table" : "")
+         << (threadCount > 1 ? " threads" : "") << endl;
+    return passed;
+}
+
+#endif
+
+/**
+ * @brief supportedKernels Lists the Game of Life kernels of every instruction set the processor
+ * supports.
+ * @return The kernels.
+ */
+vector<RowKernel> supportedKernels() {
+    vector<RowKernel> kernels;
+    kernels.push_back(scalarRowKernel);
+#ifdef LIFE_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        kernels.push_back(sse2RowKernel);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back(avx2RowKernel);
+    }
+#endif
+    return kernels;
+}
+
+/**
+ * @brief randomRule Returns a random rule, every count being a birth or a survival count with
+ * probability 1/4, so most rules leave some pairs of counts out of the selection tree.
+ * @param seed The state of the random numbers, advanced.
+ * @return The rule.
+ */
+RuleMask randomRule(uint64_t &seed) {
+    uint64_t value = (seed += 0x9e3779b97f4a7c15ULL);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return (RuleMask) (value & (value >> 18)) & makeRule(0x1FF, 0x1FF);
+}
+
+/**
+ * @brief sameCells Compares the cells of two grids.
+ * @param first, second The grids.
+ * @return True if the grids have the same dimensions and the same cells.
+ */
+bool sameCells(const BitGrid &first, const BitGrid &second) {
+    if (first.numRows() != second.numRows() || first.numCols() != second.numCols()) {
+        return false;
+    }
+    for (int r = 0; r < first.numRows(); r++) {
+        if (first.findChange(second, r, 0) != first.numCols()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief boundaryName Returns the name of a boundary.
+ * @param boundary The boundary.
+ * @return "dead", "toroidal" or "reflective".
+ */
+string boundaryName(Boundary boundary) {
+    switch (boundary) {
+    case TOROIDAL_BOUNDARY:
+        return "toroidal";
+    case REFLECTIVE_BOUNDARY:
+        return "reflective";
+    default:
+        return "dead";
+    }
+}
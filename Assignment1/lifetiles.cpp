@@ -0,0 +1,166 @@
+/**
+  * LIFE - TILES
+  * This program advances a board too large for a single process: the board is split into
+  * horizontal tiles, each owned by a worker process (see tileprocesses.h), which exchange the
+  * edge rows of their tiles through shared memory every generation. The rules and the
+  * boundaries are the ones of life.cpp, the result is the same as advancing the whole board
+  * there. The board is read from a grid file, an RLE file or a checkpoint, and the last
+  * generation is written to an RLE file or a checkpoint (.ckpt) if an output file is given.
+  * Only packed checkpoints (the ones this program writes) go straight to the processes, which
+  * read and write their own rows of them, so only they can hold boards larger than a single
+  * process: the other files are loaded here first and converted into a temporary packed
+  * checkpoint, and an RLE output is loaded back from one.
+  * A JSON line with the number of processes, the generations per second and the hash of the
+  * last generation is printed, e.g.
+  *   {"processes":4,"rows":16384,"cols":16384,"boundary":"toroidal","generations":1000,...}
+  * The program does not use the console/GUI libraries and needs a POSIX system, e.g.
+  *   g++ -O2 -std=c++11 -pthread lifetiles.cpp tileprocesses.cpp bitgrid.cpp bandworkers.cpp
+  *       lifekernel.cpp lifekernel_sse2.cpp lifekernel_avx2.cpp lifetable.cpp liferule.cpp
+  *       rle.cpp checkpoint.cpp mappedfile.cpp -o lifetiles
+  * and run as "lifetiles [pattern file] [generations] [processes] [boundary] [output file]",
+  * the boundary being "dead", "toroidal" or "reflective".
+  * @author EFE ACER
+  * CS106B - Section Leader: Ryan Kurohara
+  */
+
+//necessary includes
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "bitgrid.h"
+#include "checkpoint.h"
+#include "rle.h"
+#include "tileprocesses.h"
+using namespace std;
+
+//Constant declerations (for further changes)
+const string DEFAULT_PATTERN = "mycolony.txt";
+const long long DEFAULT_GENERATIONS = 1000;
+const string DEFAULT_BOUNDARY = "toroidal";
+const string TEMPORARY_PREFIX = "lifetiles."; //temporary checkpoints, followed by the process id
+
+//Function declerations
+void loadPattern(const string &file, BitGrid &grid);
+string packedCheckpoint(const string &file, const string &temporary);
+Boundary parseBoundary(const string &name);
+string boundaryName(Boundary boundary);
+
+//main function of the program
+int main(int argc, char** argv) {
+    string file = (argc > 1) ? argv[1] : DEFAULT_PATTERN;
+    long long generations = (argc > 2) ? atoll(argv[2]) : DEFAULT_GENERATIONS;
+    int processes = (argc > 3) ? atoi(argv[3]) : (int) sysconf(_SC_NPROCESSORS_ONLN);
+    string boundaryString = (argc > 4) ? argv[4] : DEFAULT_BOUNDARY;
+    string output = (argc > 5) ? argv[5] : "";
+    string temporary = TEMPORARY_PREFIX + to_string(getpid()) + ".ckpt";
+    try {
+        Boundary boundary = parseBoundary(boundaryString);
+        string input = packedCheckpoint(file, temporary);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        TileProcesses tiles(input, max(processes, 1), boundary);
+        remove(temporary.c_str()); //the processes hold the board from now on
+        tiles.advance(generations);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "{\"processes\":" << tiles.getProcessCount() << ",\"rows\":" << tiles.numRows()
+             << ",\"cols\":" << tiles.numCols() << ",\"boundary\":\"" << boundaryName(boundary)
+             << "\",\"generations\":" << generations << ",\"seconds\":" << seconds
+             << ",\"generations_per_second\":" << ((seconds > 0) ? generations / seconds : 0)
+             << ",\"hash\":" << tiles.hash() << "}" << endl;
+        if (isCheckpointFile(output)) {
+            tiles.save(output, generations);
+        } else if (!output.empty()) {
+            tiles.save(temporary, generations);
+            BitGrid grid;
+            loadCheckpoint(temporary, grid);
+            remove(temporary.c_str());
+            saveRLE(output, grid);
+        }
+    } catch (const char* message) {
+        remove(temporary.c_str());
+        cerr << "lifetiles: " << message << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief loadPattern Reads a board from a checkpoint, an RLE file or a grid file, whose text
+ * format is the number of rows, the number of columns and then a line of "X"/"-" for every row.
+ * @param file The name of the file.
+ * @param grid The grid to fill.
+ */
+void loadPattern(const string &file, BitGrid &grid) {
+    if (isCheckpointFile(file)) {
+        loadCheckpoint(file, grid);
+        return;
+    }
+    if (isRLEFile(file)) {
+        loadRLE(file, grid);
+        return;
+    }
+    ifstream stream(file.c_str());
+    string row;
+    string col;
+    string toPut;
+    if (!getline(stream, row) || !getline(stream, col)) {
+        throw("Unable to read the pattern file.");
+    }
+    grid.resize(atoi(row.c_str()), atoi(col.c_str()));
+    for (int r = 0; r < grid.numRows() && getline(stream, toPut); r++) {
+        for (int c = 0; c < grid.numCols() && c < (int) toPut.size(); c++) {
+            grid.set(r, c, toPut[c] == 'X');
+        }
+    }
+}
+
+/**
+ * @brief packedCheckpoint Returns a packed checkpoint of the board of a file, the file itself
+ * if it already is one, else a temporary checkpoint the board is written into after loading it.
+ * @param file The name of the file.
+ * @param temporary The name of the temporary checkpoint.
+ * @return The name of the packed checkpoint.
+ */
+string packedCheckpoint(const string &file, const string &temporary) {
+    if (isCheckpointFile(file) && readCheckpointInfo(file).packed) {
+        return file;
+    }
+    BitGrid grid;
+    loadPattern(file, grid);
+    saveCheckpoint(temporary, grid, 0, false);
+    return temporary;
+}
+
+/**
+ * @brief parseBoundary Reads the name of a boundary.
+ * @param name "dead", "toroidal" or "reflective".
+ * @return The boundary.
+ */
+Boundary parseBoundary(const string &name) {
+    if (name == "toroidal") {
+        return TOROIDAL_BOUNDARY;
+    } else if (name == "reflective") {
+        return REFLECTIVE_BOUNDARY;
+    } else if (name == "dead") {
+        return DEAD_BOUNDARY;
+    }
+    throw("The boundary must be dead, toroidal or reflective.");
+}
+
+/**
+ * @brief boundaryName Returns the name of a boundary, as printed in the JSON lines.
+ * @param boundary The boundary.
+ * @return "toroidal", "reflective" or "dead".
+ */
+string boundaryName(Boundary boundary) {
+    if (boundary == TOROIDAL_BOUNDARY) {
+        return "toroidal";
+    } else if (boundary == REFLECTIVE_BOUNDARY) {
+        return "reflective";
+    }
+    return "dead";
+}
@@ -0,0 +1,30 @@
+/**
+ * @brief The header file declaring the read only mapping of a whole file into memory, which the
+ * pattern and checkpoint loaders decode in place instead of reading the file piece by piece.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * The read only contents of a file, mapped into memory where the platform supports it.
+ */
+struct MappedFile {
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    vector<char> contents; //the file is read at once instead
+#else
+    void* mapping; //nullptr if nothing is mapped
+#endif
+};
+
+void openMappedFile(const string &fileName, MappedFile &file); //maps the file, read front to back
+void closeMappedFile(MappedFile &file); //releases the mapping
@@ -0,0 +1,268 @@
+/**
+ * @brief The following code involves the functions neccessary to read and write Game of Life
+ * patterns in the run length encoded (RLE) format. The loader maps the whole file into memory
+ * (see mappedfile.h) and decodes the runs straight into the bits of the grid, without reading it
+ * line by line or building any strings. The writer scans the words of the grid for runs and collects them in a
+ * large buffer that is written to the file whenever it fills up.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "rle.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <fstream>
+#include <vector>
+#include "mappedfile.h"
+
+//constant decleration(s)
+const string RLE_EXTENSION = ".rle";
+const int MAX_LINE_LENGTH = 70; //lines of a written pattern are kept below this, as in the format
+const size_t WRITE_BUFFER_SIZE = 1 << 20; //size of the output buffer of the writer
+
+/**
+ * @brief skipSpaces Advances a position past the spaces and tabs of a line.
+ * @param p The position.
+ * @param end The end of the text.
+ * @return The first position that is not a space or a tab.
+ */
+static const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief parseHeader Reads the dimensions and the rule from the header line of a pattern, which
+ * is made of "key = value" pairs separated by commas.
+ * @param p The start of the header line.
+ * @param end The end of the text.
+ * @param width The number of columns of the pattern.
+ * @param height The number of rows of the pattern.
+ * @param rule The rule of the pattern, B3/S23 if the header does not give one.
+ * @return The position after the header line.
+ */
+static const char* parseHeader(const char* p, const char* end, int &width, int &height, RuleMask &rule) {
+    width = -1;
+    height = -1;
+    rule = CONWAY_RULE;
+    while (p < end && *p != '\n') {
+        p = skipSpaces(p, end);
+        const char* keyStart = p;
+        while (p < end && (isalpha((unsigned char) *p))) {
+            p++;
+        }
+        string key(keyStart, p);
+        p = skipSpaces(p, end);
+        if (key.empty() || p >= end || *p != '=') {
+            throw("Invalid header in the RLE file.");
+        }
+        p = skipSpaces(p + 1, end);
+        const char* valueStart = p;
+        while (p < end && *p != ',' && *p != '\n') {
+            p++;
+        }
+        string value(valueStart, p);
+        if (key == "x" || key == "y") {
+            long long number = 0;
+            for (char ch : value) {
+                if (isdigit((unsigned char) ch)) {
+                    number = number * 10 + (ch - '0');
+                    if (number > INT_MAX) {
+                        throw("The pattern in the RLE file is too large.");
+                    }
+                } else if (!isspace((unsigned char) ch)) {
+                    throw("Invalid header in the RLE file.");
+                }
+            }
+            (key == "x" ? width : height) = (int) number;
+        } else if (key == "rule") {
+            rule = parseRule(value);
+        }
+        if (p < end && *p == ',') {
+            p++;
+        }
+    }
+    if (width < 0 || height < 0) {
+        throw("The RLE file has no dimensions.");
+    }
+    return p;
+}
+
+/**
+ * @brief isRLEFile Checks whether or not a file holds an RLE pattern, judging by its extension.
+ * @param fileName The name of the file.
+ * @return True if the name ends with ".rle", in any case.
+ */
+bool isRLEFile(const string &fileName) {
+    if (fileName.size() < RLE_EXTENSION.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < RLE_EXTENSION.size(); i++) {
+        if (tolower(fileName[fileName.size() - RLE_EXTENSION.size() + i]) != RLE_EXTENSION[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief loadRLE Reads an RLE pattern into a grid. The grid takes the dimensions and the rule
+ * given by the header of the pattern and every run of living cells is set a whole word at a time.
+ * @param fileName The name of the file holding the pattern.
+ * @param grid The grid to fill, its previous cells are removed.
+ */
+void loadRLE(const string &fileName, BitGrid &grid) {
+    MappedFile file;
+    openMappedFile(fileName, file);
+    try {
+        const char* p = file.data;
+        const char* end = file.data + file.size;
+        //skipping the comment lines and the blank lines before the header
+        while (p < end && (*p == '#' || isspace((unsigned char) *p))) {
+            if (*p == '#') {
+                p = find(p, end, '\n');
+            } else {
+                p++;
+            }
+        }
+        int width;
+        int height;
+        RuleMask rule;
+        p = parseHeader(p, end, width, height, rule);
+        grid.resize(height, width);
+        grid.setRule(rule);
+        //decoding the runs, e.g. "3o" is three living cells and "2$" ends two rows
+        long long row = 0;
+        long long col = 0;
+        long long count = 0;
+        for (; p < end && *p != '!'; p++) {
+            char ch = *p;
+            if (ch >= '0' && ch <= '9') {
+                count = count * 10 + (ch - '0');
+                if (count > INT_MAX) {
+                    throw("Invalid run length in the RLE file.");
+                }
+                continue;
+            }
+            long long run = (count == 0) ? 1 : count;
+            count = 0;
+            if (ch == 'b' || ch == '.') {
+                col += run;
+            } else if (ch == '$') {
+                row += run;
+                col = 0;
+            } else if (isalpha((unsigned char) ch)) {
+                if (row >= height || col + run > width) {
+                    throw("The pattern does not fit in the dimensions of its RLE file.");
+                }
+                grid.setRun((int) row, (int) col, (int) run);
+                col += run;
+            } else if (!isspace((unsigned char) ch)) {
+                throw("Invalid character in the RLE file.");
+            }
+        }
+    } catch (...) {
+        closeMappedFile(file);
+        throw;
+    }
+    closeMappedFile(file);
+}
+
+/**
+ * The output of the writer, collected in a large buffer that is handed to the stream only when
+ * it fills up.
+ */
+struct RunWriter {
+    ofstream* out;
+    vector<char> buffer;
+    size_t used; //number of characters in the buffer
+    int lineLength; //length of the current line of the pattern
+};
+
+/**
+ * @brief flushRuns Hands the characters in the buffer of the writer to its stream.
+ * @param writer The writer.
+ */
+static void flushRuns(RunWriter &writer) {
+    writer.out->write(writer.buffer.data(), writer.used);
+    writer.used = 0;
+}
+
+/**
+ * @brief writeRun Writes a run of the pattern, wrapping the line before it grows too long.
+ * @param writer The writer.
+ * @param run The length of the run, which is not written when it is 1.
+ * @param tag The tag of the run: 'b', 'o', '$' or '!'.
+ */
+static void writeRun(RunWriter &writer, long long run, char tag) {
+    char digits[24];
+    int length = 0;
+    if (run > 1) {
+        for (long long n = run; n > 0; n /= 10) {
+            digits[length++] = '0' + (char) (n % 10);
+        }
+        reverse(digits, digits + length);
+    }
+    digits[length++] = tag;
+    if (writer.used + length + 2 > writer.buffer.size()) { //room for the run and two line breaks
+        flushRuns(writer);
+    }
+    if (writer.lineLength + length > MAX_LINE_LENGTH) {
+        writer.buffer[writer.used++] = '\n';
+        writer.lineLength = 0;
+    }
+    copy(digits, digits + length, writer.buffer.begin() + writer.used);
+    writer.used += length;
+    writer.lineLength += length;
+}
+
+/**
+ * @brief saveRLE Writes a grid as an RLE pattern. The runs are found by scanning the words of
+ * the grid, the dead cells at the end of a row and the empty rows at the end of the grid are not
+ * written.
+ * @param fileName The name of the file to write.
+ * @param grid The grid to write.
+ */
+void saveRLE(const string &fileName, const BitGrid &grid) {
+    ofstream out(fileName.c_str(), ios::binary);
+    if (!out) {
+        throw("Unable to write the RLE file.");
+    }
+    out << "x = " << grid.numCols() << ", y = " << grid.numRows() << ", rule = " << ruleToString(grid.getRule()) << "\n";
+    RunWriter writer;
+    writer.out = &out;
+    writer.buffer.resize(WRITE_BUFFER_SIZE);
+    writer.used = 0;
+    writer.lineLength = 0;
+    long long endedRows = 0; //rows ended but not yet written, so that trailing rows are dropped
+    for (int r = 0; r < grid.numRows(); r++) {
+        int col = 0;
+        while (true) {
+            int start = grid.findCell(r, col, true);
+            if (start >= grid.numCols()) {
+                break;
+            }
+            if (endedRows > 0) {
+                writeRun(writer, endedRows, '$');
+                endedRows = 0;
+            }
+            if (start > col) {
+                writeRun(writer, start - col, 'b');
+            }
+            col = grid.findCell(r, start, false);
+            writeRun(writer, col - start, 'o');
+        }
+        endedRows++;
+    }
+    writeRun(writer, 1, '!');
+    writer.buffer[writer.used++] = '\n'; //writeRun leaves room for it
+    flushRuns(writer);
+    out.close();
+    if (!out) {
+        throw("Unable to write the RLE file.");
+    }
+}
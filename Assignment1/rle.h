@@ -0,0 +1,20 @@
+/**
+ * @brief The header file declaring the functions that read and write Game of Life patterns in
+ * the run length encoded (RLE) format, e.g.
+ *     #N Glider
+ *     x = 3, y = 3, rule = B3/S23
+ *     bo$2bo$3o!
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <string>
+#include "bitgrid.h"
+using namespace std;
+
+bool isRLEFile(const string &fileName); //checks the extension of the file name
+void loadRLE(const string &fileName, BitGrid &grid); //resizes and fills the grid, sets its rule
+void saveRLE(const string &fileName, const BitGrid &grid); //writes the grid as a pattern
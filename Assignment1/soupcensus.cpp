@@ -0,0 +1,570 @@
+/**
+ * @brief The following code involves the methods neccessary to search random soups and count
+ * the objects they settle into. Every thread takes the next soup number from a shared counter
+ * and fills the soup from its own random stream, seeded by the number, so a census does not
+ * depend on the number of threads. A soup runs on an unbounded plane, so the gliders it sends
+ * away fly on instead of crashing into an edge, until its population has repeated itself for
+ * CENSUS_SETTLE_WINDOW generations. The living cells are then split into objects, cells closer
+ * than three cells to each other belonging to the same object, and every object is run on its
+ * own until its shape comes back: its period and its displacement tell a still life from an
+ * oscillator or a spaceship. An object made of touching groups of cells that run just as they
+ * would on their own, e.g. two blocks side by side, is counted as these groups. An object is
+ * named by its shape in the orientation and phase with the smallest code, so e.g. every glider
+ * gets the same name whichever way it flies. A soup whose objects do not all come back is run
+ * on, it had not settled yet.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "soupcensus.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+//constant decleration(s)
+const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL; //increment of the SplitMix64 streams
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+/**
+ * The well known objects named in the census report, "o" standing for a living cell and "/"
+ * ending a row. The names are given to the shapes these patterns have under the rule of the
+ * census, a pattern that does not come back under it names nothing.
+ */
+const char* const KNOWN_OBJECTS[][2] = {
+    {"block", "oo/oo"},
+    {"beehive", ".oo./o..o/.oo."},
+    {"loaf", ".oo./o..o/.o.o/..o."},
+    {"boat", "oo./o.o/.o."},
+    {"ship", "oo./o.o/.oo"},
+    {"tub", ".o./o.o/.o."},
+    {"pond", ".oo./o..o/o..o/.oo."},
+    {"long boat", "oo../o.o./.o.o/..o."},
+    {"barge", ".o../o.o./.o.o/..o."},
+    {"mango", ".oo../o..o./.o..o/..oo."},
+    {"blinker", "ooo"},
+    {"toad", ".ooo/ooo."},
+    {"beacon", "oo../oo../..oo/..oo"},
+    {"pentadecathlon", "..o....o../oo.oooo.oo/..o....o.."},
+    {"glider", ".o./..o/ooo"},
+    {"lightweight spaceship", ".o..o/o..../o...o/oooo."}
+};
+
+/**
+ * @brief nextRandom Returns the next number of a SplitMix64 stream, a fast generator whose
+ * streams can be started from any seed.
+ * @param state The state of the stream, advanced.
+ * @return 64 random bits.
+ */
+static uint64_t nextRandom(uint64_t &state) {
+    uint64_t z = (state += GOLDEN_GAMMA);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief SoupCensus::SoupCensus The constructor of the SoupCensus class, names the well known
+ * objects of the rule.
+ * @param rule The rule the soups are run with, B0 rules are refused.
+ */
+SoupCensus::SoupCensus(RuleMask rule) {
+    if (ruleBirthsFromNothing(rule)) {
+        throw("A soup cannot be searched with a B0 rule.");
+    }
+    this->rule = rule;
+    for (const auto &known : KNOWN_OBJECTS) {
+        vector<Cell> cells;
+        long long r = 0;
+        long long c = 0;
+        for (const char* p = known[1]; *p != '\0'; p++) {
+            if (*p == '/') {
+                r++;
+                c = 0;
+            } else {
+                if (*p == 'o') {
+                    cells.push_back(Cell(r, c));
+                }
+                c++;
+            }
+        }
+        string code = classify(cells);
+        if (!code.empty() && knownNames.count(code) == 0) {
+            knownNames[code] = known[0];
+        }
+    }
+    soupCount = 0;
+    unsettledCount = 0;
+    seconds = 0;
+    threadCount = 0;
+}
+
+/**
+ * @brief SoupCensus::run Searches a number of soups in parallel and replaces the counts with
+ * the objects they settled into.
+ * @param soups The number of soups, numbered from 0.
+ * @param threadCount The number of threads, usually one per core.
+ * @param seed The seed of the census, the same seed gives the same soups.
+ */
+void SoupCensus::run(long long soups, int threadCount, uint64_t seed) {
+    if (soups < 0 || threadCount < 1) {
+        throw("The number of soups and threads must not be negative.");
+    }
+    vector<Worker> workers(threadCount);
+    atomic<long long> next(0);
+    auto task = [&](int index) {
+        Worker &worker = workers[index];
+        worker.unsettled = 0;
+        for (long long soup = next++; soup < soups; soup = next++) {
+            searchSoup(worker, soup, seed);
+        }
+    };
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int i = 1; i < threadCount; i++) {
+        threads.push_back(thread(task, i));
+    }
+    task(0);
+    for (thread &t : threads) {
+        t.join();
+    }
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    counts.clear();
+    unsettledCount = 0;
+    for (const Worker &worker : workers) {
+        for (const auto &entry : worker.counts) {
+            counts[entry.first] += entry.second;
+        }
+        unsettledCount += worker.unsettled;
+    }
+    soupCount = soups;
+    this->threadCount = threadCount;
+}
+
+/**
+ * @brief SoupCensus::getCounts Accessor method for the counts of the last run.
+ * @return The number of objects found, by name.
+ */
+const map<string, long long>& SoupCensus::getCounts() const {
+    return counts;
+}
+
+/**
+ * @brief SoupCensus::getSoupCount Accessor method for the number of soups of the last run.
+ * @return The number of soups.
+ */
+long long SoupCensus::getSoupCount() const {
+    return soupCount;
+}
+
+/**
+ * @brief SoupCensus::getUnsettledCount Returns the number of soups of the last run that were
+ * still active after SOUP_MAX_GENERATIONS generations, their objects are not counted.
+ * @return The number of soups.
+ */
+long long SoupCensus::getUnsettledCount() const {
+    return unsettledCount;
+}
+
+/**
+ * @brief SoupCensus::getSeconds Accessor method for the duration of the last run.
+ * @return The duration in seconds.
+ */
+double SoupCensus::getSeconds() const {
+    return seconds;
+}
+
+/**
+ * @brief SoupCensus::getThreadCount Accessor method for the number of threads of the last run.
+ * @return The number of threads.
+ */
+int SoupCensus::getThreadCount() const {
+    return threadCount;
+}
+
+/**
+ * @brief SoupCensus::getRule Accessor method for the rule.
+ * @return The rule.
+ */
+RuleMask SoupCensus::getRule() const {
+    return rule;
+}
+
+/**
+ * @brief SoupCensus::report Prints the counts of the last run, the most common objects first,
+ * and the number of soups searched per second, in total and per thread.
+ * @param out The stream to print to.
+ */
+void SoupCensus::report(ostream &out) const {
+    vector<pair<long long, string> > sorted;
+    for (const auto &entry : counts) {
+        sorted.push_back(make_pair(-entry.second, entry.first));
+    }
+    sort(sorted.begin(), sorted.end());
+    out << "Census of " << soupCount << " soups of " << SOUP_SIZE << "x" << SOUP_SIZE
+        << " cells (" << ruleToString(rule) << "):" << endl;
+    for (const auto &entry : sorted) {
+        out << "  " << -entry.first << " " << entry.second << endl;
+    }
+    if (unsettledCount > 0) {
+        out << "  (" << unsettledCount << " soups did not settle in " << SOUP_MAX_GENERATIONS
+            << " generations)" << endl;
+    }
+    double rate = (seconds > 0) ? soupCount / seconds : 0;
+    out << soupCount << " soups in " << seconds << " seconds on " << threadCount << " threads: "
+        << rate << " soups/sec, " << rate / max(1, threadCount) << " soups/sec per thread." << endl;
+}
+
+/**
+ * @brief SoupCensus::fillSoup Fills a SOUP_SIZE square with the random cells of a soup. The
+ * cells are drawn from a stream of its own, started from the seed and the number of the soup.
+ * @param grid The grid to fill, resized to SOUP_SIZE x SOUP_SIZE.
+ * @param seed The seed of the census.
+ * @param soup The number of the soup.
+ */
+void SoupCensus::fillSoup(BitGrid &grid, uint64_t seed, long long soup) {
+    grid.resize(SOUP_SIZE, SOUP_SIZE);
+    uint64_t state = seed ^ ((uint64_t) soup * 0xD1B54A32D192ED03ULL);
+    uint64_t bits = 0;
+    int left = 0;
+    for (int r = 0; r < SOUP_SIZE; r++) {
+        for (int c = 0; c < SOUP_SIZE; c++) {
+            if (left == 0) {
+                bits = nextRandom(state);
+                left = 64;
+            }
+            grid.set(r, c, bits & 1);
+            bits >>= 1;
+            left--;
+        }
+    }
+}
+
+/**
+ * @brief SoupCensus::searchSoup Runs a soup until it settles and counts its objects. The soup
+ * has settled once its population had some period of at most CENSUS_MAX_PERIOD for the last
+ * CENSUS_SETTLE_WINDOW generations and all of its objects come back on their own.
+ * @param worker The counts of the thread.
+ * @param soup The number of the soup.
+ * @param seed The seed of the census.
+ */
+void SoupCensus::searchSoup(Worker &worker, long long soup, uint64_t seed) const {
+    BitGrid grid;
+    fillSoup(grid, seed, soup);
+    ChunkedUniverse universe;
+    universe.load(grid);
+    universe.setRule(rule);
+    vector<long long> populations(CENSUS_MAX_PERIOD + 1); //ring of the last populations
+    vector<int> repeats(CENSUS_MAX_PERIOD + 1, 0); //generations the population had period p for
+    for (long long generation = 0; generation < SOUP_MAX_GENERATIONS; generation++) {
+        universe.advance();
+        long long population = universe.getPopulation();
+        if (population == 0) {
+            return;
+        }
+        bool settled = false;
+        for (int p = 1; p <= CENSUS_MAX_PERIOD; p++) {
+            if (generation >= p && populations[(generation - p) % (CENSUS_MAX_PERIOD + 1)] == population) {
+                settled = settled || ++repeats[p] >= CENSUS_SETTLE_WINDOW;
+            } else {
+                repeats[p] = 0;
+            }
+        }
+        populations[generation % (CENSUS_MAX_PERIOD + 1)] = population;
+        if (settled) {
+            if (censusObjects(worker, universe)) {
+                return;
+            }
+            repeats.assign(CENSUS_MAX_PERIOD + 1, 0); //an object was still changing, run on
+        }
+    }
+    worker.unsettled++;
+}
+
+/**
+ * @brief SoupCensus::censusObjects Splits the cells of a settled soup into objects and counts
+ * them, unless one of them does not come back on its own.
+ * @param worker The counts of the thread, along with the names of the shapes it has seen.
+ * @param universe The soup.
+ * @return True if the objects were counted.
+ */
+bool SoupCensus::censusObjects(Worker &worker, const ChunkedUniverse &universe) const {
+    vector<Cell> cells;
+    listCells(universe, cells);
+    vector<string> found;
+    for (const vector<Cell> &object : splitObjects(cells, 2)) {
+        string shape = shapeCode(object, 0);
+        auto known = worker.names.find(shape);
+        if (known == worker.names.end()) {
+            known = worker.names.insert(make_pair(shape, nameObjects(object))).first;
+        }
+        if (known->second.empty()) {
+            return false;
+        }
+        found.insert(found.end(), known->second.begin(), known->second.end());
+    }
+    for (const string &name : found) {
+        worker.counts[name]++;
+    }
+    return true;
+}
+
+/**
+ * @brief SoupCensus::nameObjects Names an object, or the groups of touching cells it is made of
+ * if they run independently of each other.
+ * @param cells The cells of the object.
+ * @return The names, the common name of a well known object taking the place of its code, or
+ * nothing if the object does not come back in CENSUS_MAX_PERIOD generations.
+ */
+vector<string> SoupCensus::nameObjects(const vector<Cell> &cells) const {
+    vector<vector<Cell> > parts = splitObjects(cells, 1);
+    vector<string> names;
+    if (parts.size() > 1 && runIndependently(cells, parts)) {
+        for (const vector<Cell> &part : parts) {
+            vector<string> partNames = nameObjects(part);
+            if (partNames.empty()) {
+                return vector<string>();
+            }
+            names.insert(names.end(), partNames.begin(), partNames.end());
+        }
+        return names;
+    }
+    string code = classify(cells);
+    if (!code.empty()) {
+        auto known = knownNames.find(code);
+        names.push_back((known == knownNames.end()) ? code : known->second);
+    }
+    return names;
+}
+
+/**
+ * @brief SoupCensus::runIndependently Checks whether or not the parts of an object run as they
+ * would on their own for CENSUS_MAX_PERIOD generations, i.e. every generation of the object is
+ * the union of the generations of the parts.
+ * @param cells The cells of the object.
+ * @param parts The cells split into parts.
+ * @return True if the parts do not affect each other.
+ */
+bool SoupCensus::runIndependently(const vector<Cell> &cells, const vector<vector<Cell> > &parts) const {
+    vector<vector<Cell> > generations(CENSUS_MAX_PERIOD);
+    for (const vector<Cell> &part : parts) {
+        ChunkedUniverse universe;
+        universe.setRule(rule);
+        for (const Cell &cell : part) {
+            universe.set(cell.first, cell.second, true);
+        }
+        vector<Cell> phase;
+        for (int i = 0; i < CENSUS_MAX_PERIOD; i++) {
+            universe.advance();
+            listCells(universe, phase);
+            generations[i].insert(generations[i].end(), phase.begin(), phase.end());
+        }
+    }
+    ChunkedUniverse universe;
+    universe.setRule(rule);
+    for (const Cell &cell : cells) {
+        universe.set(cell.first, cell.second, true);
+    }
+    vector<Cell> phase;
+    for (int i = 0; i < CENSUS_MAX_PERIOD; i++) {
+        universe.advance();
+        listCells(universe, phase);
+        sort(phase.begin(), phase.end());
+        sort(generations[i].begin(), generations[i].end());
+        if (phase != generations[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief SoupCensus::classify Runs an object on its own until its shape comes back and names it
+ * after its kind and its smallest code: "xs" and the population for a still life, "xp" and the
+ * period for an oscillator and "xq" and the period for a spaceship, e.g. "xs4_3.3" for a block.
+ * @param cells The cells of the object.
+ * @return The name, or the empty string if the shape does not come back in CENSUS_MAX_PERIOD
+ * generations.
+ */
+string SoupCensus::classify(const vector<Cell> &cells) const {
+    if (cells.empty()) {
+        return "";
+    }
+    long long top = cells[0].first;
+    long long left = cells[0].second;
+    for (const Cell &cell : cells) {
+        top = min(top, cell.first);
+        left = min(left, cell.second);
+    }
+    ChunkedUniverse universe;
+    universe.setRule(rule);
+    for (const Cell &cell : cells) {
+        universe.set(cell.first - top, cell.second - left, true);
+    }
+    string start = shapeCode(cells, 0);
+    string smallest = canonicalCode(cells);
+    vector<Cell> phase;
+    for (int period = 1; period <= CENSUS_MAX_PERIOD; period++) {
+        universe.advance();
+        listCells(universe, phase);
+        if (phase.empty()) {
+            return "";
+        }
+        if (shapeCode(phase, 0) == start) {
+            long long phaseTop = phase[0].first;
+            long long phaseLeft = phase[0].second;
+            for (const Cell &cell : phase) {
+                phaseTop = min(phaseTop, cell.first);
+                phaseLeft = min(phaseLeft, cell.second);
+            }
+            if (phaseTop != 0 || phaseLeft != 0) {
+                return "xq" + to_string(period) + "_" + smallest;
+            } else if (period == 1) {
+                return "xs" + to_string(cells.size()) + "_" + smallest;
+            }
+            return "xp" + to_string(period) + "_" + smallest;
+        }
+        smallest = min(smallest, canonicalCode(phase));
+    }
+    return "";
+}
+
+/**
+ * @brief SoupCensus::listCells Lists the living cells of a plane, a word of a chunk at a time.
+ * @param universe The plane.
+ * @param cells The list to fill.
+ */
+void SoupCensus::listCells(const ChunkedUniverse &universe, vector<Cell> &cells) {
+    cells.clear();
+    for (const auto &coordinates : universe.getChunkCoordinates()) {
+        const uint64_t* words = universe.getChunk(coordinates.first, coordinates.second);
+        if (words == nullptr) {
+            continue;
+        }
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            for (uint64_t word = words[r]; word != 0; word &= word - 1) {
+                cells.push_back(Cell(coordinates.first * CHUNK_SIZE + r,
+                                     coordinates.second * CHUNK_SIZE + __builtin_ctzll(word)));
+            }
+        }
+    }
+}
+
+/**
+ * @brief SoupCensus::splitObjects Splits living cells into objects, two cells at most some rows
+ * and columns apart belonging to the same object. Two cells at most two rows and two columns
+ * apart share a neighbour, so they can affect each other.
+ * @param cells The cells.
+ * @param distance The largest number of rows and columns between two cells of an object, 2 for
+ * the cells that can affect each other and 1 for the touching ones.
+ * @return The cells of every object.
+ */
+vector<vector<SoupCensus::Cell> > SoupCensus::splitObjects(const vector<Cell> &cells, int distance) {
+    unordered_map<uint64_t, int> index;
+    auto key = [](long long row, long long col) {
+        return ((uint64_t) (uint32_t) row << 32) | (uint32_t) col;
+    };
+    for (int i = 0; i < (int) cells.size(); i++) {
+        index[key(cells[i].first, cells[i].second)] = i;
+    }
+    vector<int> parent(cells.size());
+    for (int i = 0; i < (int) cells.size(); i++) {
+        parent[i] = i;
+    }
+    auto root = [&](int i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    for (int i = 0; i < (int) cells.size(); i++) {
+        for (int dr = -distance; dr <= distance; dr++) {
+            for (int dc = -distance; dc <= distance; dc++) {
+                auto other = index.find(key(cells[i].first + dr, cells[i].second + dc));
+                if (other != index.end()) {
+                    parent[root(other->second)] = root(i);
+                }
+            }
+        }
+    }
+    vector<vector<Cell> > objects;
+    vector<int> objectOf(cells.size(), -1);
+    for (int i = 0; i < (int) cells.size(); i++) {
+        int r = root(i);
+        if (objectOf[r] < 0) {
+            objectOf[r] = objects.size();
+            objects.push_back(vector<Cell>());
+        }
+        objects[objectOf[r]].push_back(cells[i]);
+    }
+    return objects;
+}
+
+/**
+ * @brief SoupCensus::shapeCode Writes the shape of some cells, wherever they are, as the rows of
+ * their bounding box separated by dots, each row as hexadecimal digits of four cells, the least
+ * significant bit of a digit being its leftmost cell.
+ * @param cells The cells.
+ * @param transform One of the 8 symmetries of the square applied to the cells first: bit 2
+ * swaps the rows and the columns, bit 0 mirrors the rows and bit 1 the columns.
+ * @return The code.
+ */
+string SoupCensus::shapeCode(const vector<Cell> &cells, int transform) {
+    vector<Cell> points;
+    points.reserve(cells.size());
+    long long top = 0;
+    long long left = 0;
+    long long bottom = 0;
+    long long right = 0;
+    for (const Cell &cell : cells) {
+        long long r = cell.first;
+        long long c = cell.second;
+        if (transform & 4) {
+            swap(r, c);
+        }
+        if (transform & 1) {
+            r = -r;
+        }
+        if (transform & 2) {
+            c = -c;
+        }
+        if (points.empty()) {
+            top = bottom = r;
+            left = right = c;
+        }
+        top = min(top, r);
+        bottom = max(bottom, r);
+        left = min(left, c);
+        right = max(right, c);
+        points.push_back(Cell(r, c));
+    }
+    int digits = (right - left) / 4 + 1;
+    vector<int> nibbles((bottom - top + 1) * digits, 0);
+    for (const Cell &point : points) {
+        long long c = point.second - left;
+        nibbles[(point.first - top) * digits + c / 4] |= 1 << (c % 4);
+    }
+    string code;
+    for (int i = 0; i < (int) nibbles.size(); i++) {
+        if (i > 0 && i % digits == 0) {
+            code += '.';
+        }
+        code += HEX_DIGITS[nibbles[i]];
+    }
+    return code;
+}
+
+/**
+ * @brief SoupCensus::canonicalCode Returns the smallest code of a shape among its 8
+ * orientations, which is the same for all of them.
+ * @param cells The cells.
+ * @return The code.
+ */
+string SoupCensus::canonicalCode(const vector<Cell> &cells) {
+    string smallest = shapeCode(cells, 0);
+    for (int transform = 1; transform < 8; transform++) {
+        smallest = min(smallest, shapeCode(cells, transform));
+    }
+    return smallest;
+}
@@ -0,0 +1,71 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * SoupCensus class, a batch search that runs many random soups (small randomly filled squares)
+ * on an unbounded plane until they settle, then counts the objects they leave behind, e.g.
+ * blocks, blinkers and gliders.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bitgrid.h"
+#include "chunkeduniverse.h"
+#include "liferule.h"
+using namespace std;
+
+//constant decleration(s)
+const int SOUP_SIZE = 16; //a soup is a 16x16 square, every cell alive with probability 1/2
+const int CENSUS_MAX_PERIOD = 60; //longest period of the objects told apart
+const int CENSUS_SETTLE_WINDOW = 200; //generations the population must repeat for to settle
+const long long SOUP_MAX_GENERATIONS = 20000; //soups still active after this are not counted
+
+class SoupCensus {
+public:
+    SoupCensus(RuleMask rule = CONWAY_RULE); //constructor, B0 rules are refused
+    void run(long long soups, int threadCount, uint64_t seed); //searches the soups 0 to soups - 1
+    const map<string, long long>& getCounts() const; //number of objects found, by name
+    long long getSoupCount() const; //number of soups searched by the last run
+    long long getUnsettledCount() const; //number of soups that did not settle in time
+    double getSeconds() const; //duration of the last run
+    int getThreadCount() const; //number of threads of the last run
+    RuleMask getRule() const; //accessor method for the rule
+    void report(ostream &out) const; //prints the counts and the throughput
+
+    static void fillSoup(BitGrid &grid, uint64_t seed, long long soup); //random SOUP_SIZE square
+
+private:
+    typedef pair<long long, long long> Cell; //row and column of a living cell
+
+    struct Worker {
+        map<string, long long> counts;
+        long long unsettled;
+        unordered_map<string, vector<string> > names; //names of every shape already classified
+    };
+
+    void searchSoup(Worker &worker, long long soup, uint64_t seed) const;
+    bool censusObjects(Worker &worker, const ChunkedUniverse &universe) const;
+    vector<string> nameObjects(const vector<Cell> &cells) const;
+    bool runIndependently(const vector<Cell> &cells, const vector<vector<Cell> > &parts) const;
+    string classify(const vector<Cell> &cells) const;
+    static void listCells(const ChunkedUniverse &universe, vector<Cell> &cells);
+    static vector<vector<Cell> > splitObjects(const vector<Cell> &cells, int distance);
+    static string shapeCode(const vector<Cell> &cells, int transform);
+    static string canonicalCode(const vector<Cell> &cells);
+
+    RuleMask rule;
+    map<string, string> knownNames; //common name of the objects of a few well known shapes
+    map<string, long long> counts;
+    long long soupCount;
+    long long unsettledCount;
+    double seconds;
+    int threadCount;
+};
@@ -0,0 +1,486 @@
+/**
+ * @brief The following code involves the methods neccessary to advance a board split into
+ * horizontal tiles, each owned by a worker process. A process keeps its tile in a BitGrid of
+ * its own with a halo row above and below it, fills the halo rows with the edge rows its
+ * neighbours published for the current generation, advances the BitGrid with the boundary of
+ * the board (the halo rows take care of the rows, the BitGrid wraps or mirrors the columns as
+ * usual) and publishes its new edge rows into the other slot of its ring, so a generation costs
+ * a single barrier. At the top and bottom of the board the halo rows follow the boundary: dead
+ * cells, the opposite edge or the edge row itself. The processes are pinned to processors spread
+ * over the machine and allocate their tiles after that, so on a NUMA machine every tile lives
+ * on the node of the process advancing it. A process maps only its own rows of the checkpoint
+ * it starts from and writes only its own rows of the checkpoints it saves, and the hash of the
+ * board is passed from a process to the next, so no process ever holds more than a tile.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "tileprocesses.h"
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include "checkpoint.h"
+
+/**
+ * @brief TileProcesses::TileProcesses The constructor of the TileProcesses class. Splits the
+ * board of a packed checkpoint into tiles of nearly the same number of rows and starts a process
+ * for every tile, which reads its rows out of the checkpoint. The coordinator only reads the
+ * header, then checks the hash of the board the processes hold against it.
+ * @param checkpoint The name of a packed checkpoint (see saveCheckpoint), with the rule.
+ * @param processCount The number of processes, at most one per row.
+ * @param boundary What lies beyond the edges of the board.
+ */
+TileProcesses::TileProcesses(const string &checkpoint, int processCount, Boundary boundary) {
+    if (processCount < 1) {
+        throw("There must be at least one process.");
+    }
+    CheckpointInfo info = readCheckpointInfo(checkpoint);
+    if (!info.packed) {
+        throw("The tile processes can only read packed checkpoints.");
+    }
+    if (info.rows == 0) {
+        throw("The board is empty.");
+    }
+    rows = info.rows;
+    cols = info.cols;
+    words = (cols + 63) / 64;
+    rule = info.rule;
+    this->boundary = boundary;
+    generation = 0;
+    processCount = min(processCount, rows);
+    for (int process = 0; process <= processCount; process++) {
+        firstRows.push_back((int) ((long long) rows * process / processCount));
+    }
+    //every part starts on a page, so each process touches its own edge rows first
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t controlSize = (sizeof(Control) + page - 1) / page * page;
+    size_t edgeBytes = TILE_EDGE_SLOTS * 2 * (size_t) words * sizeof(uint64_t);
+    edgeWords = (edgeBytes + page - 1) / page * page / sizeof(uint64_t);
+    sharedSize = controlSize + processCount * edgeWords * sizeof(uint64_t);
+    shared = mmap(nullptr, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        throw("Unable to allocate the shared memory.");
+    }
+    control = new (shared) Control;
+    control->failed = 0;
+    control->unsaved = 0;
+    edges = (uint64_t*) ((char*) shared + controlSize);
+    pthread_barrierattr_t attributes;
+    pthread_barrierattr_init(&attributes);
+    pthread_barrierattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    int error = pthread_barrier_init(&control->barrier, &attributes, processCount + 1);
+    pthread_barrierattr_destroy(&attributes);
+    if (error != 0) {
+        munmap(shared, sharedSize);
+        throw("Unable to create the barrier of the tile processes.");
+    }
+    for (int process = 0; process < processCount; process++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            workerMain(process, checkpoint);
+        }
+        if (pid < 0) {
+            //the processes already started wait for the others at the barrier forever
+            for (size_t i = 0; i < processes.size(); i++) {
+                kill(processes[i], SIGKILL);
+                waitpid(processes[i], nullptr, 0);
+            }
+            pthread_barrier_destroy(&control->barrier);
+            munmap(shared, sharedSize);
+            throw("Unable to start the tile processes.");
+        }
+        processes.push_back(pid);
+    }
+    try {
+        control->hash = hashSeed(rows, cols);
+        runCommand(HASH_COMMAND, 0);
+        if (control->failed != 0) {
+            throw("A tile process could not read its tile.");
+        }
+        if (control->hash != info.hash) {
+            throw("The checkpoint file is corrupted.");
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+/**
+ * @brief TileProcesses::~TileProcesses Destructor of the TileProcesses class. Stops the
+ * processes, waits for them to exit and releases the shared memory.
+ */
+TileProcesses::~TileProcesses() {
+    stop();
+}
+
+/**
+ * @brief TileProcesses::stop Stops the processes, waits for them to exit and releases the
+ * shared memory.
+ */
+void TileProcesses::stop() {
+    runCommand(STOP_COMMAND, 0);
+    for (size_t i = 0; i < processes.size(); i++) {
+        waitpid(processes[i], nullptr, 0);
+    }
+    pthread_barrier_destroy(&control->barrier);
+    munmap(shared, sharedSize);
+}
+
+/**
+ * @brief TileProcesses::advance Advances every tile by some generations. The coordinator waits
+ * at the barrier of every generation with the processes, so they stay in lock step.
+ * @param generations The number of generations.
+ */
+void TileProcesses::advance(long long generations) {
+    if (generations <= 0) {
+        return;
+    }
+    runCommand(ADVANCE_COMMAND, generations);
+    generation += generations;
+    if (control->failed != 0) {
+        throw("A tile process could not advance its tile.");
+    }
+}
+
+/**
+ * @brief TileProcesses::hash Returns the hash of the current generation, the same as
+ * BitGrid::hash of the whole board. The processes add the rows of their tiles in turn, top to
+ * bottom.
+ * @return The hash of the board.
+ */
+uint64_t TileProcesses::hash() const {
+    control->hash = hashSeed(rows, cols);
+    runCommand(HASH_COMMAND, 0);
+    if (control->failed != 0) {
+        throw("A tile process could not advance its tile.");
+    }
+    return control->hash;
+}
+
+/**
+ * @brief TileProcesses::save Writes the current generation as a packed checkpoint. The
+ * coordinator creates the file with its header, every process writes the rows of its tile at
+ * their offsets and adds them to the hash, then the coordinator completes the checkpoint, which
+ * replaces the previous one at once like saveCheckpoint does.
+ * @param fileName The name of the checkpoint.
+ * @param checkpointGeneration The generation stored in the checkpoint.
+ */
+void TileProcesses::save(const string &fileName, long long checkpointGeneration) const {
+    string temporary = fileName + ".tmp"; //the file beginPackedCheckpoint creates
+    if (temporary.size() >= (size_t) TILE_FILE_NAME_SIZE) {
+        throw("The name of the checkpoint file is too long.");
+    }
+    CheckpointInfo info;
+    info.rule = rule;
+    info.generation = checkpointGeneration;
+    info.rows = rows;
+    info.cols = cols;
+    info.packed = true;
+    info.hash = 0;
+    beginPackedCheckpoint(fileName, info);
+    strcpy(control->fileName, temporary.c_str());
+    control->hash = hashSeed(rows, cols);
+    control->unsaved = 0;
+    runCommand(SAVE_COMMAND, 0);
+    if (control->failed != 0 || control->unsaved != 0) {
+        remove(temporary.c_str());
+        throw("A tile process could not write its tile.");
+    }
+    endPackedCheckpoint(fileName, control->hash);
+}
+
+/**
+ * @brief TileProcesses::numRows Returns the number of rows of the board.
+ * @return The number of rows.
+ */
+int TileProcesses::numRows() const {
+    return rows;
+}
+
+/**
+ * @brief TileProcesses::numCols Returns the number of columns of the board.
+ * @return The number of columns.
+ */
+int TileProcesses::numCols() const {
+    return cols;
+}
+
+/**
+ * @brief TileProcesses::getRule Returns the rule of the board.
+ * @return The rule.
+ */
+RuleMask TileProcesses::getRule() const {
+    return rule;
+}
+
+/**
+ * @brief TileProcesses::getGeneration Returns the number of generations advanced so far.
+ * @return The number of generations.
+ */
+long long TileProcesses::getGeneration() const {
+    return generation;
+}
+
+/**
+ * @brief TileProcesses::getProcessCount Returns the number of processes, one per tile.
+ * @return The number of processes.
+ */
+int TileProcesses::getProcessCount() const {
+    return (int) processes.size();
+}
+
+/**
+ * @brief TileProcesses::getFirstRow Returns the first row of the tile of a process.
+ * @param process The process, getProcessCount() for the number of rows of the board.
+ * @return The row.
+ */
+int TileProcesses::getFirstRow(int process) const {
+    return firstRows[process];
+}
+
+/**
+ * @brief TileProcesses::runCommand Hands a command to the processes and waits until they are
+ * done with it. The command is read after the first barrier, the generations of an
+ * ADVANCE_COMMAND and the turns of the processes hashing their tiles are separated by a barrier
+ * each and the last barrier ends the command, except for a STOP_COMMAND after which the
+ * processes exit.
+ * @param command The command.
+ * @param generations The number of generations of an ADVANCE_COMMAND.
+ */
+void TileProcesses::runCommand(Command command, long long generations) const {
+    control->command = command;
+    control->generations = generations;
+    pthread_barrier_wait(&control->barrier);
+    if (command == STOP_COMMAND) {
+        return;
+    }
+    if (command == ADVANCE_COMMAND) {
+        for (long long g = 0; g < generations; g++) {
+            pthread_barrier_wait(&control->barrier);
+        }
+    } else {
+        for (size_t turn = 0; turn < processes.size(); turn++) {
+            pthread_barrier_wait(&control->barrier);
+        }
+    }
+    pthread_barrier_wait(&control->barrier);
+}
+
+/**
+ * @brief TileProcesses::workerMain The body of a process: reads its rows out of the checkpoint,
+ * then runs the commands of the coordinator until it is stopped. A process that fails keeps
+ * waiting at the barriers, so the others do not wait for it forever, and reports the failure
+ * through the shared memory instead.
+ * @param process The index of the process.
+ * @param checkpoint The name of the packed checkpoint of the board.
+ */
+void TileProcesses::workerMain(int process, const string &checkpoint) const {
+    int processCount = (int) firstRows.size() - 1;
+    pinProcess(process, processCount);
+    int tileRows = firstRows[process + 1] - firstRows[process];
+    BitGrid tile; //rows 1 to tileRows are the tile, row 0 and row tileRows + 1 the halo rows
+    vector<uint64_t> empty(words, 0);
+    long long local = 0; //generation of the tile
+    bool working = true;
+    try {
+        tile.resize(tileRows + 2, cols);
+        tile.setRule(rule);
+        readTile(process, checkpoint, tile);
+        publishEdges(process, 0, tile);
+    } catch (...) {
+        working = false;
+        control->failed = 1;
+    }
+    for (;;) {
+        pthread_barrier_wait(&control->barrier);
+        Command command = control->command;
+        if (command == STOP_COMMAND) {
+            break;
+        }
+        if (command == ADVANCE_COMMAND) {
+            for (long long g = control->generations; g > 0; g--) {
+                if (working) {
+                    try {
+                        loadHalos(process, local % TILE_EDGE_SLOTS, tile, empty);
+                        tile.advance(boundary);
+                        publishEdges(process, (local + 1) % TILE_EDGE_SLOTS, tile);
+                    } catch (...) {
+                        working = false;
+                        control->failed = 1;
+                    }
+                }
+                local++;
+                pthread_barrier_wait(&control->barrier);
+            }
+        } else {
+            if (command == SAVE_COMMAND && working) {
+                writeTile(process, tile);
+            }
+            for (int turn = 0; turn < processCount; turn++) {
+                if (turn == process && working) {
+                    for (int r = 1; r <= tileRows; r++) {
+                        control->hash = hashWords(control->hash, tile.rowWords(r), words);
+                    }
+                }
+                pthread_barrier_wait(&control->barrier);
+            }
+        }
+        pthread_barrier_wait(&control->barrier);
+    }
+    _exit(working ? 0 : 1);
+}
+
+/**
+ * @brief TileProcesses::readTile Copies the rows of the tile of a process out of a packed
+ * checkpoint, mapping only the pages that hold them.
+ * @param process The index of the process.
+ * @param checkpoint The name of the checkpoint.
+ * @param tile The tile with its halo rows, already sized.
+ */
+void TileProcesses::readTile(int process, const string &checkpoint, BitGrid &tile) const {
+    int first = firstRows[process];
+    int tileRows = firstRows[process + 1] - first;
+    if (words == 0) {
+        return;
+    }
+    long long start = packedRowOffset(first, cols);
+    long long page = sysconf(_SC_PAGESIZE);
+    long long mapped = start / page * page; //mmap only takes offsets on a page
+    size_t length = (size_t) (packedRowOffset(first + tileRows, cols) - mapped);
+    int descriptor = open(checkpoint.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw("Unable to open the file.");
+    }
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, (off_t) mapped);
+    close(descriptor); //the mapping stays valid without the descriptor
+    if (mapping == MAP_FAILED) {
+        throw("Unable to map the file into memory.");
+    }
+    madvise(mapping, length, MADV_SEQUENTIAL);
+    //the rows start 8 bytes apart from a page, so the words are aligned
+    const uint64_t* source = (const uint64_t*) ((const char*) mapping + (start - mapped));
+    for (int r = 0; r < tileRows; r++) {
+        tile.setRowWords(r + 1, source + (size_t) r * words);
+    }
+    munmap(mapping, length);
+}
+
+/**
+ * @brief TileProcesses::writeTile Writes the rows of the tile of a process at their offsets in
+ * the file of a SAVE_COMMAND. A failure is reported through the shared memory.
+ * @param process The index of the process.
+ * @param tile The tile with its halo rows.
+ */
+void TileProcesses::writeTile(int process, const BitGrid &tile) const {
+    int first = firstRows[process];
+    int tileRows = firstRows[process + 1] - first;
+    int descriptor = open(control->fileName, O_WRONLY);
+    if (descriptor < 0) {
+        control->unsaved = 1;
+        return;
+    }
+    size_t bytes = (size_t) words * sizeof(uint64_t);
+    for (int r = 0; r < tileRows; r++) {
+        if (pwrite(descriptor, tile.rowWords(r + 1), bytes, (off_t) packedRowOffset(first + r, cols))
+            != (ssize_t) bytes) {
+            control->unsaved = 1;
+            break;
+        }
+    }
+    close(descriptor);
+}
+
+/**
+ * @brief TileProcesses::publishEdges Writes the first and the last row of a tile into a slot of
+ * the ring of its process.
+ * @param process The index of the process.
+ * @param slot The slot, the generation of the tile modulo TILE_EDGE_SLOTS.
+ * @param tile The tile with its halo rows.
+ */
+void TileProcesses::publishEdges(int process, int slot, const BitGrid &tile) const {
+    int last = tile.numRows() - 2;
+    copy(tile.rowWords(1), tile.rowWords(1) + words, edgeRow(process, slot, TOP_EDGE));
+    copy(tile.rowWords(last), tile.rowWords(last) + words, edgeRow(process, slot, BOTTOM_EDGE));
+}
+
+/**
+ * @brief TileProcesses::loadHalos Fills the halo rows of a tile with the edge rows of its
+ * neighbours, or at the top and bottom of the board with what the boundary puts there.
+ * @param process The index of the process.
+ * @param slot The slot of the current generation.
+ * @param tile The tile with its halo rows.
+ * @param empty A row of dead cells.
+ */
+void TileProcesses::loadHalos(int process, int slot, BitGrid &tile, const vector<uint64_t> &empty) const {
+    int last = (int) firstRows.size() - 2;
+    const uint64_t* above = empty.data();
+    const uint64_t* below = empty.data();
+    if (process > 0) {
+        above = edgeRow(process - 1, slot, BOTTOM_EDGE);
+    } else if (boundary == TOROIDAL_BOUNDARY) {
+        above = edgeRow(last, slot, BOTTOM_EDGE);
+    } else if (boundary == REFLECTIVE_BOUNDARY) {
+        above = edgeRow(process, slot, TOP_EDGE);
+    }
+    if (process < last) {
+        below = edgeRow(process + 1, slot, TOP_EDGE);
+    } else if (boundary == TOROIDAL_BOUNDARY) {
+        below = edgeRow(0, slot, TOP_EDGE);
+    } else if (boundary == REFLECTIVE_BOUNDARY) {
+        below = edgeRow(process, slot, BOTTOM_EDGE);
+    }
+    tile.setRowWords(0, above);
+    tile.setRowWords(tile.numRows() - 1, below);
+}
+
+/**
+ * @brief TileProcesses::edgeRow Returns an edge row in the ring of a process.
+ * @param process The index of the process.
+ * @param slot The slot.
+ * @param edge The top or the bottom row of the tile.
+ * @return The words of the row.
+ */
+uint64_t* TileProcesses::edgeRow(int process, int slot, Edge edge) const {
+    return edges + process * edgeWords + (size_t) (slot * 2 + edge) * words;
+}
+
+/**
+ * @brief TileProcesses::pinProcess Pins the calling process to one of the processors it may
+ * run on, spreading the processes evenly over them. Does nothing where the affinity cannot be
+ * set.
+ * @param process The index of the process.
+ * @param processCount The number of processes.
+ */
+void TileProcesses::pinProcess(int process, int processCount) {
+#ifdef __linux__
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return;
+    }
+    vector<int> processors;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+            processors.push_back(cpu);
+        }
+    }
+    if (processors.empty()) {
+        return;
+    }
+    CPU_ZERO(&set);
+    CPU_SET(processors[(size_t) process * processors.size() / processCount], &set);
+    sched_setaffinity(0, sizeof(set), &set); //if it fails the process simply runs anywhere
+#else
+    (void) process;
+    (void) processCount;
+#endif
+}
@@ -0,0 +1,87 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * TileProcesses class, which splits a board into horizontal tiles owned by worker processes on
+ * the same machine. Every process reads its own rows out of a packed checkpoint and writes them
+ * back into one, and the processes exchange the edge rows of their tiles through shared memory
+ * every generation, in lock step with the coordinator (the process that created them), which
+ * never holds the board. So the board only has to fit in the memory of all the processes
+ * together. POSIX only, it needs fork and process-shared barriers.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <pthread.h>
+#include <sys/types.h>
+#include "bitgrid.h"
+using namespace std;
+
+//constant decleration(s)
+const int TILE_EDGE_SLOTS = 2; //generations of edge rows kept, one is read while the next is written
+const int TILE_FILE_NAME_SIZE = 4096; //bytes of the name of a checkpoint saved by the processes
+
+class TileProcesses {
+public:
+    TileProcesses(const string &checkpoint, int processCount, Boundary boundary); //starts the processes
+    ~TileProcesses(); //destructor, stops the processes and waits for them
+    void advance(long long generations); //advances every tile, a generation at a time
+    uint64_t hash() const; //BitGrid::hash of the board, the processes add their rows in turn
+    void save(const string &fileName, long long checkpointGeneration) const; //a tile per process
+    int numRows() const; //accessor method for the number of rows of the board
+    int numCols() const; //accessor method for the number of columns of the board
+    RuleMask getRule() const; //accessor method for the rule
+    long long getGeneration() const; //number of generations advanced so far
+    int getProcessCount() const; //accessor method for the number of processes
+    int getFirstRow(int process) const; //first row of the tile of a process
+
+private:
+    enum Command {ADVANCE_COMMAND, HASH_COMMAND, SAVE_COMMAND, STOP_COMMAND};
+    enum Edge {TOP_EDGE, BOTTOM_EDGE};
+
+    /**
+     * The start of the shared memory, followed by the edge rows of every process.
+     */
+    struct Control {
+        pthread_barrier_t barrier; //the processes and the coordinator, once per command and generation
+        Command command;
+        long long generations; //generations of an ADVANCE_COMMAND
+        uint64_t hash; //hash of the rows before the tile of the process whose turn it is
+        char fileName[TILE_FILE_NAME_SIZE]; //temporary file of the checkpoint of a SAVE_COMMAND
+        atomic<int> failed; //set by a process that could not read or advance its tile
+        atomic<int> unsaved; //set by a process that could not write its tile
+    };
+
+    void runCommand(Command command, long long generations) const;
+    void stop(); //stops the processes and releases the shared memory
+    void workerMain(int process, const string &checkpoint) const; //never returns
+    void readTile(int process, const string &checkpoint, BitGrid &tile) const;
+    void writeTile(int process, const BitGrid &tile) const; //into the file of a SAVE_COMMAND
+    void publishEdges(int process, int slot, const BitGrid &tile) const;
+    void loadHalos(int process, int slot, BitGrid &tile, const vector<uint64_t> &empty) const;
+    uint64_t* edgeRow(int process, int slot, Edge edge) const;
+    static void pinProcess(int process, int processCount); //spreads the processes over the processors
+
+    void* shared; //the shared memory
+    size_t sharedSize;
+    Control* control;
+    size_t edgeWords; //words of the edges of a single process, a whole number of pages
+    uint64_t* edges; //the edge rows of every slot of every process
+    vector<pid_t> processes;
+    vector<int> firstRows; //first row of every tile, then the number of rows
+    int rows;
+    int cols;
+    int words; //number of words of a row
+    RuleMask rule;
+    Boundary boundary;
+    long long generation;
+
+    TileProcesses(const TileProcesses &other); //not copyable
+    TileProcesses& operator= (const TileProcesses &other);
+};
@@ -0,0 +1,77 @@
+/**
+ * @brief The following code involves the functions neccessary to map a whole file into memory,
+ * with mmap where it is available and by reading the file at once elsewhere.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "mappedfile.h"
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief openMappedFile Maps a whole file into memory.
+ * @param fileName The name of the file.
+ * @param file The mapping to fill.
+ * @param sequential True if the file is read once, front to back, so the pages are read ahead
+ * and dropped early, false if it is read in any order.
+ */
+void openMappedFile(const string &fileName, MappedFile &file, bool sequential) {
+    file.data = nullptr;
+    file.size = 0;
+#ifdef _WIN32
+    (void) sequential; //the whole file is read at once anyway
+    ifstream stream(fileName.c_str(), ios::binary);
+    if (!stream) {
+        throw("Unable to open the file.");
+    }
+    file.contents.assign(istreambuf_iterator<char>(stream), istreambuf_iterator<char>());
+    file.data = file.contents.data();
+    file.size = file.contents.size();
+#else
+    file.mapping = nullptr;
+    int descriptor = open(fileName.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw("Unable to open the file.");
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw("Unable to open the file.");
+    }
+    file.size = (size_t) status.st_size;
+    if (file.size > 0) {
+        file.mapping = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (file.mapping == MAP_FAILED) {
+            close(descriptor);
+            throw("Unable to map the file into memory.");
+        }
+        madvise(file.mapping, file.size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        file.data = (const char*) file.mapping;
+    }
+    close(descriptor); //the mapping stays valid without the descriptor
+#endif
+}
+
+/**
+ * @brief closeMappedFile Releases the memory of a mapped file.
+ * @param file The mapping to release.
+ */
+void closeMappedFile(MappedFile &file) {
+#ifndef _WIN32
+    if (file.mapping != nullptr) {
+        munmap(file.mapping, file.size);
+        file.mapping = nullptr;
+    }
+#endif
+    file.data = nullptr;
+    file.size = 0;
+}
@@ -0,0 +1,31 @@
+/**
+ * @brief The header file declaring the read only mapping of a whole file into memory, which the
+ * n-gram model builder tokenizes in place instead of reading the file a word at a time, and
+ * which holds the arrays of a compiled model while text is generated from it.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * The read only contents of a file, mapped into memory where the platform supports it.
+ */
+struct MappedFile {
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    vector<char> contents; //the file is read at once instead
+#else
+    void* mapping; //nullptr if nothing is mapped
+#endif
+};
+
+void openMappedFile(const string &fileName, MappedFile &file, bool sequential = true); //false for random reads
+void closeMappedFile(MappedFile &file); //releases the mapping
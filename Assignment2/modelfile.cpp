@@ -0,0 +1,309 @@
+/**
+ * @brief The following code involves the functions and methods neccessary to save a finalized
+ * n-gram model as a binary file and to use a saved model straight from the memory mapped file.
+ * The arrays are written as they are stored, in the byte order of the machine that wrote them,
+ * which the header records with the version of the format. The loader points the tables into the
+ * mapping after a single pass over the index arrays, checking that every offset, word ID and
+ * state they hold stays inside the arrays, so a damaged file is refused at once instead of
+ * making the generator read outside the mapping. A model is written to a temporary file that
+ * replaces the previous one only once it is complete.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "modelfile.h"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+//constant decleration(s)
+const string MODEL_EXTENSION = ".ngram";
+const char MODEL_MAGIC[8] = {'N', 'G', 'R', 'A', 'M', 'M', 'D', '1'};
+const int SECTION_COUNT = 10; //the arrays of NGramTables
+const uint16_t MODEL_VERSION = 1; //changes with the layout of the arrays
+const uint16_t MODEL_BYTE_ORDER = 0x0102; //reads 0x0201 on a machine of the other byte order
+
+/**
+ * The header at the start of a model file. The arrays follow it in the order of NGramTables,
+ * every one of them starting on a multiple of 8 bytes.
+ */
+struct ModelHeader {
+    char magic[8]; //MODEL_MAGIC
+    int32_t N;
+    int32_t stateCount;
+    int32_t wordCount;
+    uint16_t version; //MODEL_VERSION
+    uint16_t byteOrder; //MODEL_BYTE_ORDER, in the byte order of the machine that wrote the file
+    uint64_t transitionCount; //number of successors of all the states
+    uint64_t characterCount; //number of characters of all the words
+};
+
+/**
+ * @brief sectionSizes Computes the number of bytes of every array of a model.
+ * @param header The header of the model.
+ * @param sizes The sizes, in the order of NGramTables.
+ */
+static void sectionSizes(const ModelHeader &header, uint64_t sizes[SECTION_COUNT]) {
+    uint64_t states = (uint64_t) header.stateCount;
+    uint64_t transitions = header.transitionCount;
+    sizes[0] = sizeof(uint64_t) * ((uint64_t) header.wordCount + 1); //wordStarts
+    sizes[1] = header.characterCount; //characters
+    sizes[2] = sizeof(int32_t) * states * (header.N - 1); //windows
+    sizes[3] = sizeof(uint64_t) * (states + 1); //offsets
+    sizes[4] = sizeof(uint64_t) * states; //totals
+    sizes[5] = sizeof(int32_t) * transitions; //successors
+    sizes[6] = sizeof(uint32_t) * transitions; //frequencies
+    sizes[7] = sizeof(uint64_t) * transitions; //thresholds
+    sizes[8] = sizeof(int32_t) * transitions; //aliases
+    sizes[9] = sizeof(int32_t) * transitions; //nextStates
+}
+
+/**
+ * @brief padded Rounds a number of bytes up to a multiple of 8.
+ * @param bytes The number of bytes.
+ * @return The rounded number.
+ */
+static uint64_t padded(uint64_t bytes) {
+    return (bytes + 7) / 8 * 8;
+}
+
+/**
+ * @brief validateTables Checks the index arrays of a mapped model, so that following them never
+ * leads outside the arrays: the starts of the words and the offsets of the successors never
+ * decrease and end at the sizes of their arrays, every state has a successor and a total that
+ * is not 0, the thresholds do not exceed the totals, the windows and the successors are word
+ * IDs, the aliases are successors of the same state and the next states are states or -1.
+ * @param tables The arrays, pointing into the mapping.
+ * @param header The header of the model.
+ */
+static void validateTables(const NGramTables &tables, const ModelHeader &header) {
+    bool valid = tables.wordStarts[0] == 0 && tables.offsets[0] == 0
+                 && tables.wordStarts[tables.wordCount] == header.characterCount
+                 && tables.offsets[tables.stateCount] == header.transitionCount;
+    for (int w = 0; w < tables.wordCount && valid; w++) {
+        valid = tables.wordStarts[w] <= tables.wordStarts[w + 1];
+    }
+    uint64_t windowWords = (uint64_t) tables.stateCount * (tables.N - 1);
+    for (uint64_t i = 0; i < windowWords && valid; i++) {
+        valid = tables.windows[i] >= 0 && tables.windows[i] < tables.wordCount;
+    }
+    for (int s = 0; s < tables.stateCount && valid; s++) {
+        uint64_t first = tables.offsets[s];
+        uint64_t last = tables.offsets[s + 1];
+        valid = first < last && last <= header.transitionCount && tables.totals[s] > 0;
+        for (uint64_t i = first; i < last && valid; i++) {
+            valid = tables.successors[i] >= 0 && tables.successors[i] < tables.wordCount
+                    && tables.aliases[i] >= 0 && (uint64_t) tables.aliases[i] < last - first
+                    && tables.nextStates[i] >= -1 && tables.nextStates[i] < tables.stateCount
+                    && tables.thresholds[i] <= tables.totals[s];
+        }
+    }
+    if (!valid) {
+        throw("The model file is corrupted.");
+    }
+}
+
+/**
+ * @brief isModelFile Checks whether or not a file holds a compiled model, judging by its
+ * extension.
+ * @param fileName The name of the file.
+ * @return True if the name ends with ".ngram", in any case.
+ */
+bool isModelFile(const string &fileName) {
+    if (fileName.size() < MODEL_EXTENSION.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < MODEL_EXTENSION.size(); i++) {
+        if (tolower(fileName[fileName.size() - MODEL_EXTENSION.size() + i]) != MODEL_EXTENSION[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief saveModel Writes a finalized model as a model file. The model is written to
+ * "fileName.tmp", flushed to the disk and then renamed, so the file either holds the previous
+ * model or the new one, never a part of it.
+ * @param fileName The name of the model file.
+ * @param model The model to save.
+ */
+void saveModel(const string &fileName, const NGramModel &model) {
+    NGramTables tables = model.getTables();
+    ModelHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MODEL_MAGIC, sizeof(header.magic));
+    header.N = tables.N;
+    header.stateCount = tables.stateCount;
+    header.wordCount = tables.wordCount;
+    header.version = MODEL_VERSION;
+    header.byteOrder = MODEL_BYTE_ORDER;
+    header.transitionCount = tables.offsets[tables.stateCount];
+    header.characterCount = tables.wordStarts[tables.wordCount];
+    uint64_t sizes[SECTION_COUNT];
+    sectionSizes(header, sizes);
+    const void* sections[SECTION_COUNT] = {tables.wordStarts, tables.characters, tables.windows,
+                                           tables.offsets, tables.totals, tables.successors,
+                                           tables.frequencies, tables.thresholds, tables.aliases,
+                                           tables.nextStates};
+    const char zeros[8] = {0};
+    string temporary = fileName + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        throw("Unable to write the model file.");
+    }
+    try {
+        if (fwrite(&header, sizeof(header), 1, file) != 1) {
+            throw("Unable to write the model file.");
+        }
+        for (int i = 0; i < SECTION_COUNT; i++) {
+            size_t padding = padded(sizes[i]) - sizes[i];
+            if ((sizes[i] > 0 && fwrite(sections[i], 1, sizes[i], file) != sizes[i])
+                || (padding > 0 && fwrite(zeros, 1, padding, file) != padding)) {
+                throw("Unable to write the model file.");
+            }
+        }
+        if (fflush(file) != 0) {
+            throw("Unable to write the model file.");
+        }
+#ifndef _WIN32
+        fsync(fileno(file)); //the data must be on the disk before the rename is
+#endif
+    } catch (...) {
+        fclose(file);
+        remove(temporary.c_str());
+        throw;
+    }
+    if (fclose(file) != 0) {
+        remove(temporary.c_str());
+        throw("Unable to write the model file.");
+    }
+#ifdef _WIN32
+    remove(fileName.c_str()); //rename does not replace an existing file there
+#endif
+    if (rename(temporary.c_str(), fileName.c_str()) != 0) {
+        throw("Unable to replace the model file.");
+    }
+}
+
+/**
+ * @brief MappedModel::MappedModel The constructor of the MappedModel class.
+ */
+MappedModel::MappedModel() {
+    memset(&tables, 0, sizeof(tables));
+    file.data = nullptr;
+    file.size = 0;
+#ifndef _WIN32
+    file.mapping = nullptr;
+#endif
+    opened = false;
+}
+
+/**
+ * @brief MappedModel::~MappedModel Destructor of the MappedModel class.
+ */
+MappedModel::~MappedModel() {
+    close();
+}
+
+/**
+ * @brief MappedModel::open Maps a model file into memory and points the tables into it, after
+ * checking the header and, in a single pass, the index arrays (see validateTables). The
+ * characters of the words and the frequencies are not read until text is generated.
+ * @param fileName The name of the model file.
+ */
+void MappedModel::open(const string &fileName) {
+    close();
+    openMappedFile(fileName, file, false); //the generator jumps around the model
+    try {
+        ModelHeader header;
+        if (file.size < sizeof(header)) {
+            throw("The model file is truncated.");
+        }
+        memcpy(&header, file.data, sizeof(header));
+        if (memcmp(header.magic, MODEL_MAGIC, sizeof(header.magic)) != 0) {
+            throw("The file is not a model file.");
+        }
+        if (header.byteOrder == (uint16_t) (MODEL_BYTE_ORDER >> 8 | MODEL_BYTE_ORDER << 8)) {
+            throw("The model file was written on a machine of another byte order.");
+        }
+        if (header.byteOrder != MODEL_BYTE_ORDER || header.version != MODEL_VERSION) {
+            throw("The model file was written by another version of the program.");
+        }
+        //the counts are checked against the size of the file first, so the sizes cannot overflow
+        if (header.N < 2 || header.stateCount < 0 || header.wordCount < 0
+            || header.transitionCount > file.size || header.characterCount > file.size
+            || (uint64_t) header.stateCount * (header.N - 1) > file.size) {
+            throw("Invalid header in the model file.");
+        }
+        uint64_t sizes[SECTION_COUNT];
+        sectionSizes(header, sizes);
+        uint64_t starts[SECTION_COUNT];
+        uint64_t total = sizeof(header);
+        for (int i = 0; i < SECTION_COUNT; i++) {
+            starts[i] = total;
+            total += padded(sizes[i]);
+        }
+        if (total != file.size) {
+            throw("The model file is truncated.");
+        }
+        //the header is a multiple of 8 bytes long and the mapping starts on a page, so every
+        //array is aligned
+        const char* data = file.data;
+        tables.N = header.N;
+        tables.stateCount = header.stateCount;
+        tables.wordCount = header.wordCount;
+        tables.wordStarts = (const uint64_t*) (data + starts[0]);
+        tables.characters = data + starts[1];
+        tables.windows = (const int*) (data + starts[2]);
+        tables.offsets = (const uint64_t*) (data + starts[3]);
+        tables.totals = (const uint64_t*) (data + starts[4]);
+        tables.successors = (const int*) (data + starts[5]);
+        tables.frequencies = (const uint32_t*) (data + starts[6]);
+        tables.thresholds = (const uint64_t*) (data + starts[7]);
+        tables.aliases = (const int*) (data + starts[8]);
+        tables.nextStates = (const int*) (data + starts[9]);
+        validateTables(tables, header);
+    } catch (...) {
+        closeMappedFile(file);
+        memset(&tables, 0, sizeof(tables));
+        throw;
+    }
+    opened = true;
+}
+
+/**
+ * @brief MappedModel::close Releases the mapping of the model, if there is one.
+ */
+void MappedModel::close() {
+    if (opened) {
+        closeMappedFile(file);
+        memset(&tables, 0, sizeof(tables));
+        opened = false;
+    }
+}
+
+/**
+ * @brief MappedModel::isOpen Checks whether or not a model is mapped.
+ * @return True if a model is mapped.
+ */
+bool MappedModel::isOpen() const {
+    return opened;
+}
+
+/**
+ * @brief MappedModel::getTables Returns the arrays of the mapped model, which stay valid until
+ * the model is closed.
+ * @return The arrays.
+ */
+const NGramTables& MappedModel::getTables() const {
+    if (!opened) {
+        throw("No model is open.");
+    }
+    return tables;
+}
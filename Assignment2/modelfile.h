@@ -0,0 +1,39 @@
+/**
+ * @brief The header file declaring the compiled n-gram model files and the MappedModel class,
+ * which maps such a file into memory and hands its arrays to the generator as they are: a fixed
+ * size header holding N, the number of words, states and successors, the version of the format
+ * and the byte order of the machine that wrote it, followed by the arrays of NGramTables (see
+ * ngrammodel.h), each starting on an 8 byte boundary. Loading a model costs a mapping and a
+ * single pass over its index arrays, which checks that they never point outside the arrays.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <string>
+#include "mappedfile.h"
+#include "ngrammodel.h"
+using namespace std;
+
+bool isModelFile(const string &fileName); //checks the extension of the file name
+void saveModel(const string &fileName, const NGramModel &model); //atomic, the model must be finalized
+
+class MappedModel {
+public:
+    MappedModel(); //constructor, no model
+    ~MappedModel(); //destructor, releases the mapping
+    void open(const string &fileName); //maps a model file, replacing the model mapped before
+    void close(); //releases the mapping
+    bool isOpen() const; //checks whether or not a model is mapped
+    const NGramTables& getTables() const; //the arrays of the model, inside the mapping
+
+private:
+    MappedFile file;
+    NGramTables tables;
+    bool opened;
+
+    MappedModel(const MappedModel &other); //not copyable
+    MappedModel& operator= (const MappedModel &other);
+};
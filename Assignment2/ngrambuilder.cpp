@@ -0,0 +1,248 @@
+/**
+ * @brief The following code involves the methods and functions neccessary to build an n-gram
+ * model in a single pass over a text. The words are separated by white space as "input >> word"
+ * separates them and are interned straight from the mapped file, the n-grams are counted into
+ * the model as soon as their last word is read and the first N - 1 words are kept to feed the
+ * windows that wrap around the end of the text, so the memory used is the model's plus a few
+ * words, whatever the size of the text.
+ * With more than one thread the text is split into parts at word boundaries and every thread
+ * counts the windows starting in its part into a model of its own (a shard), reading the N - 1
+ * words after its part as well, wrapping around the end of the text for the last part. The
+ * shards are then merged in order: the words of every part first, so the word IDs are given in
+ * the order the single pass gives them, then the states and successors of every shard, which
+ * are already in the order of their first occurrence in the part. The result is the same model,
+ * with the same IDs, states and order of successors.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "ngrambuilder.h"
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <thread>
+#include "mappedfile.h"
+
+//function declerations
+static void countShard(const char* text, size_t size, size_t begin, size_t end, NGramModel &shard,
+                       int &partWords);
+static void mergeShards(vector<NGramModel> &shards, const vector<int> &partWords, NGramModel &model);
+
+/**
+ * @brief NGramStream::NGramStream The constructor of the NGramStream class.
+ * @param model The model the n-grams are added to.
+ */
+NGramStream::NGramStream(NGramModel &model) : model(model) {
+    length = model.getN() - 1;
+    ring.assign(2 * length, 0);
+    count = 0;
+}
+
+/**
+ * @brief NGramStream::addWord Feeds the next word of the text: adds the n-gram of the last
+ * N - 1 words and this word, then moves the window by one word.
+ * @param id The word ID.
+ */
+void NGramStream::addWord(int id) {
+    int position = (int) (count % length);
+    if (count >= length) {
+        //the last N - 1 words, oldest first, start after the oldest one's first copy
+        model.add(ring.data() + position, id);
+    } else {
+        firstWords.push_back(id);
+    }
+    ring[position] = id;
+    ring[position + length] = id;
+    count++;
+}
+
+/**
+ * @brief NGramStream::wrap Feeds the first N - 1 words of the text again, so every word of the
+ * text starts a window, as if the text went on with its beginning. A text of fewer than N - 1
+ * words is repeated as many times as needed.
+ */
+void NGramStream::wrap() {
+    if (firstWords.empty()) {
+        return;
+    }
+    vector<int> words = firstWords;
+    for (int i = 0; i < length; i++) {
+        addWord(words[i % words.size()]);
+    }
+}
+
+/**
+ * @brief nextWord Finds the next word of a text, the characters up to the next white space.
+ * @param position Where to start looking, moved past the word.
+ * @param end The end of the text.
+ * @param word The first character of the word.
+ * @param length The number of characters of the word.
+ * @return False if there are no more words.
+ */
+bool nextWord(const char* &position, const char* end, const char* &word, size_t &length) {
+    while (position < end && isspace((unsigned char) *position)) {
+        position++;
+    }
+    if (position == end) {
+        return false;
+    }
+    word = position;
+    while (position < end && !isspace((unsigned char) *position)) {
+        position++;
+    }
+    length = position - word;
+    return true;
+}
+
+/**
+ * @brief buildNGramModel Adds every n-gram of a text to a model, the last N - 1 of them
+ * wrapping around the end of the text, and finalizes the model.
+ * @param text The characters of the text.
+ * @param size The number of characters.
+ * @param model The model to fill.
+ * @param threadCount The number of threads counting the n-grams, 0 for one per processor.
+ */
+void buildNGramModel(const char* text, size_t size, NGramModel &model, int threadCount) {
+    if (threadCount == 0) {
+        threadCount = max(1, (int) thread::hardware_concurrency());
+    }
+    if (threadCount < 1) {
+        throw("There must be at least one thread.");
+    }
+    if (threadCount == 1) {
+        WordTable &words = model.getWords();
+        NGramStream stream(model);
+        const char* position = text;
+        const char* end = text + size;
+        const char* word;
+        size_t length;
+        while (nextWord(position, end, word, length)) {
+            stream.addWord(words.intern(word, length));
+        }
+        stream.wrap();
+        model.finalize();
+        return;
+    }
+    //the parts, moved forward to the end of the word they would cut
+    vector<size_t> bounds(threadCount + 1, size);
+    for (int part = 0; part < threadCount; part++) {
+        size_t bound = size / threadCount * part + size % threadCount * part / threadCount;
+        while (bound > 0 && bound < size && !isspace((unsigned char) text[bound - 1])
+               && !isspace((unsigned char) text[bound])) {
+            bound++;
+        }
+        bounds[part] = bound;
+    }
+    vector<NGramModel> shards(threadCount, NGramModel(model.getN()));
+    vector<int> partWords(threadCount, 0);
+    vector<exception_ptr> errors(threadCount);
+    vector<thread> threads;
+    for (int part = 0; part < threadCount; part++) {
+        threads.push_back(thread([&, part] {
+            try {
+                countShard(text, size, bounds[part], bounds[part + 1], shards[part], partWords[part]);
+            } catch (...) {
+                errors[part] = current_exception();
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    for (int part = 0; part < threadCount; part++) {
+        if (errors[part]) {
+            rethrow_exception(errors[part]);
+        }
+    }
+    mergeShards(shards, partWords, model);
+    model.finalize();
+}
+
+/**
+ * @brief buildNGramModel Maps a file into memory and builds a model from its text.
+ * @param fileName The name of the file.
+ * @param model The model to fill.
+ * @param threadCount The number of threads counting the n-grams, 0 for one per processor.
+ */
+void buildNGramModel(const string &fileName, NGramModel &model, int threadCount) {
+    MappedFile file;
+    openMappedFile(fileName, file);
+    try {
+        buildNGramModel(file.data, file.size, model, threadCount);
+    } catch (...) {
+        closeMappedFile(file);
+        throw;
+    }
+    closeMappedFile(file);
+}
+
+/**
+ * @brief countShard Counts the windows starting at the words of a part of a text into a shard.
+ * The N - 1 words after the part, wrapping around the end of the text, are read too, since the
+ * last windows of the part end in them.
+ * @param text The characters of the text.
+ * @param size The number of characters.
+ * @param begin The first character of the part, not inside a word.
+ * @param end The character after the part, not inside a word.
+ * @param shard The model to count into.
+ * @param partWords Set to the number of distinct words of the part, whose IDs come first.
+ */
+static void countShard(const char* text, size_t size, size_t begin, size_t end, NGramModel &shard,
+                       int &partWords) {
+    WordTable &words = shard.getWords();
+    NGramStream stream(shard);
+    const char* position = text + begin;
+    const char* word;
+    size_t length;
+    bool empty = true;
+    while (nextWord(position, text + end, word, length)) {
+        stream.addWord(words.intern(word, length));
+        empty = false;
+    }
+    partWords = words.size();
+    if (empty) {
+        return;
+    }
+    position = text + end;
+    for (int needed = shard.getN() - 1; needed > 0; ) {
+        if (!nextWord(position, text + size, word, length)) {
+            position = text; //the case for wrapping
+            continue;
+        }
+        stream.addWord(words.intern(word, length));
+        needed--;
+    }
+}
+
+/**
+ * @brief mergeShards Merges the shards of the parts of a text into a model, so that the model
+ * is the one the single pass builds. The words of the parts are interned first, in the order of
+ * the parts, then the words the shards only read after their parts are looked up and finally
+ * the states and successors are added, shard by shard. Every shard is released once merged.
+ * @param shards The shards, in the order of the parts.
+ * @param partWords The number of distinct words of every part.
+ * @param model The model to merge into.
+ */
+static void mergeShards(vector<NGramModel> &shards, const vector<int> &partWords, NGramModel &model) {
+    WordTable &words = model.getWords();
+    vector<vector<int> > wordIds(shards.size());
+    for (size_t part = 0; part < shards.size(); part++) {
+        const WordTable &shardWords = shards[part].getWords();
+        wordIds[part].resize(shardWords.size());
+        for (int id = 0; id < partWords[part]; id++) {
+            wordIds[part][id] = words.intern(shardWords.wordData(id), shardWords.wordLength(id));
+        }
+    }
+    for (size_t part = 0; part < shards.size(); part++) {
+        const WordTable &shardWords = shards[part].getWords();
+        for (int id = partWords[part]; id < shardWords.size(); id++) {
+            //every word read after a part is a word of some part
+            wordIds[part][id] = words.find(shardWords.wordData(id), shardWords.wordLength(id));
+        }
+    }
+    for (size_t part = 0; part < shards.size(); part++) {
+        model.merge(shards[part], wordIds[part]);
+        shards[part] = NGramModel(model.getN());
+    }
+}
@@ -0,0 +1,44 @@
+/**
+ * @brief The header file declaring the streaming builder of the n-gram models: the words of a
+ * text are read straight out of the memory mapped file and fed one at a time into the model
+ * through a window of the last N - 1 words, so the text is never stored as a list of words.
+ * A large text can also be split between threads, which count their parts into models of their
+ * own that are then merged into the same model the single pass builds.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ngrammodel.h"
+using namespace std;
+
+/**
+ * The last N - 1 words fed into a model. Every word is written twice, N - 1 words apart, so the
+ * window is always a contiguous part of the ring and no word is ever shifted.
+ */
+class NGramStream {
+public:
+    NGramStream(NGramModel &model); //constructor, no words yet
+    void addWord(int id); //adds the n-gram ending with the word once there are N - 1 words before it
+    void wrap(); //feeds the first N - 1 words again, the windows wrapping around the end of the text
+
+private:
+    NGramModel &model;
+    int length; //N - 1
+    vector<int> ring; //twice N - 1 words
+    long long count; //number of words fed so far
+    vector<int> firstWords; //the first N - 1 words of the text
+
+    NGramStream(const NGramStream &other); //not copyable
+    NGramStream& operator= (const NGramStream &other);
+};
+
+bool nextWord(const char* &position, const char* end, const char* &word, size_t &length); //as "input >> word"
+//adds every n-gram, then finalizes, threadCount 0 for one thread per processor
+void buildNGramModel(const char* text, size_t size, NGramModel &model, int threadCount = 1);
+void buildNGramModel(const string &fileName, NGramModel &model, int threadCount = 1); //maps the file
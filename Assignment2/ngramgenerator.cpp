@@ -0,0 +1,244 @@
+/**
+ * @brief The following code involves the methods neccessary to generate random text from the
+ * arrays of an n-gram model. The random numbers come from SplitMix64 and are mapped to a range
+ * by a multiplication, rejecting the few values that would make some numbers more likely than
+ * others, so the successors are drawn with exactly the frequencies of the model. The words are
+ * copied into a buffer that is written out when it is full. The IndexGenerator keeps its window
+ * as word IDs and draws every successor from the occurrences of the window in the index, so it
+ * serves any N up to the maximum of the index with the same frequencies as a model of that N.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "ngramgenerator.h"
+#include <cstring>
+
+/**
+ * @brief TextGenerator::TextGenerator The constructor of the TextGenerator class.
+ * @param characters The characters of every word, which must outlive the generator.
+ * @param wordStarts The first character of every word, then the number of characters.
+ * @param seed The seed of the random numbers.
+ */
+TextGenerator::TextGenerator(const char* characters, const uint64_t* wordStarts, uint64_t seed) {
+    this->characters = characters;
+    this->wordStarts = wordStarts;
+    this->seed = seed;
+}
+
+/**
+ * @brief TextGenerator::~TextGenerator Destructor of the TextGenerator class.
+ */
+TextGenerator::~TextGenerator() {
+    //nothing to release
+}
+
+/**
+ * @brief TextGenerator::write Generates words and writes each of them followed by a space.
+ * @param out The stream to write to.
+ * @param count The number of words.
+ */
+void TextGenerator::write(ostream &out, long long count) {
+    vector<char> buffer(GENERATOR_BUFFER_SIZE);
+    size_t used = 0;
+    for (long long i = 0; i < count; i++) {
+        int word = nextWord();
+        const char* wordCharacters = characters + wordStarts[word];
+        size_t length = wordStarts[word + 1] - wordStarts[word];
+        if (used + length + 1 > buffer.size()) {
+            out.write(buffer.data(), used);
+            used = 0;
+            if (length + 1 > buffer.size()) {
+                buffer.resize(length + 1); //a single word longer than the buffer
+            }
+        }
+        memcpy(buffer.data() + used, wordCharacters, length);
+        buffer[used + length] = ' ';
+        used += length + 1;
+    }
+    out.write(buffer.data(), used);
+}
+
+/**
+ * @brief TextGenerator::random Returns the next number of SplitMix64.
+ * @return 64 random bits.
+ */
+uint64_t TextGenerator::random() {
+    uint64_t value = (seed += 0x9e3779b97f4a7c15ULL);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief TextGenerator::randomBelow Returns a uniformly random number below a bound, the high
+ * half of the product of 64 random bits and the bound, drawing again for the products whose
+ * low half falls in the part that would be over-represented.
+ * @param bound The bound, at least 1.
+ * @return A number from 0 to bound - 1.
+ */
+uint64_t TextGenerator::randomBelow(uint64_t bound) {
+    unsigned __int128 product = (unsigned __int128) random() * bound;
+    if ((uint64_t) product < bound) {
+        uint64_t threshold = -bound % bound; //2^64 mod bound
+        while ((uint64_t) product < threshold) {
+            product = (unsigned __int128) random() * bound;
+        }
+    }
+    return (uint64_t) (product >> 64);
+}
+
+/**
+ * @brief TextGenerator::writeWords Writes words, each followed by a space.
+ * @param out The stream to write to.
+ * @param ids The word IDs.
+ * @param count The number of words.
+ */
+void TextGenerator::writeWords(ostream &out, const int* ids, int count) const {
+    for (int i = 0; i < count; i++) {
+        out.write(characters + wordStarts[ids[i]], wordStarts[ids[i] + 1] - wordStarts[ids[i]]);
+        out << ' ';
+    }
+}
+
+/**
+ * @brief NGramGenerator::NGramGenerator The constructor of the NGramGenerator class.
+ * @param tables The arrays of a finalized model, which must outlive the generator.
+ * @param seed The seed of the random numbers.
+ */
+NGramGenerator::NGramGenerator(const NGramTables &tables, uint64_t seed)
+    : TextGenerator(tables.characters, tables.wordStarts, seed) {
+    if (tables.stateCount == 0) {
+        throw("The model has no words.");
+    }
+    this->tables = tables;
+    restart();
+}
+
+/**
+ * @brief NGramGenerator::restart Moves to a state picked at random, all states being equally
+ * likely.
+ */
+void NGramGenerator::restart() {
+    state = (int) randomBelow(tables.stateCount);
+}
+
+/**
+ * @brief NGramGenerator::getState Returns the current state.
+ * @return The state.
+ */
+int NGramGenerator::getState() const {
+    return state;
+}
+
+/**
+ * @brief NGramGenerator::nextWord Draws a successor of the current state from its alias table
+ * and moves to the state of the successor. If the model has no such state the generator
+ * restarts at a random state.
+ * @return The word ID of the successor.
+ */
+int NGramGenerator::nextWord() {
+    uint64_t first = tables.offsets[state];
+    uint64_t index = first + randomBelow(tables.offsets[state + 1] - first);
+    if (randomBelow(tables.totals[state]) >= tables.thresholds[index]) {
+        index = first + tables.aliases[index];
+    }
+    state = tables.nextStates[index];
+    if (state < 0) {
+        restart();
+    }
+    return tables.successors[index];
+}
+
+/**
+ * @brief NGramGenerator::writeWindow Writes the words of the current state, each followed by a
+ * space.
+ * @param out The stream to write to.
+ */
+void NGramGenerator::writeWindow(ostream &out) const {
+    writeWords(out, tables.windows + (size_t) state * (tables.N - 1), tables.N - 1);
+}
+
+/**
+ * @brief IndexGenerator::IndexGenerator The constructor of the IndexGenerator class.
+ * @param index The index of a text, which must outlive the generator.
+ * @param N The number of words of an n-gram, from 2 to the maximum of the index.
+ * @param backoff Whether or not a window that never occurs is shortened until it does, instead
+ * of restarting at a random window.
+ * @param seed The seed of the random numbers.
+ */
+IndexGenerator::IndexGenerator(const NGramIndex &index, int N, bool backoff, uint64_t seed)
+    : TextGenerator(index.getWords().getCharacters(), index.getWords().getStarts(), seed),
+      index(index) {
+    if (N < 2 || N > index.getMaxOrder()) {
+        throw("N is out of the range of the index.");
+    }
+    if (index.getTokenCount() == 0) {
+        throw("The model has no words.");
+    }
+    length = N - 1;
+    this->backoff = backoff;
+    index.getWindows(length, windows);
+    ring.assign(2 * length, 0);
+    restart();
+}
+
+/**
+ * @brief IndexGenerator::restart Moves to a window of the text picked at random among the
+ * distinct windows, so every window is as likely, as every state is for NGramGenerator.
+ */
+void IndexGenerator::restart() {
+    int start = windows[randomBelow(windows.size())];
+    for (int i = 0; i < length; i++) {
+        ring[i] = index.getToken(start + i);
+        ring[i + length] = ring[i];
+    }
+    position = 0;
+}
+
+/**
+ * @brief IndexGenerator::startWith Moves to the window of the last N - 1 words given, so the
+ * text goes on from them. Fewer words are completed in front by unknown words. A window that
+ * never occurs is backed off or replaced by a random one at the next word, as in nextWord. The
+ * words are not written, as they may be unknown.
+ * @param words The word IDs, -1 for a word that is not in the text.
+ */
+void IndexGenerator::startWith(const vector<int> &words) {
+    for (int i = 0; i < length; i++) {
+        int word = (int) words.size() - length + i;
+        ring[i] = word >= 0 ? words[word] : -1;
+        ring[i + length] = ring[i];
+    }
+    position = 0;
+}
+
+/**
+ * @brief IndexGenerator::nextWord Draws a successor of the current window from its occurrences
+ * and moves the window by one word. A window of the text always occurs, the other windows are
+ * backed off or replaced by a random one.
+ * @return The word ID of the successor.
+ */
+int IndexGenerator::nextWord() {
+    IndexRange range;
+    if (backoff) {
+        index.backOff(ring.data() + position, length, range);
+    } else if (!index.findWindow(ring.data() + position, length, range)) {
+        restart();
+        index.findWindow(ring.data() + position, length, range);
+    }
+    int word = index.drawSuccessor(range, randomBelow(range.last - range.first));
+    //the oldest word's copies become the newest word, the window starts one word later
+    ring[position] = word;
+    ring[position + length] = word;
+    position = (position + 1) % length;
+    return word;
+}
+
+/**
+ * @brief IndexGenerator::writeWindow Writes the words of the current window, each followed by
+ * a space.
+ * @param out The stream to write to.
+ */
+void IndexGenerator::writeWindow(ostream &out) const {
+    writeWords(out, ring.data() + position, length);
+}
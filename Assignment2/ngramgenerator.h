@@ -0,0 +1,79 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the
+ * NGramGenerator class, which walks the Markov chain of a finalized n-gram model (see
+ * ngrammodel.h) to write random text. The current window is a state number and every step
+ * draws a successor from the alias table of the state and moves to the state stored for that
+ * successor, so a step reads a few array entries and never looks up a window. The
+ * IndexGenerator walks the same chain for any N through an NGramIndex (see ngramindex.h)
+ * instead, looking up the range of its window at every step. Both share the random numbers and
+ * the buffered writing of the TextGenerator class.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "ngramindex.h"
+#include "ngrammodel.h"
+using namespace std;
+
+//constant decleration(s)
+const size_t GENERATOR_BUFFER_SIZE = 1 << 16; //characters written at once
+
+class TextGenerator {
+public:
+    virtual ~TextGenerator(); //destructor
+    virtual void restart() = 0; //moves to a random window
+    virtual int nextWord() = 0; //draws the next word ID and moves the window
+    virtual void writeWindow(ostream &out) const = 0; //writes the N - 1 words of the current window
+    void write(ostream &out, long long count); //writes that many words, each followed by a space
+
+protected:
+    TextGenerator(const char* characters, const uint64_t* wordStarts, uint64_t seed);
+    uint64_t random(); //the next 64 random bits
+    uint64_t randomBelow(uint64_t bound); //a uniform number from 0 to bound - 1
+    void writeWords(ostream &out, const int* ids, int count) const; //each followed by a space
+
+private:
+    const char* characters; //the characters of every word
+    const uint64_t* wordStarts; //the first character of every word, then the number of characters
+    uint64_t seed; //state of the random numbers
+};
+
+class NGramGenerator : public TextGenerator {
+public:
+    NGramGenerator(const NGramTables &tables, uint64_t seed); //constructor, starts at a random state
+    void restart(); //moves to a random state, every state is as likely
+    int getState() const; //accessor method for the current state
+    int nextWord(); //draws the next word ID and moves to the next state
+    void writeWindow(ostream &out) const; //writes the N - 1 words of the current state
+
+private:
+    NGramTables tables;
+    int state;
+};
+
+class IndexGenerator : public TextGenerator {
+public:
+    //constructor, starts at a random window, backing off to shorter windows that occur if asked to
+    IndexGenerator(const NGramIndex &index, int N, bool backoff, uint64_t seed);
+    void restart(); //moves to a random window, every window is as likely
+    void startWith(const vector<int> &words); //moves to the last N - 1 words given, -1 if unknown
+    int nextWord(); //draws the next word ID after the window and moves the window
+    void writeWindow(ostream &out) const; //writes the N - 1 words of the current window
+
+private:
+    const NGramIndex &index;
+    int length; //N - 1
+    bool backoff;
+    vector<int> windows; //a position of every distinct window of the text
+    vector<int> ring; //the window, every word written twice, as in NGramStream
+    int position; //where the window starts in the ring
+
+    IndexGenerator(const IndexGenerator &other); //not copyable
+    IndexGenerator& operator= (const IndexGenerator &other);
+};
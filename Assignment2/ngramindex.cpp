@@ -0,0 +1,246 @@
+/**
+ * @brief The following code involves the methods neccessary to build and search the suffix
+ * array of the word IDs of a text. The words are interned in the order they are read, so the IDs
+ * are the ones the builder gives (see ngrambuilder.h), and the first maxOrder - 1 words are
+ * appended to the text, so every position starts a window of every length, wrapping around the
+ * end of the text as the models do. The positions are sorted by their first maxOrder words, ties
+ * kept in the order of the text, so for a window of k < maxOrder words the positions it starts
+ * at are contiguous and, inside them, sorted by the word after the window. A range is found by
+ * two binary searches comparing at most k words a step and one uniform position of the range
+ * draws a successor with its frequency, without any table built per N. The sort is a counting
+ * sort by one word at a time, the last one first, so it is linear in the words of the text.
+ * Backing off drops the first words of a window that never occurs, until the rest does: the
+ * shorter window is more general and always has successors, the empty one being the whole text.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "ngramindex.h"
+#include <algorithm>
+#include <climits>
+#include "mappedfile.h"
+#include "ngrambuilder.h"
+
+/**
+ * @brief NGramIndex::NGramIndex The constructor of the NGramIndex class.
+ * @param maxOrder The largest N served, at least 2.
+ */
+NGramIndex::NGramIndex(int maxOrder) {
+    if (maxOrder < 2) {
+        throw("N must be 2 or greater.");
+    }
+    this->maxOrder = maxOrder;
+    tokenCount = 0;
+}
+
+/**
+ * @brief NGramIndex::build Interns the words of a text and sorts its positions.
+ * @param text The characters of the text.
+ * @param size The number of characters.
+ */
+void NGramIndex::build(const char* text, size_t size) {
+    words = WordTable();
+    tokens.clear();
+    positions.clear();
+    tokenCount = 0;
+    const char* position = text;
+    const char* end = text + size;
+    const char* word;
+    size_t length;
+    while (nextWord(position, end, word, length)) {
+        if (tokens.size() >= (size_t) (INT_MAX - maxOrder)) {
+            throw("The text has too many words for the index.");
+        }
+        tokens.push_back(words.intern(word, length));
+    }
+    tokenCount = (int) tokens.size();
+    if (tokenCount == 0) {
+        return;
+    }
+    for (int i = 0; i < maxOrder - 1; i++) { //the case for wrapping, repeating a short text
+        tokens.push_back(tokens[i % tokenCount]);
+    }
+    positions.resize(tokenCount);
+    for (int i = 0; i < tokenCount; i++) {
+        positions[i] = i;
+    }
+    //a stable counting sort by every word of the window, the last word first, so the positions
+    //end up sorted by their first maxOrder words, ties in the order of the text
+    vector<int> sorted(tokenCount);
+    vector<int> starts(words.size() + 1);
+    for (int offset = maxOrder - 1; offset >= 0; offset--) {
+        fill(starts.begin(), starts.end(), 0);
+        for (int i = 0; i < tokenCount; i++) {
+            starts[tokens[i + offset] + 1]++;
+        }
+        for (int id = 0; id < words.size(); id++) {
+            starts[id + 1] += starts[id];
+        }
+        for (int i = 0; i < tokenCount; i++) {
+            int start = positions[i];
+            sorted[starts[tokens[start + offset]]++] = start;
+        }
+        positions.swap(sorted);
+    }
+}
+
+/**
+ * @brief NGramIndex::build Maps a file into memory and builds the index of its text.
+ * @param fileName The name of the file.
+ */
+void NGramIndex::build(const string &fileName) {
+    MappedFile file;
+    openMappedFile(fileName, file);
+    try {
+        build(file.data, file.size);
+    } catch (...) {
+        closeMappedFile(file);
+        throw;
+    }
+    closeMappedFile(file);
+}
+
+/**
+ * @brief NGramIndex::getMaxOrder Returns the largest N the index serves.
+ * @return The largest N.
+ */
+int NGramIndex::getMaxOrder() const {
+    return maxOrder;
+}
+
+/**
+ * @brief NGramIndex::getTokenCount Returns the number of words of the text.
+ * @return The number of words, counting every occurrence.
+ */
+int NGramIndex::getTokenCount() const {
+    return tokenCount;
+}
+
+/**
+ * @brief NGramIndex::getToken Returns the word ID at a position of the text.
+ * @param position The position, from 0 to the number of words plus maxOrder - 2.
+ * @return The word ID.
+ */
+int NGramIndex::getToken(int position) const {
+    return tokens[position];
+}
+
+/**
+ * @brief NGramIndex::getWords Returns the words of the text.
+ * @return The word table.
+ */
+const WordTable& NGramIndex::getWords() const {
+    return words;
+}
+
+/**
+ * @brief NGramIndex::findWindow Finds the sorted positions where a window occurs.
+ * @param window The word IDs of the window.
+ * @param length The number of words, from 0 to maxOrder - 1.
+ * @param range Set to the positions, empty if the window never occurs.
+ * @return True if the window occurs.
+ */
+bool NGramIndex::findWindow(const int* window, int length, IndexRange &range) const {
+    if (length < 0 || length >= maxOrder) {
+        throw("The window is longer than the index allows.");
+    }
+    const NGramIndex* index = this;
+    range.first = (int) (lower_bound(positions.begin(), positions.end(), 0,
+                                     [index, window, length](int position, int) {
+        return index->compare(position, window, length) < 0;
+    }) - positions.begin());
+    range.last = (int) (upper_bound(positions.begin() + range.first, positions.end(), 0,
+                                    [index, window, length](int, int position) {
+        return index->compare(position, window, length) > 0;
+    }) - positions.begin());
+    range.length = length;
+    return range.first < range.last;
+}
+
+/**
+ * @brief NGramIndex::backOff Finds the longest last words of a window that occur in the text,
+ * dropping its first words one at a time.
+ * @param window The word IDs of the window.
+ * @param length The number of words, from 0 to maxOrder - 1.
+ * @param range Set to the positions of the words kept, range.length of them. It is only empty
+ * if the text is.
+ */
+void NGramIndex::backOff(const int* window, int length, IndexRange &range) const {
+    for (int dropped = 0; dropped < length; dropped++) {
+        if (findWindow(window + dropped, length - dropped, range)) {
+            return;
+        }
+    }
+    findWindow(window + length, 0, range);
+}
+
+/**
+ * @brief NGramIndex::drawSuccessor Returns the word after one of the occurrences of a window,
+ * so every successor is as likely as its frequency makes it.
+ * @param range The occurrences of the window, not empty.
+ * @param unit A uniform number below the number of occurrences.
+ * @return The word ID of the successor.
+ */
+int NGramIndex::drawSuccessor(const IndexRange &range, uint64_t unit) const {
+    return tokens[positions[range.first + (int) unit] + range.length];
+}
+
+/**
+ * @brief NGramIndex::getWindows Lists the distinct windows of a length that occur in the text,
+ * the first position of every run of equal windows in the sorted positions.
+ * @param length The number of words of a window, up to maxOrder - 1.
+ * @param windows The positions, one per distinct window, in the order of the windows.
+ */
+void NGramIndex::getWindows(int length, vector<int> &windows) const {
+    windows.clear();
+    for (int rank = 0; rank < tokenCount; rank++) {
+        if (rank == 0 || compare(positions[rank], tokens.data() + positions[rank - 1], length) != 0) {
+            windows.push_back(positions[rank]);
+        }
+    }
+}
+
+/**
+ * @brief NGramIndex::buildModel Fills an empty model with the n-grams of the text and
+ * finalizes it, without reading the text again. The model is the one buildNGramModel builds
+ * from the same text, with the same word IDs.
+ * @param model An empty model whose N is at most maxOrder.
+ */
+void NGramIndex::buildModel(NGramModel &model) const {
+    if (model.getN() > maxOrder) {
+        throw("N is larger than the index allows.");
+    }
+    if (model.getWords().size() != 0 || model.getStateCount() != 0) {
+        throw("The model must be empty.");
+    }
+    WordTable &modelWords = model.getWords();
+    for (int id = 0; id < words.size(); id++) {
+        modelWords.intern(words.wordData(id), words.wordLength(id));
+    }
+    NGramStream stream(model);
+    for (int position = 0; position < tokenCount; position++) {
+        stream.addWord(tokens[position]);
+    }
+    stream.wrap();
+    model.finalize();
+}
+
+/**
+ * @brief NGramIndex::compare Compares the words at a position of the text to a window, word
+ * by word.
+ * @param position The position.
+ * @param window The word IDs of the window.
+ * @param length The number of words compared.
+ * @return A negative number if the words at the position come first, 0 if they are the window
+ * and a positive number otherwise.
+ */
+int NGramIndex::compare(int position, const int* window, int length) const {
+    const int* ids = tokens.data() + position;
+    for (int i = 0; i < length; i++) {
+        if (ids[i] != window[i]) {
+            return ids[i] < window[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the NGramIndex
+ * class, a suffix array over the word IDs of a text that serves the n-grams of every N up to a
+ * maximum. The positions of the text are sorted by the words that start there, so the
+ * occurrences of any window of up to maxOrder - 1 words are a range of the sorted positions,
+ * found by binary search, and the words after them are the successors of the window, sorted too.
+ * Picking a position of the range at random draws a successor with its exact frequency. The
+ * text is tokenized and sorted once, after which N can change without reading the text again.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ngrammodel.h"
+#include "wordtable.h"
+using namespace std;
+
+/**
+ * The occurrences of a window: the sorted positions [first, last), a window of length words.
+ */
+struct IndexRange {
+    int first;
+    int last;
+    int length;
+};
+
+class NGramIndex {
+public:
+    NGramIndex(int maxOrder); //constructor, serves every N from 2 to maxOrder
+    void build(const char* text, size_t size); //tokenizes and sorts a text, replacing the one before
+    void build(const string &fileName); //maps the file
+    int getMaxOrder() const; //accessor method for the largest N
+    int getTokenCount() const; //the number of words of the text
+    int getToken(int position) const; //word ID at a position, the text wrapping around its end
+    const WordTable& getWords() const; //the words of the text
+    bool findWindow(const int* window, int length, IndexRange &range) const; //false if it never occurs
+    void backOff(const int* window, int length, IndexRange &range) const; //the longest last words that occur
+    int drawSuccessor(const IndexRange &range, uint64_t unit) const; //unit < range.last - range.first
+    void getWindows(int length, vector<int> &windows) const; //a position of every distinct window
+    void buildModel(NGramModel &model) const; //the model of an N up to maxOrder, as buildNGramModel builds it
+
+private:
+    int compare(int position, const int* window, int length) const; //the words at a position to a window
+
+    int maxOrder;
+    WordTable words;
+    vector<int> tokens; //the word IDs of the text, then its first maxOrder - 1 again
+    int tokenCount; //the number of words of the text
+    vector<int> positions; //every position, sorted by its first maxOrder words
+
+    NGramIndex(const NGramIndex &other); //not copyable
+    NGramIndex& operator= (const NGramIndex &other);
+};
@@ -0,0 +1,478 @@
+/**
+ * @brief The following code involves the methods neccessary to store the states of an n-gram
+ * model. The word IDs of a state are packed two to a 64 bit word and mixed into a hash, which
+ * is kept next to the IDs and compared before them while probing the open addressing table.
+ * While the model is built, every distinct (state, successor) pair is a transition with a count,
+ * found through a second open addressing table. finalize groups the transitions by state, in
+ * the order they were first seen, and builds Walker's alias table of every state with integers:
+ * a state with k successors and a total of T has k columns of T units each, successor i keeps
+ * thresholds[i] units of column i and gives the rest to aliases[i], so that every successor owns
+ * exactly k times its frequency in units and a uniform column and a uniform unit pick it with
+ * probability frequency / T, exactly as picking one of the T occurrences would. finalize also
+ * looks up, once for every successor, the state its window moves to, so a generator only
+ * follows indices.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "ngrammodel.h"
+#include <algorithm>
+
+//constant decleration(s)
+const int FIRST_STATE_SLOTS = 1024; //a power of 2
+const int FIRST_TRANSITION_SLOTS = 1024; //a power of 2
+
+/**
+ * @brief mix The finalizer of SplitMix64, every bit of the result depends on every bit of the
+ * input.
+ * @param value The value to mix.
+ * @return The mixed value.
+ */
+static uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief NGramModel::NGramModel The constructor of the NGramModel class.
+ * @param N The number of words of an n-gram: N - 1 words of a state and their successor.
+ */
+NGramModel::NGramModel(int N) {
+    if (N < 2) {
+        throw("N must be 2 or greater.");
+    }
+    this->N = N;
+    finalized = false;
+    slots.assign(FIRST_STATE_SLOTS, -1);
+    transitionSlots.assign(FIRST_TRANSITION_SLOTS, -1);
+}
+
+/**
+ * @brief NGramModel::add Adds a successor to a state, adding the state if it is new.
+ * @param window The N - 1 word IDs of the state.
+ * @param successor The word ID of the successor.
+ */
+void NGramModel::add(const int* window, int successor) {
+    if (finalized) {
+        throw("The model is already finalized.");
+    }
+    addTransition(addState(window), successor, 1);
+}
+
+/**
+ * @brief NGramModel::merge Adds the counts of a model that is not finalized, as if its n-grams
+ * were added after the ones of this model: its states and successors which are new here come
+ * after the existing ones, in the order they were first seen there.
+ * @param shard The model to add, with the same N.
+ * @param wordIds The ID in this model of every word ID of the shard.
+ */
+void NGramModel::merge(const NGramModel &shard, const vector<int> &wordIds) {
+    if (finalized || shard.finalized) {
+        throw("Only models that are not finalized can be merged.");
+    }
+    if (shard.N != N) {
+        throw("The models do not have the same N.");
+    }
+    vector<int> states(shard.getStateCount(), -1); //the state here of every state of the shard
+    vector<int> window(N - 1);
+    //a state of the shard is added with its first transition, so the states come in order
+    for (size_t t = 0; t < shard.transitionStates.size(); t++) {
+        int state = shard.transitionStates[t];
+        if (states[state] < 0) {
+            for (int i = 0; i < N - 1; i++) {
+                window[i] = wordIds[shard.getWindow(state)[i]];
+            }
+            states[state] = addState(window.data());
+        }
+        addTransition(states[state], wordIds[shard.transitionSuccessors[t]], shard.transitionCounts[t]);
+    }
+}
+
+/**
+ * @brief NGramModel::finalize Groups the successors by state and builds the alias table of
+ * every state. The transitions are released afterwards.
+ */
+void NGramModel::finalize() {
+    if (finalized) {
+        return;
+    }
+    int states = getStateCount();
+    offsets.assign(states + 1, 0);
+    for (size_t t = 0; t < transitionStates.size(); t++) {
+        offsets[transitionStates[t] + 1]++;
+    }
+    for (int state = 0; state < states; state++) {
+        offsets[state + 1] += offsets[state];
+    }
+    successors.resize(transitionStates.size());
+    frequencies.resize(transitionStates.size());
+    totals.assign(states, 0);
+    vector<uint64_t> next(offsets.begin(), offsets.end() - 1); //next free index of every state
+    for (size_t t = 0; t < transitionStates.size(); t++) {
+        int state = transitionStates[t];
+        successors[next[state]] = transitionSuccessors[t];
+        frequencies[next[state]] = transitionCounts[t];
+        totals[state] += transitionCounts[t];
+        next[state]++;
+    }
+    vector<int>().swap(transitionStates);
+    vector<int>().swap(transitionSuccessors);
+    vector<uint32_t>().swap(transitionCounts);
+    vector<int>().swap(transitionSlots);
+    thresholds.resize(successors.size());
+    aliases.resize(successors.size());
+    nextStates.resize(successors.size());
+    vector<int> window(N - 1);
+    for (int state = 0; state < states; state++) {
+        buildAliasTable(state);
+        copy(getWindow(state) + 1, getWindow(state) + N - 1, window.begin());
+        for (uint64_t index = offsets[state]; index < offsets[state + 1]; index++) {
+            window[N - 2] = successors[index];
+            nextStates[index] = findState(window.data());
+        }
+    }
+    finalized = true;
+}
+
+/**
+ * @brief NGramModel::isFinalized Checks whether or not the model was finalized.
+ * @return True if finalize was called.
+ */
+bool NGramModel::isFinalized() const {
+    return finalized;
+}
+
+/**
+ * @brief NGramModel::findState Returns the state of a window of words.
+ * @param window The N - 1 word IDs.
+ * @return The state, -1 if the window never occurred.
+ */
+int NGramModel::findState(const int* window) const {
+    return slots[findSlot(window, hashWindow(window, N - 1))];
+}
+
+/**
+ * @brief NGramModel::getStateCount Returns the number of states, which are numbered from 0 in
+ * the order they were added.
+ * @return The number of states.
+ */
+int NGramModel::getStateCount() const {
+    return (int) hashes.size();
+}
+
+/**
+ * @brief NGramModel::getWindow Returns the words of a state.
+ * @param state The state.
+ * @return The N - 1 word IDs.
+ */
+const int* NGramModel::getWindow(int state) const {
+    return windows.data() + (size_t) state * (N - 1);
+}
+
+/**
+ * @brief NGramModel::getSuccessorCount Returns the number of distinct successors of a state.
+ * The model must be finalized.
+ * @param state The state.
+ * @return The number of successors.
+ */
+int NGramModel::getSuccessorCount(int state) const {
+    return (int) (offsets[state + 1] - offsets[state]);
+}
+
+/**
+ * @brief NGramModel::getSuccessor Returns a successor of a state. The model must be finalized.
+ * @param state The state.
+ * @param index The index of the successor, they are in the order they were first seen.
+ * @return The word ID of the successor.
+ */
+int NGramModel::getSuccessor(int state, int index) const {
+    return successors[offsets[state] + index];
+}
+
+/**
+ * @brief NGramModel::getFrequency Returns the number of times a successor followed its state.
+ * The model must be finalized.
+ * @param state The state.
+ * @param index The index of the successor.
+ * @return The frequency of the successor.
+ */
+uint32_t NGramModel::getFrequency(int state, int index) const {
+    return frequencies[offsets[state] + index];
+}
+
+/**
+ * @brief NGramModel::getTotal Returns the number of times a state was followed by a word, the
+ * sum of the frequencies of its successors. The model must be finalized.
+ * @param state The state.
+ * @return The total.
+ */
+uint64_t NGramModel::getTotal(int state) const {
+    return totals[state];
+}
+
+/**
+ * @brief NGramModel::drawSuccessor Picks a successor of a state with the alias table, given a
+ * uniformly random column and unit. The model must be finalized.
+ * @param state The state.
+ * @param column A random number from 0 to getSuccessorCount(state) - 1.
+ * @param unit A random number from 0 to getTotal(state) - 1.
+ * @return The word ID of the successor, picked with probability frequency / total.
+ */
+int NGramModel::drawSuccessor(int state, int column, uint64_t unit) const {
+    uint64_t index = offsets[state] + column;
+    if (unit >= thresholds[index]) {
+        index = offsets[state] + aliases[index];
+    }
+    return successors[index];
+}
+
+/**
+ * @brief NGramModel::getNextState Returns the state a successor moves to: the window of the
+ * state without its first word, followed by the successor. The model must be finalized.
+ * @param state The state.
+ * @param index The index of the successor.
+ * @return The next state, -1 if that window is not in the model, which only happens when the
+ * n-grams were not added from a single wrapping text.
+ */
+int NGramModel::getNextState(int state, int index) const {
+    return nextStates[offsets[state] + index];
+}
+
+/**
+ * @brief NGramModel::getTables Returns the arrays of the model, which stay valid as long as the
+ * model is not changed. The model must be finalized.
+ * @return The arrays.
+ */
+NGramTables NGramModel::getTables() const {
+    if (!finalized) {
+        throw("The model is not finalized.");
+    }
+    NGramTables tables;
+    tables.N = N;
+    tables.stateCount = getStateCount();
+    tables.wordCount = words.size();
+    tables.windows = windows.data();
+    tables.offsets = offsets.data();
+    tables.totals = totals.data();
+    tables.successors = successors.data();
+    tables.frequencies = frequencies.data();
+    tables.thresholds = thresholds.data();
+    tables.aliases = aliases.data();
+    tables.nextStates = nextStates.data();
+    tables.characters = words.getCharacters();
+    tables.wordStarts = words.getStarts();
+    return tables;
+}
+
+/**
+ * @brief NGramModel::getN Returns the number of words of an n-gram.
+ * @return N.
+ */
+int NGramModel::getN() const {
+    return N;
+}
+
+/**
+ * @brief NGramModel::getWords Returns the words of the model.
+ * @return The word table.
+ */
+WordTable& NGramModel::getWords() {
+    return words;
+}
+
+/**
+ * @brief NGramModel::getWords Returns the words of the model.
+ * @return The word table.
+ */
+const WordTable& NGramModel::getWords() const {
+    return words;
+}
+
+/**
+ * @brief NGramModel::hashWindow Hashes the word IDs of a window, two IDs at a time packed into a
+ * 64 bit word.
+ * @param window The word IDs.
+ * @param length The number of word IDs.
+ * @return The hash.
+ */
+uint64_t NGramModel::hashWindow(const int* window, int length) {
+    uint64_t hash = (uint64_t) length;
+    for (int i = 0; i < length; i += 2) {
+        uint64_t packed = (uint32_t) window[i];
+        if (i + 1 < length) {
+            packed |= (uint64_t) (uint32_t) window[i + 1] << 32;
+        }
+        hash = mix(hash ^ packed);
+    }
+    return hash;
+}
+
+/**
+ * @brief NGramModel::grow Doubles the number of slots and puts every state back, using the
+ * hashes kept for the states.
+ */
+void NGramModel::grow() {
+    slots.assign(slots.size() * 2, -1);
+    size_t mask = slots.size() - 1;
+    for (int state = 0; state < getStateCount(); state++) {
+        size_t slot = hashes[state] & mask;
+        while (slots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = state;
+    }
+}
+
+/**
+ * @brief NGramModel::findSlot Finds the slot of a window, or the empty slot it would be put in.
+ * @param window The N - 1 word IDs.
+ * @param hash The hash of the window.
+ * @return The index of the slot.
+ */
+int NGramModel::findSlot(const int* window, uint64_t hash) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    while (slots[slot] >= 0) {
+        int state = slots[slot];
+        if (hashes[state] == hash && equal(window, window + N - 1, getWindow(state))) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return (int) slot;
+}
+
+/**
+ * @brief NGramModel::addState Finds the state of a window, adding it if it is new.
+ * @param window The N - 1 word IDs of the state.
+ * @return The state.
+ */
+int NGramModel::addState(const int* window) {
+    uint64_t hash = hashWindow(window, N - 1);
+    int slot = findSlot(window, hash);
+    int state = slots[slot];
+    if (state < 0) {
+        state = getStateCount();
+        windows.insert(windows.end(), window, window + N - 1);
+        hashes.push_back(hash);
+        slots[slot] = state;
+        if ((size_t) getStateCount() * 2 > slots.size()) { //at most half of the slots are used
+            grow();
+        }
+    }
+    return state;
+}
+
+/**
+ * @brief NGramModel::addTransition Adds to the count of a successor of a state, adding the
+ * successor if it is new.
+ * @param state The state.
+ * @param successor The word ID of the successor.
+ * @param count The number of times the state was followed by the successor.
+ */
+void NGramModel::addTransition(int state, int successor, uint32_t count) {
+    int slot = findTransitionSlot(state, successor);
+    if (transitionSlots[slot] >= 0) {
+        transitionCounts[transitionSlots[slot]] += count;
+        return;
+    }
+    transitionSlots[slot] = (int) transitionStates.size();
+    transitionStates.push_back(state);
+    transitionSuccessors.push_back(successor);
+    transitionCounts.push_back(count);
+    if (transitionStates.size() * 2 > transitionSlots.size()) { //at most half of the slots are used
+        growTransitions();
+    }
+}
+
+/**
+ * @brief NGramModel::growTransitions Doubles the number of transition slots and puts every
+ * transition back.
+ */
+void NGramModel::growTransitions() {
+    transitionSlots.assign(transitionSlots.size() * 2, -1);
+    size_t mask = transitionSlots.size() - 1;
+    for (size_t t = 0; t < transitionStates.size(); t++) {
+        size_t slot = hashTransition(transitionStates[t], transitionSuccessors[t]) & mask;
+        while (transitionSlots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        transitionSlots[slot] = (int) t;
+    }
+}
+
+/**
+ * @brief NGramModel::findTransitionSlot Finds the slot of a transition, or the empty slot it
+ * would be put in.
+ * @param state The state.
+ * @param successor The word ID of the successor.
+ * @return The index of the slot.
+ */
+int NGramModel::findTransitionSlot(int state, int successor) const {
+    size_t mask = transitionSlots.size() - 1;
+    size_t slot = hashTransition(state, successor) & mask;
+    while (transitionSlots[slot] >= 0) {
+        int t = transitionSlots[slot];
+        if (transitionStates[t] == state && transitionSuccessors[t] == successor) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return (int) slot;
+}
+
+/**
+ * @brief NGramModel::buildAliasTable Builds the alias table of a state. Every successor starts
+ * with k times its frequency in units, the successors with less than a column (T units) fill
+ * their column with units of one with more, until every column is full.
+ * @param state The state.
+ */
+void NGramModel::buildAliasTable(int state) {
+    int count = getSuccessorCount(state);
+    uint64_t first = offsets[state];
+    uint64_t total = totals[state];
+    vector<uint64_t> units(count);
+    vector<int> small;
+    vector<int> large;
+    for (int i = 0; i < count; i++) {
+        units[i] = (uint64_t) frequencies[first + i] * count;
+        if (units[i] < total) {
+            small.push_back(i);
+        } else {
+            large.push_back(i);
+        }
+    }
+    while (!small.empty() && !large.empty()) {
+        int lender = large.back();
+        int borrower = small.back();
+        small.pop_back();
+        thresholds[first + borrower] = units[borrower];
+        aliases[first + borrower] = lender;
+        units[lender] -= total - units[borrower];
+        if (units[lender] < total) {
+            large.pop_back();
+            small.push_back(lender);
+        }
+    }
+    //what is left fills its own column exactly
+    for (size_t i = 0; i < large.size(); i++) {
+        thresholds[first + large[i]] = total;
+        aliases[first + large[i]] = large[i];
+    }
+    for (size_t i = 0; i < small.size(); i++) {
+        thresholds[first + small[i]] = total;
+        aliases[first + small[i]] = small[i];
+    }
+}
+
+/**
+ * @brief NGramModel::hashTransition Hashes a state and a successor, packed into a 64 bit word.
+ * @param state The state.
+ * @param successor The word ID of the successor.
+ * @return The hash.
+ */
+uint64_t NGramModel::hashTransition(int state, int successor) {
+    return mix(((uint64_t) (uint32_t) state << 32) | (uint32_t) successor);
+}
@@ -0,0 +1,96 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the NGramModel
+ * class, the Markov chain of the random writer. A state is a window of N - 1 consecutive words
+ * of the text and its successors are the words that follow the window in the text. The words
+ * are interned into IDs (see wordtable.h) and the states are found by a hash of their IDs in an
+ * open addressing table, instead of comparing vectors of strings in a tree. A successor is kept
+ * once per state with the number of times it followed the state, and finalize builds an alias
+ * table for every state, so a successor is drawn with its exact frequency in constant time,
+ * and the state that follows every successor, so a text is generated without looking up any
+ * window.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "wordtable.h"
+using namespace std;
+
+/**
+ * The arrays of a finalized model, all a generator needs. The successors of state s are the
+ * indices [offsets[s], offsets[s + 1]) of the successor arrays and word w is the characters
+ * [wordStarts[w], wordStarts[w + 1]).
+ */
+struct NGramTables {
+    int N;
+    int stateCount;
+    int wordCount;
+    const int* windows; //N - 1 word IDs per state
+    const uint64_t* offsets; //stateCount + 1 offsets
+    const uint64_t* totals; //the sum of the frequencies of every state
+    const int* successors; //word IDs
+    const uint32_t* frequencies;
+    const uint64_t* thresholds; //the alias tables
+    const int* aliases;
+    const int* nextStates; //the state after every successor, -1 if the model has none
+    const char* characters; //the characters of every word
+    const uint64_t* wordStarts; //wordCount + 1 starts
+};
+
+class NGramModel {
+public:
+    NGramModel(int N); //constructor, N is at least 2
+    void add(const int* window, int successor); //adds a successor to the state of the N - 1 words
+    void merge(const NGramModel &shard, const vector<int> &wordIds); //adds the counts of another model
+    void finalize(); //builds the alias tables, no successor can be added afterwards
+    bool isFinalized() const; //checks whether or not finalize was called
+    int findState(const int* window) const; //returns the state of the N - 1 words, -1 if there is none
+    int getStateCount() const; //returns the number of states
+    const int* getWindow(int state) const; //the N - 1 word IDs of a state
+    int getSuccessorCount(int state) const; //number of distinct successors, once finalized
+    int getSuccessor(int state, int index) const; //word ID of a successor, in the order they were seen
+    uint32_t getFrequency(int state, int index) const; //number of times a successor followed the state
+    uint64_t getTotal(int state) const; //number of times the state was followed by a word
+    int drawSuccessor(int state, int column, uint64_t unit) const; //column < successors, unit < total
+    int getNextState(int state, int index) const; //the state after a successor, -1 if there is none
+    NGramTables getTables() const; //the arrays of the model, once finalized
+    int getN() const; //accessor method for N
+    WordTable& getWords(); //the words of the model
+    const WordTable& getWords() const;
+
+    static uint64_t hashWindow(const int* window, int length); //64 bit hash of the word IDs
+
+private:
+    void grow(); //doubles the number of slots
+    int findSlot(const int* window, uint64_t hash) const;
+    int addState(const int* window); //returns the state of the window, adding it if it is new
+    void addTransition(int state, int successor, uint32_t count);
+    void growTransitions(); //doubles the number of transition slots
+    int findTransitionSlot(int state, int successor) const;
+    void buildAliasTable(int state);
+    static uint64_t hashTransition(int state, int successor);
+
+    int N;
+    WordTable words;
+    vector<int> windows; //the N - 1 word IDs of every state, one after the other
+    vector<uint64_t> hashes; //the hash of every state, so the slots can grow without rehashing
+    vector<int> slots; //open addressing, a state or -1, a power of 2 long
+    bool finalized;
+    //while the model is built: a transition is a state, a successor and their count, in order
+    vector<int> transitionStates;
+    vector<int> transitionSuccessors;
+    vector<uint32_t> transitionCounts;
+    vector<int> transitionSlots; //open addressing, a transition or -1, a power of 2 long
+    //once finalized: the successors of state s are the indices [offsets[s], offsets[s + 1])
+    vector<uint64_t> offsets;
+    vector<int> successors; //word IDs
+    vector<uint32_t> frequencies;
+    vector<uint64_t> totals; //the sum of the frequencies of every state
+    vector<uint64_t> thresholds; //the part of its column a successor keeps, out of the total
+    vector<int> aliases; //the successor that takes the rest of the column
+    vector<int> nextStates; //the window of a state without its first word, then the successor
+};
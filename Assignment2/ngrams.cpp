@@ -3,65 +3,124 @@
   * from the information on a file. The generated sounds just like the author of the input text
   * because random text generation works like a Markov chain that each element is placed
   * according to its weighted probability. The code below involves functions and variables to
-  * store and produce text.
+  * store and produce text. A text is indexed once (see ngramindex.h) and the text of every N up
+  * to MAX_N is generated from the index, without reading the text again or building a model.
+  * The index holds two integers per word of the text, larger N are counted from the text by the
+  * parallel builder instead, whose memory is bounded by the model. A text can start with words
+  * of the user, backing off to their last words that occur in the text if asked to. The model
+  * of an N can be saved as a compiled model (a ".ngram" file, see modelfile.h), which is used
+  * straight from the disk when it is given as the input file instead of a text.
   * @author EFE ACER
   * CS106B - Section Leader: Ryan Kurohara
   */
 
 //necessary includes
+#include <algorithm>
 #include <cctype>
+#include <climits>
 #include <cmath>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 #include "console.h"
 #include "filelib.h"
 #include "simpio.h"
-#include "map.h"
-#include "vector.h"
 #include "random.h"
+#include "ngrambuilder.h"
+#include "ngramgenerator.h"
+#include "ngramindex.h"
+#include "ngrammodel.h"
+#include "wordtable.h"
+#include "modelfile.h"
 
 using namespace std;
 
 //constant declerations for further editing
+const int MAX_N = 10; //the largest N whose model is built from the index of a text
 const string INTRO = "Welcome to CS 106B Random Writer ('N-Grams').\n"
                      "This program makes random text based on a document.\n"
                      "Give me an input file and an 'N' value for groups\n"
                      "of words, and I'll create random text for you.\n\n";
 const string PROMPT_FILE = "Input file name? ";
-const string PROMPT_N = "Value of N? ";
+const string PROMPT_N = "Value of N (0 to quit)? ";
 const string PROMPT_RANDOM_WORD_NUMBER = "# of random words to generate (0 to quit)? ";
 const string N_ERROR = "N must be 2 or greater.\n";
 const string RANDOM_WORD_NUMBER_ERROR = "Must be at least 4 words.\n\n";
 const string FILE_ERROR = "Unable to open that file.  Try again.\n";
+const string PROMPT_MODEL_FILE = "Save the compiled model as (Enter to skip)? ";
+const string MODEL_FILE_ERROR = "The name of a compiled model must end with .ngram.\n";
+const string MODEL_LOADED = "Loaded a compiled model, N is ";
+const string PROMPT_BACKOFF = "Back off to shorter windows of the start words (y/n)? ";
+const string PROMPT_START = "Start the text with (Enter for a random window)? ";
+const int BUILD_THREADS = 0; //threads counting the n-grams, 0 for one per processor, 1 for a single pass
 
 //function declerations
 void promptFile(string &file);
 void promptN(int &N);
 void promptRandomWordNumber(int &randomWordNumber);
-Vector<string> getWords(string &file);
-Map<Vector<string>, Vector<string>> getNGramMap(Vector<string> &words, int &N);
-void printVector(Vector<string> &vec);
-void printRandomText(Map<Vector<string>, Vector<string>> &NGramMap, int &randomWordNumber, int &N);
+void getNGramIndex(string &file, NGramIndex &index);
+void getNGramMap(string &file, const NGramIndex &index, int &N, NGramModel &model, int threadCount);
+string promptModelFile();
+void saveCompiledModel(const string &modelFile, NGramModel &model);
+void generateTexts(TextGenerator &generator, int N);
+void generateIndexTexts(IndexGenerator &generator, const NGramIndex &index, int N);
+void printRandomText(TextGenerator &generator, int &randomWordNumber, int &N);
+void printStartedText(IndexGenerator &generator, const NGramIndex &index, const string &line,
+                      int &randomWordNumber, int &N);
+uint64_t randomSeed();
 
 //main function
 int main() {
     cout << INTRO; //displaying the intro welcome message
     string file;
-    promptFile(file);
-    Vector<string> words = getWords(file); //storing the words in the file
-    int N; //asking for N
-    promptN(N);
-    Map<Vector<string>, Vector<string>> NGramMap = getNGramMap(words, N); //storing the map
-    cout << endl;
-    int randomWordNumber;
+    MappedModel compiled; //a compiled model, used as it is mapped
+    NGramIndex index(MAX_N);
     do {
-        promptRandomWordNumber(randomWordNumber);
-        if (randomWordNumber != 0) {
-            printRandomText(NGramMap, randomWordNumber, N);
-            cout << endl;
+        promptFile(file);
+        try {
+            if (isModelFile(file)) { //loading the compiled model instead of reading a text
+                compiled.open(file);
+            } else {
+                getNGramIndex(file, index); //indexing the text once, for every N
+            }
+        } catch (const char* message) {
+            cout << message << endl;
         }
-    } while (randomWordNumber != 0);
+    } while (!compiled.isOpen() && index.getTokenCount() == 0);
+    if (compiled.isOpen()) {
+        cout << MODEL_LOADED << compiled.getTables().N << "." << endl;
+        NGramGenerator generator(compiled.getTables(), randomSeed());
+        generateTexts(generator, compiled.getTables().N);
+    } else {
+        int N; //asking for N until 0 is entered
+        promptN(N);
+        while (N != 0) {
+            try {
+                string modelFile = promptModelFile();
+                if (N <= MAX_N) { //generating from the index, a model is only built to be saved
+                    if (!modelFile.empty()) {
+                        NGramModel model(N);
+                        getNGramMap(file, index, N, model, BUILD_THREADS);
+                        saveCompiledModel(modelFile, model);
+                    }
+                    IndexGenerator generator(index, N, getYesOrNo(PROMPT_BACKOFF), randomSeed());
+                    generateIndexTexts(generator, index, N);
+                } else {
+                    NGramModel model(N);
+                    getNGramMap(file, index, N, model, BUILD_THREADS); //storing the model of N
+                    if (!modelFile.empty()) { //building a compiled model for the next runs
+                        saveCompiledModel(modelFile, model);
+                    }
+                    NGramGenerator generator(model.getTables(), randomSeed());
+                    generateTexts(generator, N);
+                }
+            } catch (const char* message) {
+                cout << message << endl;
+            }
+            promptN(N);
+        }
+    }
     cout << "Exiting." << endl;
     return 0;
 }
@@ -80,16 +139,16 @@ void promptFile(string &file) {
 }
 
 /**
- * @brief promptN Asks for a valid N. Prints error messages if neccessary.
+ * @brief promptN Asks for a valid N, 2 or greater, or 0. Prints error messages if neccessary.
  * @param N A reference to the integer N.
  */
 void promptN(int &N) {
     do { //asking for a valid value for N
         N = getInteger(PROMPT_N);
-        if (N < 2) {
+        if (N != 0 && N < 2) {
             cout << N_ERROR;
         }
-    } while (N < 2);
+    } while (N != 0 && N < 2);
 }
 
 /**
@@ -108,90 +167,172 @@ void promptRandomWordNumber(int &randomWordNumber) {
 }
 
 /**
- * @brief getWords Returns the words in a file as a Vector, reading one word at a time
- * @param file The file to read.
- * @return The collection (Vector) containing the words in the file.
+ * @brief getNGramIndex Fills the index, which holds every position of the text sorted by the
+ * words that start there, so the text of any N up to MAX_N is generated from it without reading
+ * the text again. The file is mapped and read in a single pass (see ngramindex.h). Throws an
+ * error if the file cannot be read or has no words.
+ * @param file The file containing all the words needed to generate the index.
+ * @param index The index containing all the words and the positions needed to generate random
+ * text.
  */
-Vector<string> getWords(string &file) {
-    ifstream input;
-    openFile(input, file);
-    Vector<string> words;
-    string word;
-    while (input >> word) {
-        words.add(word);
+void getNGramIndex(string &file, NGramIndex &index) {
+    index.build(file);
+    if (index.getTokenCount() == 0) {
+        throw("The text has no words.");
     }
-    return words;
 }
 
 /**
- * @brief getNGramMap Returns a Map, where each element is placed according to
- * its weighted probability (A Markov chain)
- * @param words The Vector containing all the words needed to generate the Map.
- * @param N is the number indicating the length of the Vectors in the
- * keys Vector of the Map.
- * @return The Map that is containing all the words and the probability information
- * (frequencies) needed to generate random text.
+ * @brief getNGramMap Fills the model, where each word is placed according to
+ * its weighted probability (A Markov chain). Up to MAX_N the model is built
+ * from the index, which already holds the words of the text. A larger N is
+ * read from the file in a single pass (see ngrambuilder.h): every word is
+ * interned as it is read and added to the window of the previous N - 1 words,
+ * the text is never stored as a whole. With several threads the text is split
+ * into parts counted in parallel and merged into the same model.
+ * @param file The file containing all the words needed to generate the model.
+ * @param index The index of the text of the file.
+ * @param N is the number indicating the length of the windows (N - 1 words)
+ * of the model plus their successor.
+ * @param model The model containing all the words and the probability information
+ * (frequencies) needed to generate random text, finalized once every window is added.
+ * @param threadCount The number of threads, 0 for one per processor.
  */
-Map<Vector<string>, Vector<string>> getNGramMap(Vector<string> &words, int &N) {
-    Map<Vector<string>, Vector<string>> NGramMap;
-    Vector<string> window;
-    Vector<string> values;
-    for (int i = 0; i < words.size(); i++) {
-        for (int j = i; j < i + N - 1; j++) {
-            if (j >= words.size()) { //the case for wrapping
-                window.add(words.get(j % words.size()));
-            }
-            else {
-                window.add(words.get(j));
-            }
-        }
-        if (NGramMap.containsKey(window)) {
-            values = NGramMap.get(window);
-        }
-        else {
-            values.clear();
+void getNGramMap(string &file, const NGramIndex &index, int &N, NGramModel &model, int threadCount) {
+    if (model.getN() != N) {
+        throw("The model does not have the same N.");
+    }
+    if (N <= index.getMaxOrder()) {
+        index.buildModel(model); //also finalizes the model, building the alias tables
+    } else {
+        buildNGramModel(file, model, threadCount);
+    }
+}
+
+/**
+ * @brief promptModelFile Asks for the name of a compiled model to save the model of N in.
+ * Prints error messages if neccessary.
+ * @return The name, empty to skip saving.
+ */
+string promptModelFile() {
+    string modelFile;
+    do {
+        modelFile = getLine(PROMPT_MODEL_FILE);
+        if (!modelFile.empty() && !isModelFile(modelFile)) {
+            cout << MODEL_FILE_ERROR;
         }
-        if (i + N - 1 >= words.size()) {
-            values.add(words.get((i + N - 1) % words.size())); //the case for wrapping
-            NGramMap.put(window, values);
+    } while (!modelFile.empty() && !isModelFile(modelFile));
+    return modelFile;
+}
+
+/**
+ * @brief saveCompiledModel Saves a model as a compiled model. Prints error messages if
+ * neccessary.
+ * @param modelFile The name of the compiled model.
+ * @param model The finalized model.
+ */
+void saveCompiledModel(const string &modelFile, NGramModel &model) {
+    try {
+        saveModel(modelFile, model);
+    } catch (const char* message) {
+        cout << message << endl;
+    }
+}
+
+/**
+ * @brief generateTexts Asks for numbers of random words and prints random texts of that many
+ * words until 0 is entered.
+ * @param generator The generator of the model, built or loaded.
+ * @param N The number of words of an n-gram.
+ */
+void generateTexts(TextGenerator &generator, int N) {
+    cout << endl;
+    int randomWordNumber;
+    do {
+        promptRandomWordNumber(randomWordNumber);
+        if (randomWordNumber != 0) {
+            printRandomText(generator, randomWordNumber, N);
+            cout << endl;
         }
-        else {
-            values.add(words.get(i + N - 1));
-            NGramMap.put(window, values);
+    } while (randomWordNumber != 0);
+}
+
+/**
+ * @brief generateIndexTexts Asks for numbers of random words and the words to start with, and
+ * prints random texts of that many words until 0 is entered.
+ * @param generator The generator of the index.
+ * @param index The index of the text, whose words the start words are looked up in.
+ * @param N The number of words of an n-gram.
+ */
+void generateIndexTexts(IndexGenerator &generator, const NGramIndex &index, int N) {
+    cout << endl;
+    int randomWordNumber;
+    do {
+        promptRandomWordNumber(randomWordNumber);
+        if (randomWordNumber != 0) {
+            printStartedText(generator, index, getLine(PROMPT_START), randomWordNumber, N);
+            cout << endl;
         }
-        window.clear();
-    }
-    return NGramMap;
+    } while (randomWordNumber != 0);
 }
 
 /**
- * @brief printVector Prints a Vector as desired.
- * @param vec The Vector to print.
+ * @brief printRandomText Prints a random text using the words according to their frequencies.
+ * The generator (see ngramgenerator.h) starts at a random state, every distinct window being as
+ * likely, and follows the next state stored for every successor, so no window is looked up
+ * while printing.
+ * @param generator The generator of the model, built or loaded.
+ * @param randomWordNumber Number of random words to be generated.
+ * @param N The number of words of an n-gram.
  */
-void printVector(Vector<string> &vec) {
-    for (string word: vec) {
-        cout << word << " ";
-    }
+void printRandomText(TextGenerator &generator, int &randomWordNumber, int &N) {
+    generator.restart();
+    cout << "... ";
+    generator.writeWindow(cout);
+    generator.write(cout, randomWordNumber - (N - 1)); //N - 1 words are the window
+    cout << "..." << endl;
 }
 
 /**
- * @brief printRandomText Prints a random text using the Map containg the words according to
- * their frequencies.
- * @param NGramMap A reference to the Map, which contains words and information.
+ * @brief printStartedText Prints a random text going on from the words of the user, which count
+ * as words of the text. Their last N - 1 words are the first window, backed off to its last
+ * words that occur in the text if the generator backs off, replaced by a random window otherwise.
+ * Without any start word, the text starts at a random window.
+ * @param generator The generator of the index.
+ * @param index The index of the text, whose words the start words are looked up in.
+ * @param line The start words, separated as the words of the text are.
  * @param randomWordNumber Number of random words to be generated.
- * @param N The number determining the similarity between the actual text and the random text.
+ * @param N The number of words of an n-gram.
  */
-void printRandomText(Map<Vector<string>, Vector<string>> &NGramMap, int &randomWordNumber, int &N) {
-    Vector<string> vec = NGramMap.keys().get(randomInteger(0, NGramMap.keys().size() - 1));
+void printStartedText(IndexGenerator &generator, const NGramIndex &index, const string &line,
+                      int &randomWordNumber, int &N) {
+    vector<int> start; //the word IDs of the start words, -1 for a word that is not in the text
+    vector<string> startWords;
+    const char* position = line.data();
+    const char* word;
+    size_t length;
+    while (nextWord(position, line.data() + line.size(), word, length)) {
+        start.push_back(index.getWords().find(word, length));
+        startWords.push_back(string(word, length));
+    }
+    if (start.empty()) {
+        printRandomText(generator, randomWordNumber, N);
+        return;
+    }
+    generator.startWith(start);
     cout << "... ";
-    printVector(vec);
-    string value;
-    for (int i = N - 1; i < randomWordNumber; i++) {
-        value = NGramMap.get(vec).get(randomInteger(0, NGramMap.get(vec).size() - 1));
-        cout << value << " ";
-        vec.remove(0);
-        vec.add(value);
+    for (const string &startWord : startWords) { //unknown words have no ID to write
+        cout << startWord << ' ';
     }
+    generator.write(cout, max(randomWordNumber - (int) start.size(), 0));
     cout << "..." << endl;
 }
 
+/**
+ * @brief randomSeed Returns a seed for a generator, drawn from the random library, so
+ * setRandomSeed still repeats the text.
+ * @return 64 random bits.
+ */
+uint64_t randomSeed() {
+    return ((uint64_t) randomInteger(0, INT_MAX) << 32) ^ (uint64_t) randomInteger(0, INT_MAX);
+}
@@ -0,0 +1,174 @@
+/**
+ * @brief The following code involves the methods neccessary to intern words. The characters of
+ * all the words are kept in a single array and the IDs are found through an open addressing
+ * table with linear probing, which stores the IDs only: the hash of every word is kept next to
+ * its characters, so a probe compares hashes before it compares any characters.
+ * SectionLeader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#include "wordtable.h"
+#include <cstring>
+
+//constant decleration(s)
+const int FIRST_WORD_SLOTS = 1024; //a power of 2
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/**
+ * @brief WordTable::WordTable The constructor of the WordTable class.
+ */
+WordTable::WordTable() {
+    starts.push_back(0);
+    slots.assign(FIRST_WORD_SLOTS, -1);
+}
+
+/**
+ * @brief WordTable::intern Returns the ID of a word, adding the word with the next ID if it is
+ * not in the table yet.
+ * @param word The characters of the word.
+ * @param length The number of characters.
+ * @return The ID of the word.
+ */
+int WordTable::intern(const char* word, size_t length) {
+    uint64_t hash = hashWord(word, length);
+    int slot = findSlot(word, length, hash);
+    if (slots[slot] >= 0) {
+        return slots[slot];
+    }
+    int id = size();
+    characters.insert(characters.end(), word, word + length);
+    starts.push_back(characters.size());
+    hashes.push_back(hash);
+    slots[slot] = id;
+    if ((size_t) size() * 2 > slots.size()) { //at most half of the slots are used
+        grow();
+    }
+    return id;
+}
+
+/**
+ * @brief WordTable::intern Returns the ID of a word, adding the word with the next ID if it is
+ * not in the table yet.
+ * @param word The word.
+ * @return The ID of the word.
+ */
+int WordTable::intern(const string &word) {
+    return intern(word.data(), word.size());
+}
+
+/**
+ * @brief WordTable::find Returns the ID of a word without adding it.
+ * @param word The characters of the word.
+ * @param length The number of characters.
+ * @return The ID of the word, -1 if it is not in the table.
+ */
+int WordTable::find(const char* word, size_t length) const {
+    return slots[findSlot(word, length, hashWord(word, length))];
+}
+
+/**
+ * @brief WordTable::size Returns the number of distinct words.
+ * @return The number of words, which is also the next ID.
+ */
+int WordTable::size() const {
+    return (int) hashes.size();
+}
+
+/**
+ * @brief WordTable::getWord Returns the word of an ID.
+ * @param id The ID.
+ * @return A copy of the word.
+ */
+string WordTable::getWord(int id) const {
+    return string(wordData(id), wordLength(id));
+}
+
+/**
+ * @brief WordTable::wordData Returns the characters of a word, which are not followed by a null
+ * character.
+ * @param id The ID of the word.
+ * @return The first character.
+ */
+const char* WordTable::wordData(int id) const {
+    return characters.data() + starts[id];
+}
+
+/**
+ * @brief WordTable::wordLength Returns the number of characters of a word.
+ * @param id The ID of the word.
+ * @return The number of characters.
+ */
+size_t WordTable::wordLength(int id) const {
+    return starts[id + 1] - starts[id];
+}
+
+/**
+ * @brief WordTable::getCharacters Returns the characters of every word, one after the other.
+ * @return The first character of the first word.
+ */
+const char* WordTable::getCharacters() const {
+    return characters.data();
+}
+
+/**
+ * @brief WordTable::getStarts Returns where every word starts in getCharacters(), followed by
+ * the number of characters, so word i is [starts[i], starts[i + 1]).
+ * @return The size() + 1 starts.
+ */
+const uint64_t* WordTable::getStarts() const {
+    return starts.data();
+}
+
+/**
+ * @brief WordTable::hashWord Hashes the characters of a word with FNV-1a, followed by a final
+ * mix so that the low bits, which pick the slot, depend on every character.
+ * @param word The characters of the word.
+ * @param length The number of characters.
+ * @return The hash.
+ */
+uint64_t WordTable::hashWord(const char* word, size_t length) {
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char) word[i]) * FNV_PRIME;
+    }
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/**
+ * @brief WordTable::grow Doubles the number of slots and puts every ID back, using the hashes
+ * kept for the words.
+ */
+void WordTable::grow() {
+    slots.assign(slots.size() * 2, -1);
+    size_t mask = slots.size() - 1;
+    for (int id = 0; id < size(); id++) {
+        size_t slot = hashes[id] & mask;
+        while (slots[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+}
+
+/**
+ * @brief WordTable::findSlot Finds the slot of a word, or the empty slot it would be put in.
+ * @param word The characters of the word.
+ * @param length The number of characters.
+ * @param hash The hash of the word.
+ * @return The index of the slot.
+ */
+int WordTable::findSlot(const char* word, size_t length, uint64_t hash) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    while (slots[slot] >= 0) {
+        int id = slots[slot];
+        if (hashes[id] == hash && wordLength(id) == length && memcmp(wordData(id), word, length) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return (int) slot;
+}
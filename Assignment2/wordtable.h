@@ -0,0 +1,42 @@
+/**
+ * @brief The header file defining public/private methods and properties used by the WordTable
+ * class, which interns the words of a text: every distinct word is stored once and given a dense
+ * integer ID (0, 1, 2, ... in the order the words are first seen), so the rest of the program
+ * can work with integers instead of strings.
+ * Section Leader: Ryan Kurohara
+ * @author EFE ACER
+ * @version 1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+class WordTable {
+public:
+    WordTable(); //constructor, no words
+    int intern(const char* word, size_t length); //returns the ID of the word, adding it if it is new
+    int intern(const string &word);
+    int find(const char* word, size_t length) const; //returns the ID of the word, -1 if it is not there
+    int size() const; //returns the number of distinct words
+    string getWord(int id) const; //returns the word of an ID
+    const char* wordData(int id) const; //the characters of a word, not terminated
+    size_t wordLength(int id) const; //the number of characters of a word
+    const char* getCharacters() const; //the characters of every word, one after the other
+    const uint64_t* getStarts() const; //the first character of every word, then the number of characters
+
+    static uint64_t hashWord(const char* word, size_t length); //64 bit hash of the characters
+
+private:
+    void grow(); //doubles the number of slots
+    int findSlot(const char* word, size_t length, uint64_t hash) const;
+
+    vector<char> characters; //the characters of every word, one after the other
+    vector<uint64_t> starts; //the first character of every word, then the number of characters
+    vector<uint64_t> hashes; //the hash of every word, so the slots can grow without rehashing
+    vector<int> slots; //open addressing, the ID of a word or -1, a power of 2 long
+};